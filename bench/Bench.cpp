@@ -0,0 +1,126 @@
+#include "Bench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE ""
+#endif
+
+namespace bench {
+
+std::vector<Registration>& registry() {
+    static std::vector<Registration> benchmarks;
+    return benchmarks;
+}
+
+} // namespace bench
+
+namespace {
+
+struct Options {
+    std::string filter;
+    int samples = 7;
+    double minSampleMs = 20.0;
+    bool list = false;
+};
+
+double runOnce(bench::BenchFunction function, std::uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    function(iterations);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Doubles the count until one sample takes at least minSampleMs
+std::uint64_t calibrate(bench::BenchFunction function, double minSampleMs) {
+    // Warm-up: first calls build static fixtures and fault in memory
+    runOnce(function, 1);
+    std::uint64_t iterations = 1;
+    while (true) {
+        double ns = runOnce(function, iterations);
+        if (ns >= minSampleMs * 1e6 || iterations >= (1ULL << 40)) {
+            return iterations;
+        }
+        // Jump close to the target once the timing is meaningful
+        if (ns > 1e5) {
+            return std::max<std::uint64_t>(iterations + 1, static_cast<std::uint64_t>(iterations * (minSampleMs * 1e6 / ns) * 1.1));
+        }
+        iterations *= 2;
+    }
+}
+
+int usage() {
+    std::fprintf(stderr, "Usage: chinese_chess_bench [--filter TEXT] [--samples N] [--min-time-ms MS] [--list]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--list") == 0) {
+            options.list = true;
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--filter") == 0) {
+            options.filter = argv[++i];
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--samples") == 0) {
+            options.samples = std::max(1, std::atoi(argv[++i]));
+        } else if (i + 1 < argc && std::strcmp(argv[i], "--min-time-ms") == 0) {
+            options.minSampleMs = std::max(1.0, std::atof(argv[++i]));
+        } else {
+            return usage();
+        }
+    }
+
+    std::vector<bench::Registration> benchmarks = bench::registry();
+    std::sort(benchmarks.begin(), benchmarks.end(),
+              [](const bench::Registration& a, const bench::Registration& b) { return a.name < b.name; });
+
+    if (options.list) {
+        for (const bench::Registration& benchmark : benchmarks) {
+            std::printf("%s\n", benchmark.name.c_str());
+        }
+        return 0;
+    }
+
+#if defined(__GNUC__) && !defined(__OPTIMIZE__)
+    std::fprintf(stderr, "warning: benchmarks built without optimization; configure with -DCMAKE_BUILD_TYPE=Release\n");
+#endif
+    std::printf("{\n  \"context\": {\"compiler\": \"%s\", \"build_type\": \"%s\", \"assertions\": %s, \"samples\": %d},\n"
+                "  \"benchmarks\": [",
+#if defined(__VERSION__)
+                __VERSION__,
+#else
+                "unknown",
+#endif
+                BENCH_BUILD_TYPE,
+#ifdef NDEBUG
+                "false",
+#else
+                "true",
+#endif
+                options.samples);
+
+    bool first = true;
+    for (const bench::Registration& benchmark : benchmarks) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        std::uint64_t iterations = calibrate(benchmark.function, options.minSampleMs);
+        std::vector<double> perIteration;
+        for (int sample = 0; sample < options.samples; ++sample) {
+            perIteration.push_back(runOnce(benchmark.function, iterations) / static_cast<double>(iterations));
+        }
+        std::sort(perIteration.begin(), perIteration.end());
+
+        std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"ns_min\": %.3f, \"ns_max\": %.3f}",
+                    first ? "" : ",", benchmark.name.c_str(), static_cast<unsigned long long>(iterations),
+                    perIteration[perIteration.size() / 2], perIteration.front(), perIteration.back());
+        std::fflush(stdout);
+        first = false;
+    }
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal in-tree micro-benchmark harness (no external dependency, builds
+// offline). A benchmark is a function running its body 'iterations' times;
+// the runner calibrates the count, takes several samples and reports the
+// median cost per iteration as JSON so runs can be diffed between commits.
+namespace bench {
+
+using BenchFunction = void (*)(std::uint64_t iterations);
+
+struct Registration {
+    std::string name;
+    BenchFunction function;
+};
+
+std::vector<Registration>& registry();
+
+struct Registrar {
+    Registrar(const char* name, BenchFunction function) { registry().push_back({name, function}); }
+};
+
+// Keeps the optimizer from discarding a computed value
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace bench
+
+#define BENCHMARK(name)                                                  \
+    static void name(std::uint64_t iterations);                          \
+    static const bench::Registrar name##Registrar(#name, name);          \
+    static void name(std::uint64_t iterations)
@@ -0,0 +1,368 @@
+#include "Bench.h"
+#include "engine/Evaluator.h"
+#include "engine/MoveGenerator.h"
+#include "game/Cannon.h"
+#include "game/Elephant.h"
+#include "game/Fen.h"
+#include "game/Game.h"
+#include "game/GameDelta.h"
+#include "game/HibernatedGame.h"
+#include "game/Horse.h"
+#include "game/PieceFactory.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using MovePairs = std::vector<std::pair<Position, Position>>;
+
+// Fixed positions: the opening, a busy middlegame and a sparse endgame
+constexpr std::string_view MIDDLEGAME = "r1bakab1r/9/1cn4c1/p1p1p1p1p/4n4/2P6/P3P1P1P/1CN1C1N2/9/R1BAKAB1R w - - 0 1";
+constexpr std::string_view ENDGAME = "3k5/4a4/4b4/9/2p6/9/6P2/4B4/4A4/3AK1R2 w - - 0 1";
+
+const Game& loaded(std::string_view fen) {
+    static Game games[3];
+    static const bool ready = Fen::parse(Fen::START_POSITION, games[0]) && Fen::parse(MIDDLEGAME, games[1]) &&
+                              Fen::parse(ENDGAME, games[2]);
+    (void)ready;
+    return fen == MIDDLEGAME ? games[1] : (fen == ENDGAME ? games[2] : games[0]);
+}
+
+// Game reserves history for this many plies; see shuffleRooks()
+constexpr std::uint64_t SHUFFLE_RESTART_PLIES = 256;
+
+// Rooks shuffle a1-a2 / a10-a9 and back: a four-ply cycle that stays legal
+// forever. Every ply is recorded in the history (and every 16th copies a
+// checkpoint), so 'fen' is reloaded each SHUFFLE_RESTART_PLIES plies to time
+// the moves rather than the history growing without bound.
+MoveResult shuffleRooks(Game& game, std::string_view fen, std::uint64_t ply) {
+    static const Position cycle[4][2] = {
+        {Position(1, 1), Position(2, 1)}, {Position(10, 1), Position(9, 1)},
+        {Position(2, 1), Position(1, 1)}, {Position(9, 1), Position(10, 1)},
+    };
+    if (ply % SHUFFLE_RESTART_PLIES == 0) {
+        Fen::parse(fen, game);
+    }
+    const Position* move = cycle[ply & 3];
+    return game.makeMove(move[0], move[1]);
+}
+
+// Every square holding 'type' paired with all 90 destinations
+MovePairs pairsFrom(const Game& game, PieceType type) {
+    MovePairs pairs;
+    for (int from = 0; from < BOARD_SQUARES; ++from) {
+        Piece* piece = game.getBoard().getPiece(squarePosition(from));
+        if (piece && piece->getType() == type) {
+            for (int to = 0; to < BOARD_SQUARES; ++to) {
+                pairs.emplace_back(squarePosition(from), squarePosition(to));
+            }
+        }
+    }
+    return pairs;
+}
+
+// Same, keeping only moves the piece's own geometry allows (so the board check runs)
+MovePairs geometricPairsFrom(const Game& game, PieceType type) {
+    MovePairs pairs;
+    for (const auto& [from, to] : pairsFrom(game, type)) {
+        if (game.getBoard().getPiece(from)->isValidMove(from, to)) {
+            pairs.emplace_back(from, to);
+        }
+    }
+    return pairs;
+}
+
+void benchIsValidMove(PieceType type, std::uint64_t iterations) {
+    const Game& game = loaded(Fen::START_POSITION);
+    static MovePairs pairs[7];
+    MovePairs& list = pairs[static_cast<int>(type)];
+    if (list.empty()) {
+        list = pairsFrom(game, type);
+    }
+    std::unique_ptr<Piece> piece = PieceFactory::create(type, Color::RED);
+    std::size_t index = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(piece->isValidMove(list[index].first, list[index].second));
+        index = index + 1 == list.size() ? 0 : index + 1;
+    }
+}
+
+template <typename PieceClass>
+void benchIsValidMoveWithBoard(PieceType type, std::uint64_t iterations) {
+    const Game& game = loaded(MIDDLEGAME);
+    static const MovePairs list = geometricPairsFrom(game, type);
+    std::size_t index = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        const auto* piece = static_cast<const PieceClass*>(game.getBoard().getPiece(list[index].first));
+        bench::doNotOptimize(piece->isValidMoveWithBoard(list[index].first, list[index].second, game.getBoard()));
+        index = index + 1 == list.size() ? 0 : index + 1;
+    }
+}
+
+} // namespace
+
+BENCHMARK(BoardGetPieceFullScan) {
+    const Board& board = loaded(MIDDLEGAME).getBoard();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        int count = 0;
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            count += board.getPiece(squarePosition(square)) != nullptr;
+        }
+        bench::doNotOptimize(count);
+    }
+}
+
+BENCHMARK(BoardIsPathClear) {
+    const Board& board = loaded(MIDDLEGAME).getBoard();
+    static MovePairs lines;
+    if (lines.empty()) {
+        for (int from = 0; from < BOARD_SQUARES; ++from) {
+            for (int to = 0; to < BOARD_SQUARES; ++to) {
+                Position a = squarePosition(from), b = squarePosition(to);
+                if (from != to && (a.row == b.row || a.col == b.col)) {
+                    lines.emplace_back(a, b);
+                }
+            }
+        }
+    }
+    std::size_t index = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(board.isPathClear(lines[index].first, lines[index].second));
+        index = index + 1 == lines.size() ? 0 : index + 1;
+    }
+}
+
+BENCHMARK(GeneralIsValidMove) { benchIsValidMove(PieceType::GENERAL, iterations); }
+BENCHMARK(GuardIsValidMove) { benchIsValidMove(PieceType::GUARD, iterations); }
+BENCHMARK(RookIsValidMove) { benchIsValidMove(PieceType::ROOK, iterations); }
+BENCHMARK(HorseIsValidMove) { benchIsValidMove(PieceType::HORSE, iterations); }
+BENCHMARK(CannonIsValidMove) { benchIsValidMove(PieceType::CANNON, iterations); }
+BENCHMARK(ElephantIsValidMove) { benchIsValidMove(PieceType::ELEPHANT, iterations); }
+BENCHMARK(SoldierIsValidMove) { benchIsValidMove(PieceType::SOLDIER, iterations); }
+
+BENCHMARK(HorseIsValidMoveWithBoard) { benchIsValidMoveWithBoard<Horse>(PieceType::HORSE, iterations); }
+BENCHMARK(CannonIsValidMoveWithBoard) { benchIsValidMoveWithBoard<Cannon>(PieceType::CANNON, iterations); }
+BENCHMARK(ElephantIsValidMoveWithBoard) { benchIsValidMoveWithBoard<Elephant>(PieceType::ELEPHANT, iterations); }
+
+BENCHMARK(GameIsMoveLegal) {
+    const Game& game = loaded(MIDDLEGAME);
+    static MovePairs candidates;
+    if (candidates.empty()) {
+        // Every from-square of the side to move against every destination: mostly rejections
+        for (int from = 0; from < BOARD_SQUARES; ++from) {
+            Piece* piece = game.getBoard().getPiece(squarePosition(from));
+            if (piece && piece->getColor() == game.getCurrentPlayer()) {
+                for (int to = 0; to < BOARD_SQUARES; ++to) {
+                    candidates.emplace_back(squarePosition(from), squarePosition(to));
+                }
+            }
+        }
+    }
+    std::size_t index = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(game.isMoveLegal(candidates[index].first, candidates[index].second));
+        index = index + 1 == candidates.size() ? 0 : index + 1;
+    }
+}
+
+// A hover hint for each square in turn: 90 probes per query...
+BENCHMARK(GameHoverHintByProbing) {
+    const Game& game = loaded(MIDDLEGAME);
+    int square = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        Position from = squarePosition(square);
+        int count = 0;
+        for (int to = 0; to < BOARD_SQUARES; ++to) {
+            count += game.isMoveLegal(from, squarePosition(to));
+        }
+        bench::doNotOptimize(count);
+        square = square + 1 == BOARD_SQUARES ? 0 : square + 1;
+    }
+}
+
+// ...and the same queries answered from the legal-move cache
+BENCHMARK(GameHoverHintCached) {
+    const Game& game = loaded(MIDDLEGAME);
+    int square = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(game.legalDestinations(squarePosition(square)).count());
+        square = square + 1 == BOARD_SQUARES ? 0 : square + 1;
+    }
+}
+
+// Cost of the first query after a move: the cache is rebuilt every time
+BENCHMARK(GameLegalMoveCacheRebuild) {
+    Game game;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        shuffleRooks(game, MIDDLEGAME, i);
+        bench::doNotOptimize(game.allLegalMoves().size());
+    }
+}
+
+BENCHMARK(GameMakeMove) {
+    Game game;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(shuffleRooks(game, Fen::START_POSITION, i).isLegal);
+    }
+}
+
+BENCHMARK(GameWouldGeneralsFaceEachOther) {
+    const Game& game = loaded(ENDGAME);
+    static const Position moves[][2] = {
+        {Position(1, 5), Position(1, 4)}, {Position(1, 5), Position(2, 5)}, {Position(1, 5), Position(1, 6)},
+    };
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        const Position* move = moves[i % 3];
+        bench::doNotOptimize(game.wouldGeneralsFaceEachOther(move[0], move[1]));
+    }
+}
+
+// Waking an idle session 40 plies in: replay into a reused Game
+BENCHMARK(GameResumeFromHibernation) {
+    static HibernatedGame saved;
+    if (saved.historyLength() == 0) {
+        Game game;
+        Fen::parse(Fen::START_POSITION, game);
+        for (int ply = 0; ply < 40; ++ply) {
+            MoveSpan moves = game.allLegalMoves();
+            Move move = moves.begin()[(ply * 7) % moves.size()];
+            game.makeMove(move.fromPosition(), move.toPosition());
+        }
+        game.hibernate(saved);
+    }
+    Game game;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(game.resume(saved));
+    }
+}
+
+namespace {
+
+constexpr int SPECTATORS = 256;
+
+// One move broadcast to SPECTATORS local decoders per iteration, either as the
+// encoder's stream (deltas, a keyframe every 32 plies) or as a full keyframe
+// every move. Rooks shuffle as in GameMakeMove; each reload is one keyframe.
+void benchFanOut(std::uint64_t iterations, bool keyframesOnly) {
+    Game game;
+    Fen::parse(MIDDLEGAME, game);
+    GameDeltaEncoder encoder;
+    std::string frame;
+    encoder.update(game, frame);
+    static GameDeltaDecoder spectators[SPECTATORS];
+    for (GameDeltaDecoder& spectator : spectators) {
+        std::size_t consumed = 0;
+        spectator.read(frame, consumed);
+    }
+    std::uint64_t bytes = 0;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        shuffleRooks(game, MIDDLEGAME, i);
+        frame.clear();
+        if (keyframesOnly) {
+            GameDeltaEncoder::writeKeyframe(game, frame);
+        } else {
+            encoder.update(game, frame);
+        }
+        for (GameDeltaDecoder& spectator : spectators) {
+            std::size_t consumed = 0;
+            spectator.read(frame, consumed);
+            bytes += consumed;
+        }
+    }
+    bench::doNotOptimize(bytes);
+}
+
+} // namespace
+
+BENCHMARK(SpectatorFanOutDeltas256) { benchFanOut(iterations, false); }
+BENCHMARK(SpectatorFanOutKeyframes256) { benchFanOut(iterations, true); }
+
+BENCHMARK(FenSetupStartPosition) {
+    Game game;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(Fen::parse(Fen::START_POSITION, game));
+    }
+}
+
+BENCHMARK(GameResetAndPlacePieces) {
+    const PieceCodes codes = loaded(Fen::START_POSITION).getBoard().toCodes();
+    Game game;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        game.reset();
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            if (codes[square] != EMPTY_CODE) {
+                game.getBoard().setPiece(squarePosition(square),
+                                         PieceFactory::create(pieceCodeType(codes[square]), pieceCodeColor(codes[square])));
+            }
+        }
+        bench::doNotOptimize(game.getBoard().getPiece(Position(1, 5)));
+    }
+}
+
+namespace {
+
+// 64 boards taken along a fixed random walk from the middlegame
+const std::vector<BoardState>& evalStates() {
+    static std::vector<BoardState> states;
+    if (states.empty()) {
+        BoardState state = BoardState::fromGame(loaded(MIDDLEGAME));
+        std::uint64_t random = 0x9E3779B97F4A7C15ULL;
+        while (states.size() < EvalBatch::MAX_LANES) {
+            Move moves[MoveGenerator::MAX_MOVES];
+            int count = MoveGenerator::generateLegal(state, moves);
+            if (count == 0) {
+                state = BoardState::fromGame(loaded(MIDDLEGAME));
+                continue;
+            }
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            state.makeMove(moves[(random >> 33) % static_cast<std::uint64_t>(count)]);
+            states.push_back(state);
+        }
+    }
+    return states;
+}
+
+const EvalBatch& evalBatch() {
+    static EvalBatch batch;
+    if (batch.size == 0) {
+        for (const BoardState& state : evalStates()) {
+            batch.add(state);
+        }
+    }
+    return batch;
+}
+
+} // namespace
+
+BENCHMARK(EvaluateOneByOne64) {
+    const std::vector<BoardState>& states = evalStates();
+    Evaluator evaluator;
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        int sum = 0;
+        for (const BoardState& state : states) {
+            sum += evaluator.evaluate(state);
+        }
+        bench::doNotOptimize(sum);
+    }
+}
+
+BENCHMARK(EvaluateBatchScalar64) {
+    const EvalBatch& batch = evalBatch();
+    Evaluator evaluator;
+    int scores[EvalBatch::MAX_LANES];
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        evaluator.evaluateBatchScalar(batch, scores);
+        bench::doNotOptimize(scores[0]);
+    }
+}
+
+BENCHMARK(EvaluateBatch64) {
+    const EvalBatch& batch = evalBatch();
+    Evaluator evaluator;
+    int scores[EvalBatch::MAX_LANES];
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+        evaluator.evaluateBatch(batch, scores);
+        bench::doNotOptimize(scores[0]);
+    }
+}
@@ -0,0 +1,28 @@
+Feature: Allocation-free hot paths
+  As an engine developer
+  I want the test run to fail when a hot path touches the heap
+  So that allocator latency never creeps back into move making or search
+
+  @Allocation
+  Scenario: Making moves in a game does not allocate
+    Given the initial position
+    When Red's cannon captures a horse, Black recaptures and an illegal move is tried
+    Then no heap allocation happened
+
+  @Allocation
+  Scenario: Move generation and make/unmake do not allocate
+    Given the initial position
+    When perft 3 runs with legal, pseudo-legal and capture generation at every node
+    Then no heap allocation happened
+
+  @Allocation
+  Scenario: A search does not allocate once it has run
+    Given a search that has already run once
+    When it searches 4 plies from the initial position with an info callback
+    Then no heap allocation happened
+
+  @Allocation
+  Scenario: The guard reports allocations
+    Given allocation tracking is linked in
+    When operator new is called inside a guard
+    Then the violation is reported with the guard's scope
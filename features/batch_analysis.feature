@@ -0,0 +1,36 @@
+Feature: Batch analysis with a persistent cache
+  As the nightly analysis job
+  I want games analysed on a thread pool with results cached on disk
+  So that re-runs and shared openings are not searched again from scratch
+
+  @Analysis
+  Scenario: Every position before a game move is analysed
+    Given two games that share their first two moves
+    When the games are analysed to depth 3 on 2 threads
+    Then each game reports one position per move with the played move and a legal best move
+
+  @Analysis
+  Scenario: A second run is answered from the cache file
+    Given two games that share their first two moves
+    And the games were analysed to depth 3 with the cache file
+    When the cache file is reopened and the games are analysed again
+    Then every position comes from the cache with the same best move and score
+
+  @Analysis
+  Scenario: Overlapping games in one run reuse each other's results
+    Given two games that share their first two moves
+    When the games are analysed to depth 3 on 1 thread
+    Then the three opening positions of the second game come from the cache
+
+  @Analysis
+  Scenario: A shallower cached result is searched again and replaced
+    Given a cache holding a depth 1 result for the initial position
+    When the initial position is analysed to depth 3
+    Then it is searched rather than read from the cache
+    And the cache now holds a depth 3 result
+
+  @Analysis
+  Scenario: A torn last record is dropped when the cache is reopened
+    Given a cache file with two results and half of a third
+    When the cache file is reopened and one more result is stored
+    Then reopening it again gives all three complete results
@@ -0,0 +1,35 @@
+Feature: Batched position evaluation
+  As the MCTS search and the bulk analysis tools
+  I want to score many positions with one call
+  So that leaf evaluation uses the CPU's vector units instead of one board at a time
+
+  @BatchEval
+  Scenario: A full batch scores every position like the single-position evaluator
+    Given 64 positions from random games
+    When the positions are evaluated as one batch
+    Then every score equals the single-position evaluation
+
+  @BatchEval
+  Scenario: The scalar fallback agrees with the vector kernel
+    Given 64 positions from random games
+    When the positions are evaluated with the scalar fallback and with the default kernel
+    Then both give the same scores
+
+  @BatchEval
+  Scenario: A partial batch only writes its own lanes
+    Given 13 positions from random games
+    When the positions are evaluated as one batch
+    Then every score equals the single-position evaluation
+    And the scores past the last position are untouched
+
+  @BatchEval
+  Scenario: Scores are from the side to move in each lane
+    Given a position where Red is a rook up, with Red to move and with Black to move in one batch
+    When the positions are evaluated as one batch
+    Then the Red lane is positive and the Black lane is its negative
+
+  @BatchEval
+  Scenario: A full batch rejects further positions
+    Given 64 positions from random games
+    When one more position is added
+    Then the batch refuses it and keeps 64 positions
@@ -0,0 +1,34 @@
+Feature: Evaluation tuning
+  As the engine developer
+  I want the evaluation weights fitted to game results
+  So that piece values and square bonuses are not tuned by hand
+
+  @Tuning
+  Scenario: The stored features reproduce the evaluator's score
+    Given positions reached by random moves from the initial position
+    When they are added to a tuning set
+    Then each position's dot product with the default weights equals the Red evaluation
+
+  @Tuning
+  Scenario: Training records are labelled from Red's side
+    Given a training file with a Black win recorded from each side's point of view
+    When the file is loaded into a tuning set
+    Then both positions have a target of 0 for Red
+
+  @Tuning
+  Scenario: The loss does not depend on the thread count
+    Given a tuning set of random positions with results
+    When the loss is computed on 1 and on 4 threads
+    Then the two losses are equal
+
+  @Tuning
+  Scenario: Tuning recovers an undervalued rook
+    Given positions labelled by an evaluation where a rook is worth 600
+    When tuning starts from a rook value of 200
+    Then the loss drops and the tuned rook value rises towards 600
+
+  @Tuning
+  Scenario: Weights survive the text format
+    Given the default weights with a changed horse value
+    When they are written as text and parsed back
+    Then the parsed weights are identical
@@ -0,0 +1,30 @@
+Feature: FEN position setup
+  As a tool author
+  I want to load and save positions in standard Xiangqi FEN
+  So that puzzle and analysis datasets can be replayed without manual setup
+
+  @FEN
+  Scenario: Loading the initial position places every piece
+    Given the position "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1"
+    Then there is a Red General at (1, 5)
+    And there is a Black Cannon at (8, 2)
+    And it is Red to move
+
+  @FEN
+  Scenario: Writing a loaded position reproduces the same FEN
+    Given the position "4k4/9/9/9/9/9/9/9/4A4/3AK4 b - - 0 1"
+    When the position is written as FEN
+    Then the FEN is "4k4/9/9/9/9/9/9/9/4A4/3AK4 b - - 0 1"
+
+  @FEN
+  Scenario: A malformed FEN is rejected and the board is unchanged
+    Given the position "4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1"
+    When the position "4k4/9/9/9/9/9/9/9/9/4K5 w" is loaded
+    Then the FEN is rejected
+    And there is a Red General at (1, 5)
+
+  @FEN
+  Scenario: Moves are validated against a loaded position
+    Given the position "4k4/9/9/9/9/9/9/2R6/2N6/4K4 w - - 0 1"
+    When Red moves the Horse from (2, 3) to (4, 4)
+    Then the move is illegal
@@ -0,0 +1,47 @@
+Feature: Game database with position index
+  As the opening explorer
+  I want to look up every game that reached a position
+  So that explorer queries answer in microseconds instead of seconds
+
+  Background:
+    Given a game database built from:
+      | Format | Moves                 | Result  |
+      | ICCS   | h2e2 h9g7 h0g2 i9h9   | 1-0     |
+      | WXF    | C2.5 H8+7 H2+3 R9.8   | 0-1     |
+      | ICCS   | h0g2 h9g7             | 1/2-1/2 |
+
+  @GameDatabase
+  Scenario: The initial position is reached by every game
+    When the initial position is queried
+    Then 3 games are found with 1 Red win, 1 Black win and 1 draw
+
+  @GameDatabase
+  Scenario: A position after the first move narrows the games
+    When the position after "h2e2" is queried
+    Then games 0 and 1 are found at ply 1
+
+  @GameDatabase
+  Scenario: A stored game replays through the rules engine
+    When game 2 is replayed
+    Then the Red Horse stands at (3, 7)
+
+  @GameDatabase
+  Scenario: A game torn by an interrupted append is dropped before the next append
+    Given the games file ends in a partly written game
+    When another game is appended and the index is rebuilt
+    Then the database holds 4 games
+    And the appended game is game 3
+
+  @GameDatabase
+  Scenario: A games file shorter than its header is refused
+    Given a games file holding only 5 bytes
+    Then the games file cannot be opened for appending
+
+  @GameDatabase
+  Scenario: Moves off the board or from an empty square are refused
+    When a game whose move starts off the board is appended
+    Then the writer refuses it
+    When a game whose move starts on an empty square is appended
+    Then the writer refuses it
+    When such a game is written to the games file directly
+    Then the index cannot be built
@@ -0,0 +1,37 @@
+Feature: Hibernating idle games
+  As the game server
+  I want idle games folded into a small blob and restored on the next move
+  So that thousands of sessions waiting on people cost little memory
+
+  @Game
+  Scenario: A resumed game continues exactly where it stopped
+    Given a game 20 plies in
+    When it is hibernated, destroyed and resumed into a fresh Game
+    Then the board, side to move, ply and history are the same
+    And the next move is accepted as before
+
+  @Game
+  Scenario: Taken-back moves can still be redone after resuming
+    Given a game 20 plies in with 5 moves taken back
+    When it is hibernated and resumed
+    Then it is at ply 15 and redo replays the original moves
+
+  @Game
+  Scenario: A hibernated game is two orders of magnitude smaller
+    Given a game 40 plies in
+    When it is hibernated
+    Then it holds 48 bytes plus 4 per ply
+    And a live Game with its heap blocks is over 100 times the fixed part
+
+  @Game
+  Scenario: The stored form round-trips and damaged data is rejected
+    Given a game 20 plies in, hibernated and serialised
+    When the bytes are read back
+    Then resuming gives the same position
+    And a truncated blob or one holding an illegal move is refused
+
+  @Game
+  Scenario: A finished game resumes as finished
+    Given a game that ended by capturing a General
+    When it is hibernated and resumed
+    Then the game is over with the same winner
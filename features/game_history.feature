@@ -0,0 +1,35 @@
+Feature: Game history
+  As a player reviewing a game
+  I want to take moves back and jump to any ply
+  So that the replay slider responds instantly even in long games
+
+  @History
+  Scenario: Taking back a capture restores the captured piece
+    Given the initial position
+    When Red's cannon captures the horse on h10
+    And the move is taken back
+    Then the horse is back on h10, Red is to move and the capture can be redone
+
+  @History
+  Scenario: Taking back a General capture reopens the game
+    Given a position where Red's rook can capture the Black General
+    When the rook captures the General and the move is taken back
+    Then the game is no longer over and Red is to move
+
+  @History
+  Scenario: Seek jumps to any earlier or later ply
+    Given a 40-ply game played from the initial position
+    When the game seeks to plies in a scrambled order
+    Then every ply shows the same position as when it was played
+
+  @History
+  Scenario: A new move after a takeback replaces the rest of the line
+    Given a 3-ply game played from the initial position
+    When two moves are taken back and a different move is played
+    Then the history has two plies and nothing can be redone
+
+  @History
+  Scenario: Seeking back to a game that ended on a checkpoint ply keeps it over
+    Given a game whose General is captured on ply 16
+    When the game seeks to ply 0 and back to ply 16
+    Then the game is over with Red the winner and no further move is accepted
@@ -0,0 +1,43 @@
+Feature: Game record files
+  As an archive maintainer
+  I want to stream PGN-style game files with ICCS or WXF move text
+  So that millions of games can be replayed through the rules engine
+
+  Background:
+    Given a game file with the games:
+      """
+      [Event "Club match"]
+      [Format "ICCS"]
+      [Result "1-0"]
+
+      1. h2e2 h9g7 2. h0g2 i9h9 3. i0h0 b9c7 1-0
+
+      [Event "Club match"]
+      [Format "WXF"]
+      [Result "0-1"]
+
+      1. C2.5 H8+7 2. H2+3 R9.8 3. R1.2 H2+3 0-1
+      """
+
+  @GameRecords
+  Scenario: Every game and its headers are read
+    When the file is read
+    Then 2 games are found
+    And the first game's result is a Red win
+
+  @GameRecords
+  Scenario: ICCS and WXF move text replay to the same position
+    When both games are replayed
+    Then both games end in the same position
+
+  @GameRecords
+  Scenario: An illegal move stops the replay
+    Given a game with move text "1. h2e2 h9g7 2. h2h9"
+    When the game is replayed
+    Then the replay fails at "h2h9"
+
+  @GameRecords
+  Scenario: Parallel chunked reading finds every game
+    Given a game file with 40 games
+    When the file is read on 4 threads
+    Then 40 games are replayed
@@ -0,0 +1,36 @@
+Feature: Legal move hints
+  As the game client
+  I want the legal destinations of a piece without probing every square
+  So that hover and tap hints stay cheap
+
+  @Game
+  Scenario: Cached moves are exactly the moves the referee accepts
+    Given the initial position, a middlegame and an endgame
+    When all legal moves and the moves from every square are queried
+    Then they match probing every from and to square with isMoveLegal
+
+  @Game
+  Scenario: The cache follows moves, takebacks and seeks
+    Given the initial position
+    When the red cannon moves to the centre
+    Then the hints are for Black's pieces
+    And after a takeback the hints match the initial position again
+    And after seeking forward they match the position after the move
+
+  @Game
+  Scenario: Editing the board directly refreshes the hints
+    Given the initial position with its hints queried
+    When a black rook is placed on the open file in front of the red rook
+    Then the red rook can now capture it
+
+  @Game
+  Scenario: Queries after the first one are lookups that do not allocate
+    Given the middlegame position
+    When every square is queried twice
+    Then the cache is built once and nothing is allocated
+
+  @Game
+  Scenario: There are no hints for the wrong side, empty squares or a finished game
+    Given the initial position
+    Then a black piece, an empty square and an off-board square have no hints
+    And once a General is captured there are no legal moves at all
@@ -0,0 +1,44 @@
+Feature: Proof-number mate solver
+  As the puzzle service
+  I want to prove or refute forced mates quickly
+  So that user-submitted problems are verified in milliseconds, even long checking sequences
+
+  @MateSolver
+  Scenario: The solver proves a mate in one
+    Given the position "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1"
+    When the mate solver runs
+    Then the mate is proven with the main line "a4d4"
+
+  @MateSolver
+  Scenario: The solver proves a long checking sequence and returns its main line
+    Given the position "9/3ka4/5a3/2R6/9/9/9/1H1C5/3K5/9 w - - 0 1"
+    When the mate solver runs
+    Then the mate is proven with a main line of at least 9 plies
+    And every attacker move in the main line gives check
+    And the defender has no legal move at the end of the main line
+
+  @MateSolver
+  Scenario: A position without a checking move is disproven
+    Given the position "3k5/9/9/9/9/9/P8/9/9/4K4 w - - 0 1"
+    When the mate solver runs
+    Then the mate is disproven
+
+  @MateSolver
+  Scenario: Quiet moves are searched when checks-only is turned off
+    Given the position "4k4/9/9/9/9/9/9/9/9/R2K1R3 w - - 0 1"
+    When the mate solver runs with checks only and a limit of 9 plies
+    Then the result is unknown
+    When the mate solver runs with quiet moves and a limit of 9 plies
+    Then the mate is proven with the main line "a0a8"
+
+  @MateSolver
+  Scenario: A node limit leaves the result unknown
+    Given the position "9/3ka4/5a3/2R6/9/9/9/1H1C5/3K5/9 w - - 0 1"
+    When the mate solver runs with a limit of 20 nodes
+    Then the result is unknown with no main line
+
+  @MateSolver
+  Scenario: A refutation that rests on perpetual check is not reported as disproven
+    Given the position "3k5/9/9/9/9/9/9/9/9/4K1R2 w - - 0 1"
+    When the mate solver runs
+    Then the result is unknown with no main line
@@ -0,0 +1,35 @@
+Feature: Monte Carlo Tree Search
+  As a casual bot tier
+  I want a stochastic search that grows with threads instead of depth
+  So that its play feels human and scales smoothly with hardware
+
+  @Mcts
+  Scenario: MCTS finds a mate in one
+    Given the position "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1"
+    When MCTS runs 3000 playouts
+    Then the best move leaves Black without a legal move and has a mate score
+
+  @Mcts
+  Scenario: MCTS takes undefended material
+    Given the position "3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1"
+    When MCTS runs 3000 playouts
+    Then the best move is "i4e4"
+
+  @Mcts
+  Scenario: Four threads share one tree within the playout limit
+    Given the initial position
+    When MCTS runs 4000 playouts on 4 threads with batches of 8
+    Then between 4000 and 4000 plus one batch per thread playouts were made
+    And the best move is legal and the tree has grown past the root
+
+  @Mcts
+  Scenario: A temperature makes the move choice vary
+    Given the initial position
+    When MCTS chooses a move 20 times with temperature 3
+    Then at least two different legal moves were chosen
+
+  @Mcts
+  Scenario: The UCCI engine searches with MCTS when asked
+    Given the UCCI engine with searchmode set to mcts and 2 threads
+    When the server sends "go nodes 2000"
+    Then the engine answers with a legal bestmove
@@ -0,0 +1,37 @@
+Feature: Multi-PV analysis
+  As the game review product
+  I want the best few moves with their scores and lines from one search
+  So that showing alternatives does not cost a separate search per move
+
+  @MultiPv
+  Scenario: Three lines with different first moves, best first
+    Given the initial position
+    When the engine searches to depth 4 with 3 lines
+    Then 3 lines are returned with different legal first moves
+    And the scores do not increase from one line to the next
+    And the best move and score are those of the first line
+
+  @MultiPv
+  Scenario: The first line finds the same winning move as a single-line search
+    Given the position "3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1"
+    When the engine searches to depth 4 with 3 lines
+    Then the first line starts with "i4e4"
+    And the other lines score lower
+
+  @MultiPv
+  Scenario: No more lines than legal moves
+    Given the position "3k5/9/9/9/9/9/9/9/9/4K4 w - - 0 1"
+    When the engine searches to depth 2 with 8 lines
+    Then one line is returned per legal move
+
+  @MultiPv
+  Scenario: Every line of every iteration is reported
+    Given the initial position
+    When the engine searches to depth 3 with 2 lines
+    Then search info arrives for lines 1 and 2 at each of depths 1 to 3
+
+  @MultiPv
+  Scenario: The UCCI engine reports multipv lines
+    Given the UCCI engine with multipv set to 3
+    When the server sends "go depth 2"
+    Then each depth has info lines for multipv 1, 2 and 3
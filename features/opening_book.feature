@@ -0,0 +1,28 @@
+Feature: Opening book
+  As an engine
+  I want to answer opening positions from a shared, memory-mapped book
+  So that the first plies cost no search time
+
+  Background:
+    Given a book built from:
+      | Moves          | Result  |
+      | h2e2 h9g7      | 1-0     |
+      | h2e2 b9c7      | 1-0     |
+      | h2e2 h9g7      | 1/2-1/2 |
+      | b2e2 h9g7      | 0-1     |
+
+  @OpeningBook
+  Scenario: Probing the initial position lists the book moves with statistics
+    When the initial position is probed
+    Then the book offers "h2e2" from 3 games with 2 wins and 1 draw
+    And the book offers "b2e2" from 1 game with no wins
+
+  @OpeningBook
+  Scenario: Weighted picks follow the recorded results
+    When many moves are picked for the initial position
+    Then "h2e2" is always picked because "b2e2" never scored
+
+  @OpeningBook
+  Scenario: Positions outside the book return no move
+    When a position after "a0a1" is probed
+    Then the book returns no move
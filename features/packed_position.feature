@@ -0,0 +1,21 @@
+Feature: Packed binary positions
+  As a storage and networking layer
+  I want a fixed 32-byte position record with a stable hash
+  So that position caches and training sets stay small and portable
+
+  @PackedPosition
+  Scenario: A position survives an encode/decode round trip
+    Given the position "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1"
+    When the position is packed and unpacked into a new game
+    Then the new game has the same FEN
+
+  @PackedPosition
+  Scenario: The position hash is stable across builds
+    Given the position "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1"
+    Then the packed hash is 0x17d3a3b2258dac9a
+
+  @PackedPosition
+  Scenario: Side to move is part of the encoding
+    Given the position "4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1"
+    And the same position with Black to move
+    Then the packed records and hashes differ
@@ -0,0 +1,28 @@
+Feature: Engine search
+  As an engine
+  I want to generate legal moves and search them quickly
+  So that positions are played and analysed without a human
+
+  @Search
+  Scenario: Move generation matches the known perft counts
+    Given the initial position
+    Then perft 1 to 3 counts 44, 1920 and 79666 positions
+
+  @Search
+  Scenario: The search finds a mate in one
+    Given the position "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1"
+    When the engine searches 3 plies
+    Then the best move is "a4d4" with a mate score
+
+  @Search
+  Scenario: The search takes undefended material
+    Given the position "3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1"
+    When the engine searches at most 20000 nodes
+    Then the best move is "i4e4"
+    And no more than 20000 nodes were searched
+
+  @Search
+  Scenario: A mated side has no move
+    Given the position "3k5/9/9/9/9/3R5/9/9/9/4K4 b - - 0 1"
+    When the engine searches 3 plies
+    Then no move is returned and the score is mated
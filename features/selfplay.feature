@@ -0,0 +1,28 @@
+Feature: Self-play matches
+  As an engine developer
+  I want to play engine-vs-engine matches with sequential testing
+  So that every change is checked for strength regressions without external tools
+
+  @SelfPlay
+  Scenario: A clear run of wins accepts the improvement
+    Given an SPRT between 0 and 5 Elo
+    When the test engine scores 600 wins, 800 draws and 400 losses
+    Then the SPRT accepts H1
+
+  @SelfPlay
+  Scenario: A run of losses rejects the improvement
+    Given an SPRT between 0 and 5 Elo
+    When the test engine scores 400 wins, 800 draws and 600 losses
+    Then the SPRT accepts H0
+
+  @SelfPlay
+  Scenario: A mate ends the game with a win for the mating side
+    Given the opening "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1"
+    When one game is played at depth 3
+    Then Red wins after 1 ply because Black has no legal moves
+
+  @SelfPlay
+  Scenario: A match plays every opening with both colours
+    Given two openings and 4 games on 2 threads at depth 1
+    When the match is run
+    Then 4 games are reported, each opening twice with colours reversed
@@ -0,0 +1,29 @@
+Feature: Live game snapshots
+  As a server running analysis next to live games
+  I want immutable snapshots of a game's position
+  So that spectators, hints and audits read it without blocking the player
+
+  @Snapshots
+  Scenario: A snapshot does not change when the live game advances
+    Given a live game at the initial position
+    When a snapshot is taken and Red then plays a cannon move
+    Then the old snapshot still shows the initial position
+    And the new snapshot shows the move and matches the live board
+
+  @Snapshots
+  Scenario: Snapshots share the game history
+    Given a live game at the initial position
+    When three moves are played
+    Then the latest snapshot lists the three earlier position keys, oldest first
+
+  @Snapshots
+  Scenario: An illegal move publishes nothing
+    Given a live game at the initial position
+    When Red tries a blocked rook move
+    Then the same snapshot is still published
+
+  @Snapshots
+  Scenario: Analysis threads read snapshots while the game advances
+    Given a live game at the initial position
+    When four threads search snapshots while 30 moves are played
+    Then every snapshot they read was internally consistent
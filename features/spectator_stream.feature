@@ -0,0 +1,37 @@
+Feature: Spectator update stream
+  As the broadcast service
+  I want each move sent as a few bytes with an occasional full position
+  So that tens of thousands of watchers do not saturate our bandwidth
+
+  @Spectator
+  Scenario: Spectators follow a game from deltas and keyframes
+    Given a game streamed with a keyframe every 8 plies
+    When 30 plies are played and every frame is decoded
+    Then the spectator's position, side to move, ply and key match the game after every move
+    And the stream holds 4 keyframes and 27 seven-byte deltas
+
+  @Spectator
+  Scenario: A takeback or a new line is sent as a keyframe
+    Given a streamed game 10 plies in
+    When the last move is taken back and another one played
+    Then the takeback is sent as a keyframe and the new move as a delta
+    And the spectator follows both
+
+  @Spectator
+  Scenario: A damaged delta is detected and the next keyframe resynchronises
+    Given a stream of 12 plies with a keyframe every 8 plies
+    When one byte of the third delta's key is flipped
+    Then that delta is rejected as corrupt and the rest wait for a keyframe
+    And after the keyframe at ply 8 the spectator matches the game again
+
+  @Spectator
+  Scenario: A spectator joining mid-game starts from a keyframe
+    Given a streamed game 15 plies in
+    When a new spectator reads a keyframe written for it and then the live deltas
+    Then it matches the game after every move
+
+  @Spectator
+  Scenario: The capture of a General ends the game for spectators
+    Given a streamed position where Red can capture the black General
+    When the capture is played
+    Then the delta marks the game as over with Red the winner
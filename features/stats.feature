@@ -0,0 +1,44 @@
+Feature: Instrumentation counters
+  As an engine developer
+  I want counters for search and move validation that I can read at any time
+  So that tuning is driven by measurements rather than guesses
+
+  @Stats
+  Scenario Outline: Rejected moves report why they were rejected
+    Given the initial position
+    When Red tries to move from <from> to <to>
+    Then the move is rejected because of "<reason>"
+
+    Examples:
+      | from  | to    | reason        |
+      | (5,5) | (6,5) | no piece      |
+      | (10,1)| (9,1) | wrong color   |
+      | (1,1) | (2,2) | geometry      |
+      | (1,1) | (1,2) | own piece     |
+      | (1,1) | (5,1) | blocked path  |
+      | (3,2) | (8,2) | cannon screen |
+      | (1,2) | (2,4) | horse leg     |
+
+  @Stats
+  Scenario: makeMove calls are counted by rejection reason
+    Given the initial position
+    When two moves with a blocked path and one legal move are made
+    Then the stats count 3 makeMove calls and 2 blocked paths when stats are compiled in
+
+  @Stats
+  Scenario: A snapshot is taken while the search keeps running
+    Given an infinite search on another thread
+    When two snapshots are taken a few milliseconds apart
+    Then the node count grows between them when stats are compiled in
+
+  @Stats
+  Scenario: Beta cutoffs are broken down by move index
+    When a 5-ply search runs from the initial position
+    Then the cutoffs by move index add up to all beta cutoffs
+    And most cutoffs come from the first move tried
+
+  @Stats
+  Scenario: Per-node phases are sampled and still add up within the search time
+    When a 5-ply search runs from the initial position
+    Then evaluation and move generation time are reported from one call in 64
+    And together they stay within the search time
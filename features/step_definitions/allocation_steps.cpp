@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include "diagnostics/AllocTracker.h"
+#include "diagnostics/Stats.h"
+#include "engine/MoveGenerator.h"
+#include "engine/Search.h"
+#include "game/Fen.h"
+
+namespace {
+
+const char* reportedScope = nullptr;
+std::uint64_t reportedAllocations = 0;
+
+void recordViolation(const char* scope, std::uint64_t allocations) {
+    reportedScope = scope;
+    reportedAllocations = allocations;
+}
+
+} // namespace
+
+// Each scenario's guard reports through the handler installed in test/main.cpp,
+// so an allocation fails the test; the explicit checks make the failure local.
+class AllocationSteps : public ::testing::Test {
+protected:
+    Game game;
+    BoardState state;
+
+    void SetUp() override {
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        state = BoardState::fromGame(game);
+        // A thread's first counter registers its stats block, which allocates once
+        if (Stats::ENABLED) {
+            Stats::local();
+        }
+    }
+
+    std::uint64_t perft(int depth) {
+        Move moves[MoveGenerator::MAX_MOVES];
+        Move other[MoveGenerator::MAX_MOVES];
+        MoveGenerator::generatePseudoLegal(state, other);
+        MoveGenerator::generateCaptures(state, other);
+        int count = MoveGenerator::generateLegal(state, moves);
+        if (depth == 1) {
+            return static_cast<std::uint64_t>(count);
+        }
+        std::uint64_t total = 0;
+        for (int i = 0; i < count; ++i) {
+            PieceCode captured = state.makeMove(moves[i]);
+            total += perft(depth - 1);
+            state.unmakeMove(moves[i], captured);
+        }
+        return total;
+    }
+};
+
+// Scenario: Making moves in a game does not allocate
+TEST_F(AllocationSteps, MakingMovesInGameDoesNotAllocate) {
+    NoAllocGuard guard("Game::makeMove");
+    EXPECT_TRUE(game.makeMove(Position(3, 8), Position(10, 8)).isLegal);
+    EXPECT_TRUE(game.makeMove(Position(10, 9), Position(10, 8)).isLegal);
+    EXPECT_FALSE(game.makeMove(Position(1, 1), Position(5, 1)).isLegal);
+    EXPECT_EQ(guard.allocations(), 0u);
+}
+
+// Scenario: Move generation and make/unmake do not allocate
+TEST_F(AllocationSteps, MoveGenerationAndMakeUnmakeDoNotAllocate) {
+    NoAllocGuard guard("move generation and make/unmake");
+    EXPECT_EQ(perft(3), 79666u);
+    state.makeNullMove();
+    state.unmakeNullMove();
+    EXPECT_EQ(guard.allocations(), 0u);
+}
+
+// Scenario: A search does not allocate once it has run
+TEST_F(AllocationSteps, SearchDoesNotAllocateOnceItHasRun) {
+    Search search(1);
+    std::vector<std::uint64_t> history;
+    SearchLimits limits;
+    limits.depth = 2;
+    search.run(state, history, limits);
+
+    int infoCalls = 0;
+    Search::InfoCallback onInfo = [&infoCalls](const SearchInfo&) { ++infoCalls; };
+    limits.depth = 4;
+    SearchResult result;
+    {
+        NoAllocGuard guard("Search::run");
+        result = search.run(state, history, limits, onInfo);
+        EXPECT_EQ(guard.allocations(), 0u);
+    }
+    EXPECT_EQ(result.depth, 4);
+    EXPECT_EQ(infoCalls, 4);
+}
+
+// Scenario: The guard reports allocations
+TEST_F(AllocationSteps, GuardReportsAllocations) {
+    if (!AllocTracker::isActive()) {
+        GTEST_SKIP() << "built with CHINESE_CHESS_ALLOC_TRACKING=OFF";
+    }
+    reportedScope = nullptr;
+    AllocTracker::ViolationHandler previous = AllocTracker::setViolationHandler(recordViolation);
+    {
+        NoAllocGuard guard("explicit allocation");
+        // A direct call, which unlike a new-expression may not be elided
+        ::operator delete(::operator new(64));
+        EXPECT_EQ(guard.allocations(), 1u);
+    }
+    AllocTracker::setViolationHandler(previous);
+
+    ASSERT_NE(reportedScope, nullptr);
+    EXPECT_STREQ(reportedScope, "explicit allocation");
+    EXPECT_EQ(reportedAllocations, 1u);
+}
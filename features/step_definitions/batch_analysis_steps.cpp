@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "engine/Analyzer.h"
+#include "game/Fen.h"
+
+class BatchAnalysisSteps : public ::testing::Test {
+protected:
+    std::string path;
+    std::string games;
+    AnalysisSettings settings;
+    std::vector<AnalyzedItem> items;
+
+    void SetUp() override {
+        path = ::testing::TempDir() + "batch_analysis_steps.cache";
+        std::remove(path.c_str());
+        settings.depth = 3;
+        settings.hashMegabytes = 1;
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    void givenTwoGamesSharingAnOpening() {
+        games = "[Result \"1-0\"]\n1. h2e2 h9g7 2. h0g2 i9h9 1-0\n\n"
+                "[Result \"0-1\"]\n1. h2e2 h9g7 2. b0c2 b9c7 0-1\n";
+    }
+
+    AnalysisSummary whenGamesAreAnalysed(AnalysisCache* cache) {
+        items.clear();
+        BatchAnalyzer analyzer(settings, cache);
+        AnalysisSummary summary = analyzer.analyzeGames(games, [this](const AnalyzedItem& item) {
+            items.push_back(item);
+        });
+        std::sort(items.begin(), items.end(),
+                  [](const AnalyzedItem& a, const AnalyzedItem& b) { return a.index < b.index; });
+        return summary;
+    }
+
+    static BoardState startState() {
+        Game game;
+        EXPECT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        return BoardState::fromGame(game);
+    }
+};
+
+// Scenario: Every position before a game move is analysed
+TEST_F(BatchAnalysisSteps, EveryPositionBeforeAMoveIsAnalysed) {
+    givenTwoGamesSharingAnOpening();
+    settings.threads = 2;
+    AnalysisSummary summary = whenGamesAreAnalysed(nullptr);
+    EXPECT_EQ(summary.items, 2u);
+    EXPECT_EQ(summary.failed, 0u);
+    EXPECT_EQ(summary.positions, 8u);
+    ASSERT_EQ(items.size(), 2u);
+
+    for (const AnalyzedItem& item : items) {
+        ASSERT_TRUE(item.ok);
+        ASSERT_EQ(item.positions.size(), 4u);
+        BoardState state = startState();
+        for (int ply = 0; ply < 4; ++ply) {
+            const PositionAnalysis& position = item.positions[ply];
+            EXPECT_EQ(position.ply, ply);
+            EXPECT_EQ(position.key, state.key());
+            EXPECT_EQ(position.depth, 3);
+            BoardState copy = state;
+            EXPECT_TRUE(MoveGenerator::isLegal(copy, position.best));
+            ASSERT_TRUE(MoveGenerator::isLegal(copy, position.played));
+            state.makeMove(position.played);
+        }
+    }
+}
+
+// Scenario: A second run is answered from the cache file
+TEST_F(BatchAnalysisSteps, SecondRunIsAnsweredFromCacheFile) {
+    givenTwoGamesSharingAnOpening();
+    std::vector<AnalyzedItem> first;
+    {
+        AnalysisCache cache;
+        ASSERT_TRUE(cache.open(path));
+        whenGamesAreAnalysed(&cache);
+        first = items;
+    }
+
+    AnalysisCache cache;
+    ASSERT_TRUE(cache.open(path));
+    EXPECT_EQ(cache.size(), 5u); // 8 positions, the first 3 shared
+    AnalysisSummary summary = whenGamesAreAnalysed(&cache);
+    EXPECT_EQ(summary.cacheHits, 8u);
+    for (std::size_t game = 0; game < items.size(); ++game) {
+        for (std::size_t ply = 0; ply < items[game].positions.size(); ++ply) {
+            const PositionAnalysis& position = items[game].positions[ply];
+            EXPECT_TRUE(position.cached);
+            EXPECT_EQ(position.best, first[game].positions[ply].best);
+            EXPECT_EQ(position.score, first[game].positions[ply].score);
+        }
+    }
+}
+
+// Scenario: Overlapping games in one run reuse each other's results
+TEST_F(BatchAnalysisSteps, OverlappingGamesReuseResults) {
+    givenTwoGamesSharingAnOpening();
+    settings.threads = 1;
+    AnalysisCache cache;
+    AnalysisSummary summary = whenGamesAreAnalysed(&cache);
+    // The start position and the two shared moves lead to the same three positions
+    EXPECT_EQ(summary.cacheHits, 3u);
+    ASSERT_EQ(items.size(), 2u);
+    EXPECT_TRUE(items[1].positions[0].cached);
+    EXPECT_TRUE(items[1].positions[2].cached);
+    EXPECT_FALSE(items[1].positions[3].cached);
+}
+
+// Scenario: A shallower cached result is searched again and replaced
+TEST_F(BatchAnalysisSteps, ShallowerCachedResultIsReplaced) {
+    AnalysisCache cache;
+    BoardState start = startState();
+    Move moves[MoveGenerator::MAX_MOVES];
+    ASSERT_GT(MoveGenerator::generateLegal(start, moves), 0);
+    cache.store(start.key(), moves[0], 0, 1);
+
+    BatchAnalyzer analyzer(settings, &cache);
+    AnalysisSummary summary = analyzer.analyzePositions(Fen::START_POSITION, [this](const AnalyzedItem& item) {
+        items.push_back(item);
+    });
+    EXPECT_EQ(summary.cacheHits, 0u);
+    ASSERT_EQ(items.size(), 1u);
+    EXPECT_FALSE(items[0].positions[0].cached);
+
+    CachedAnalysis entry;
+    ASSERT_TRUE(cache.lookup(start.key(), 3, entry));
+    EXPECT_EQ(entry.depth, 3);
+    EXPECT_EQ(Move(entry.move), items[0].positions[0].best);
+}
+
+// Scenario: A torn last record is dropped when the cache is reopened
+TEST_F(BatchAnalysisSteps, TornLastRecordIsDropped) {
+    {
+        AnalysisCache cache;
+        ASSERT_TRUE(cache.open(path));
+        cache.store(1, Move(), 10, 4);
+        cache.store(2, Move(), 20, 4);
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        out.write("\x03\0\0\0\0\0\0\0", 8);
+    }
+    {
+        AnalysisCache cache;
+        ASSERT_TRUE(cache.open(path));
+        EXPECT_EQ(cache.size(), 2u);
+        cache.store(3, Move(), 30, 4);
+    }
+
+    AnalysisCache cache;
+    ASSERT_TRUE(cache.open(path));
+    EXPECT_EQ(cache.loaded(), 3u);
+    CachedAnalysis entry;
+    ASSERT_TRUE(cache.lookup(3, 4, entry));
+    EXPECT_EQ(entry.score, 30);
+    ASSERT_TRUE(cache.lookup(1, 4, entry));
+    EXPECT_EQ(entry.score, 10);
+}
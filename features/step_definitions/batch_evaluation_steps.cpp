@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "engine/Evaluator.h"
+#include "engine/MoveGenerator.h"
+#include "game/Fen.h"
+
+class BatchEvaluationSteps : public ::testing::Test {
+protected:
+    Evaluator evaluator;
+    std::vector<BoardState> positions;
+    EvalBatch batch;
+    int scores[EvalBatch::MAX_LANES];
+
+    void SetUp() override {
+        for (int& score : scores) {
+            score = UNTOUCHED;
+        }
+    }
+
+    static constexpr int UNTOUCHED = 0x7FFFFFFF;
+
+    static BoardState startPosition() {
+        Game game;
+        EXPECT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        return BoardState::fromGame(game);
+    }
+
+    // Random games from the opening, restarted when one ends
+    void givenRandomPositions(int count) {
+        BoardState state = startPosition();
+        std::uint64_t random = 12345;
+        while (static_cast<int>(positions.size()) < count) {
+            Move moves[MoveGenerator::MAX_MOVES];
+            int legal = MoveGenerator::generateLegal(state, moves);
+            if (legal == 0) {
+                state = startPosition();
+                continue;
+            }
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            state.makeMove(moves[(random >> 33) % static_cast<std::uint64_t>(legal)]);
+            positions.push_back(state);
+        }
+        for (const BoardState& position : positions) {
+            ASSERT_GE(batch.add(position), 0);
+        }
+    }
+
+    void thenScoresMatchSingleEvaluation() {
+        for (int lane = 0; lane < batch.size; ++lane) {
+            EXPECT_EQ(scores[lane], evaluator.evaluate(positions[lane])) << "lane " << lane;
+        }
+    }
+};
+
+// Scenario: A full batch scores every position like the single-position evaluator
+TEST_F(BatchEvaluationSteps, FullBatchMatchesSingleEvaluation) {
+    givenRandomPositions(EvalBatch::MAX_LANES);
+    evaluator.evaluateBatch(batch, scores);
+    thenScoresMatchSingleEvaluation();
+}
+
+// Scenario: The scalar fallback agrees with the vector kernel
+TEST_F(BatchEvaluationSteps, ScalarFallbackAgreesWithVectorKernel) {
+    givenRandomPositions(EvalBatch::MAX_LANES);
+    int scalar[EvalBatch::MAX_LANES];
+    evaluator.evaluateBatchScalar(batch, scalar);
+    evaluator.evaluateBatch(batch, scores);
+    for (int lane = 0; lane < batch.size; ++lane) {
+        EXPECT_EQ(scores[lane], scalar[lane]) << "lane " << lane;
+    }
+    if (!Evaluator::hasAvx2()) {
+        GTEST_LOG_(INFO) << "No AVX2 on this CPU: both runs used the scalar loop";
+    }
+}
+
+// Scenario: A partial batch only writes its own lanes
+TEST_F(BatchEvaluationSteps, PartialBatchWritesOnlyItsLanes) {
+    givenRandomPositions(13);
+    evaluator.evaluateBatch(batch, scores);
+    thenScoresMatchSingleEvaluation();
+    for (int lane = 13; lane < EvalBatch::MAX_LANES; ++lane) {
+        EXPECT_EQ(scores[lane], UNTOUCHED) << "lane " << lane;
+    }
+}
+
+// Scenario: Scores are from the side to move in each lane
+TEST_F(BatchEvaluationSteps, ScoresAreFromSideToMove) {
+    // Red's extra rook makes the position lopsided, so the sign matters
+    Game game;
+    ASSERT_TRUE(Fen::parse("3k5/9/9/9/9/9/9/9/9/R3K4 w - - 0 1", game));
+    BoardState red = BoardState::fromGame(game);
+    BoardState black = red;
+    black.makeNullMove();
+    batch.add(red);
+    batch.add(black);
+    evaluator.evaluateBatch(batch, scores);
+    EXPECT_GT(scores[0], 0);
+    EXPECT_EQ(scores[1], -scores[0]);
+    EXPECT_EQ(scores[0], evaluator.evaluate(red));
+}
+
+// Scenario: A full batch rejects further positions
+TEST_F(BatchEvaluationSteps, FullBatchRejectsMorePositions) {
+    givenRandomPositions(EvalBatch::MAX_LANES);
+    EXPECT_TRUE(batch.full());
+    EXPECT_EQ(batch.add(startPosition()), -1);
+    EXPECT_EQ(batch.size, EvalBatch::MAX_LANES);
+}
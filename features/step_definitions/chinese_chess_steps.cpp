@@ -393,7 +393,9 @@ TEST_F(ChineseChessSteps, RedCapturesOpponentGeneralWinsImmediately) {
     
     // Then the move is legal and the game should end with Red winning
     EXPECT_TRUE(lastMoveResult.isLegal) << "Move should be legal - capturing opponent's General";
-    // Note: In a full implementation, we would also check if the game ends and Red wins
+    EXPECT_TRUE(lastMoveResult.gameEnded) << "Game should end";
+    EXPECT_EQ(lastMoveResult.winner, Color::RED) << "Red should win";
+    EXPECT_TRUE(game.isGameOver());
 }
 
 // Twenty-second scenario: Red captures a non-General piece and the game continues (Legal)
@@ -406,5 +408,6 @@ TEST_F(ChineseChessSteps, RedCapturesNonGeneralPieceGameContinues) {
     
     // Then the move is legal and the game continues
     EXPECT_TRUE(lastMoveResult.isLegal) << "Move should be legal - capturing opponent's non-General piece";
-    // Note: In a full implementation, we would also check that the game continues
+    EXPECT_FALSE(lastMoveResult.gameEnded) << "Game should continue";
+    EXPECT_FALSE(game.isGameOver());
 }
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "engine/MoveGenerator.h"
+#include "engine/Tuner.h"
+#include "game/Fen.h"
+
+class EvalTuningSteps : public ::testing::Test {
+protected:
+    std::vector<BoardState> positions;
+    TuningSet set;
+
+    // Random games from the initial position, keeping every fourth position
+    // after the first few so that material is often uneven
+    void givenRandomPositions(int games) {
+        Game game;
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        const BoardState start = BoardState::fromGame(game);
+        std::uint64_t random = 0x2545F4914F6CDD1DULL;
+        for (int g = 0; g < games; ++g) {
+            BoardState state = start;
+            for (int ply = 0; ply < 80; ++ply) {
+                Move moves[MoveGenerator::MAX_MOVES];
+                int count = MoveGenerator::generateLegal(state, moves);
+                if (count == 0) {
+                    break;
+                }
+                random ^= random << 13;
+                random ^= random >> 7;
+                random ^= random << 17;
+                state.makeMove(moves[random % static_cast<std::uint64_t>(count)]);
+                if (ply >= 10 && ply % 4 == 0) {
+                    positions.push_back(state);
+                }
+            }
+        }
+    }
+
+    static int redScore(const Evaluator& evaluator, const BoardState& state) {
+        int score = evaluator.evaluate(state);
+        return state.sideToMove() == Color::RED ? score : -score;
+    }
+};
+
+// Scenario: The stored features reproduce the evaluator's score
+TEST_F(EvalTuningSteps, FeaturesReproduceEvaluatorScore) {
+    givenRandomPositions(20);
+    ASSERT_FALSE(positions.empty());
+    for (const BoardState& state : positions) {
+        set.add(state.squares(), 0.5);
+    }
+
+    Evaluator evaluator;
+    std::vector<double> parameters = TuningSet::parameters(evaluator.weights());
+    ASSERT_EQ(set.size(), positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        EXPECT_EQ(set.score(i, parameters.data()), redScore(evaluator, positions[i])) << "position " << i;
+    }
+}
+
+// Scenario: Training records are labelled from Red's side
+TEST_F(EvalTuningSteps, TrainingRecordsAreLabelledForRed) {
+    std::string path = ::testing::TempDir() + "eval_tuning_steps.bin";
+    {
+        TrainingDataWriter writer;
+        ASSERT_TRUE(writer.open(path, TrainingDataWriter::NONE));
+        TrainingDataWriter::Buffer buffer(writer);
+        Game game;
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        TrainingRecord redToMove{};
+        ASSERT_TRUE(PackedPosition::encode(game, redToMove.position));
+        redToMove.result = -1;
+        buffer.add(redToMove);
+        ASSERT_TRUE(game.makeMove(Position(3, 2), Position(3, 5)).isLegal);
+        TrainingRecord blackToMove{};
+        ASSERT_TRUE(PackedPosition::encode(game, blackToMove.position));
+        blackToMove.result = 1;
+        buffer.add(blackToMove);
+    }
+
+    EXPECT_TRUE(set.addFile(path));
+    std::remove(path.c_str());
+    ASSERT_EQ(set.size(), 2u);
+    EXPECT_EQ(set.target(0), 0.0f);
+    EXPECT_EQ(set.target(1), 0.0f);
+}
+
+// Scenario: The loss does not depend on the thread count
+TEST_F(EvalTuningSteps, LossDoesNotDependOnThreadCount) {
+    givenRandomPositions(30);
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        set.add(positions[i].squares(), static_cast<double>(i % 3) * 0.5);
+    }
+
+    TunerSettings settings;
+    settings.threads = 1;
+    double single = Tuner(settings, set).loss(EvalWeights::defaults(), 1.0);
+    settings.threads = 4;
+    double parallel = Tuner(settings, set).loss(EvalWeights::defaults(), 1.0);
+    EXPECT_GT(single, 0.0);
+    EXPECT_NEAR(single, parallel, 1e-12);
+}
+
+// Scenario: Tuning recovers an undervalued rook
+TEST_F(EvalTuningSteps, TuningRecoversUndervaluedRook) {
+    givenRandomPositions(60);
+    Evaluator truth;
+    for (const BoardState& state : positions) {
+        double score = redScore(truth, state);
+        set.add(state.squares(), 1.0 / (1.0 + std::pow(10.0, -score / 400.0)));
+    }
+
+    EvalWeights start = EvalWeights::defaults();
+    start.material[static_cast<int>(PieceType::ROOK)] = 200;
+    TunerSettings settings;
+    settings.threads = 2;
+    settings.iterations = 300;
+    settings.learningRate = 5.0;
+    settings.scale = 1.0;
+    TunerResult result = Tuner(settings, set).run(start);
+
+    EXPECT_LT(result.finalLoss, result.initialLoss / 4);
+    EXPECT_GT(result.weights.material[static_cast<int>(PieceType::ROOK)], 450);
+    EXPECT_EQ(result.weights.material[static_cast<int>(PieceType::GENERAL)], 0);
+}
+
+// Scenario: Weights survive the text format
+TEST_F(EvalTuningSteps, WeightsSurviveTextFormat) {
+    EvalWeights weights = EvalWeights::defaults();
+    weights.material[static_cast<int>(PieceType::HORSE)] = 301;
+    weights.squares[static_cast<int>(PieceType::SOLDIER)][40] = -7;
+    std::ostringstream text;
+    weights.write(text);
+
+    EvalWeights parsed;
+    ASSERT_TRUE(EvalWeights::parse(text.str(), parsed));
+    EXPECT_EQ(parsed.material, weights.material);
+    EXPECT_EQ(parsed.squares, weights.squares);
+    EXPECT_FALSE(EvalWeights::parse("material 1 2 3", parsed));
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "game/Game.h"
+#include "game/Fen.h"
+
+class FenSteps : public ::testing::Test {
+protected:
+    Game game;
+    MoveResult lastMoveResult;
+    char fenBuffer[Fen::MAX_LENGTH];
+
+    void SetUp() override {
+        game.reset();
+        lastMoveResult = MoveResult();
+        fenBuffer[0] = '\0';
+    }
+
+    void givenPosition(const std::string& fen) {
+        ASSERT_TRUE(Fen::parse(fen, game)) << "Failed to load " << fen;
+    }
+
+    void thenPieceIsAt(PieceType type, Color color, const Position& pos) {
+        Piece* piece = game.getBoard().getPiece(pos);
+        ASSERT_NE(piece, nullptr);
+        EXPECT_EQ(piece->getType(), type);
+        EXPECT_EQ(piece->getColor(), color);
+    }
+
+    std::string whenPositionIsWritten() {
+        std::size_t length = Fen::write(game, fenBuffer, sizeof(fenBuffer));
+        return std::string(fenBuffer, length);
+    }
+};
+
+// Scenario: Loading the initial position places every piece
+TEST_F(FenSteps, LoadingInitialPositionPlacesEveryPiece) {
+    givenPosition(std::string(Fen::START_POSITION));
+
+    thenPieceIsAt(PieceType::GENERAL, Color::RED, Position(1, 5));
+    thenPieceIsAt(PieceType::HORSE, Color::RED, Position(1, 2));
+    thenPieceIsAt(PieceType::CANNON, Color::BLACK, Position(8, 2));
+    thenPieceIsAt(PieceType::SOLDIER, Color::BLACK, Position(7, 9));
+    EXPECT_TRUE(game.getBoard().isEmpty(Position(5, 5)));
+    EXPECT_EQ(game.getCurrentPlayer(), Color::RED);
+}
+
+// Scenario: Writing a loaded position reproduces the same FEN
+TEST_F(FenSteps, WritingLoadedPositionReproducesSameFen) {
+    givenPosition("4k4/9/9/9/9/9/9/9/4A4/3AK4 b - - 0 1");
+
+    EXPECT_EQ(whenPositionIsWritten(), "4k4/9/9/9/9/9/9/9/4A4/3AK4 b - - 0 1");
+    EXPECT_EQ(game.getCurrentPlayer(), Color::BLACK);
+
+    givenPosition(std::string(Fen::START_POSITION));
+    EXPECT_EQ(whenPositionIsWritten(), Fen::START_POSITION);
+}
+
+// Scenario: A malformed FEN is rejected and the board is unchanged
+TEST_F(FenSteps, MalformedFenIsRejectedAndBoardUnchanged) {
+    givenPosition("4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1");
+
+    EXPECT_FALSE(Fen::parse("4k4/9/9/9/9/9/9/9/9/4K5 w", game)) << "Rank overflows nine files";
+    EXPECT_FALSE(Fen::parse("4k4/9/9/9/9/9/9/9/4K4 w", game)) << "Only nine ranks";
+    EXPECT_FALSE(Fen::parse("4k4/9/9/9/9/9/9/9/9/4X4 w", game)) << "Unknown piece letter";
+    EXPECT_FALSE(Fen::parse("4k4/9/9/9/9/9/9/9/9/4K4 x", game)) << "Unknown side to move";
+
+    thenPieceIsAt(PieceType::GENERAL, Color::RED, Position(1, 5));
+    EXPECT_EQ(whenPositionIsWritten(), "4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1");
+}
+
+// Scenario: Writing into a buffer that is too small fails without overrunning it
+TEST_F(FenSteps, WritingIntoSmallBufferFails) {
+    givenPosition(std::string(Fen::START_POSITION));
+
+    char small[16] = {};
+    EXPECT_EQ(Fen::write(game, small, sizeof(small)), 0u);
+    EXPECT_EQ(small[0], '\0');
+}
+
+// Scenario: Moves are validated against a loaded position
+TEST_F(FenSteps, MovesAreValidatedAgainstLoadedPosition) {
+    // Red Horse at (2, 3) with its leg blocked by a Red Rook at (3, 3)
+    givenPosition("4k4/9/9/9/9/9/9/2R6/2N6/4K4 w - - 0 1");
+
+    lastMoveResult = game.makeMove(Position(2, 3), Position(4, 4));
+
+    EXPECT_FALSE(lastMoveResult.isLegal) << "Move should be illegal - Horse leg is blocked";
+}
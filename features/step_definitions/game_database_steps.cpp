@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include "game/Game.h"
+#include "game/Fen.h"
+#include "game/PackedPosition.h"
+#include "game/Zobrist.h"
+#include "io/GameDatabase.h"
+#include "io/GameRecordReader.h"
+
+class GameDatabaseSteps : public ::testing::Test {
+protected:
+    std::string base;
+    GameDatabase database;
+
+    void SetUp() override {
+        base = ::testing::TempDir() + "game_database_steps";
+        std::remove(GameDatabase::gamesPath(base).c_str());
+        std::remove(GameDatabase::indexPath(base).c_str());
+
+        givenDatabaseBuiltFrom(
+            "[Format \"ICCS\"]\n[Result \"1-0\"]\n1. h2e2 h9g7 2. h0g2 i9h9 1-0\n\n"
+            "[Format \"WXF\"]\n[Result \"0-1\"]\n1. C2.5 H8+7 2. H2+3 R9.8 0-1\n\n"
+            "[Format \"ICCS\"]\n[Result \"1/2-1/2\"]\n1. h0g2 h9g7 1/2-1/2\n");
+    }
+
+    void TearDown() override {
+        database.close();
+        std::remove(GameDatabase::gamesPath(base).c_str());
+        std::remove(GameDatabase::indexPath(base).c_str());
+    }
+
+    void givenDatabaseBuiltFrom(std::string_view pgn) {
+        GameDatabaseWriter writer;
+        ASSERT_TRUE(writer.open(base));
+        Game scratch;
+        GameRecordReader reader(pgn);
+        GameRecord record;
+        while (reader.next(record)) {
+            ASSERT_TRUE(writer.appendRecord(record, scratch));
+        }
+        writer.close();
+        ASSERT_TRUE(GameDatabase::buildIndex(base));
+        ASSERT_TRUE(database.open(base));
+    }
+
+    std::uint64_t keyAfter(const std::string& iccsMoves) {
+        Game game;
+        Fen::parse(Fen::START_POSITION, game);
+        for (std::size_t i = 0; i + Notation::ICCS_LENGTH <= iccsMoves.size(); i += Notation::ICCS_LENGTH + 1) {
+            Position from, to;
+            EXPECT_TRUE(Notation::parseIccs(std::string_view(iccsMoves).substr(i, Notation::ICCS_LENGTH), from, to));
+            EXPECT_TRUE(game.makeMove(from, to).isLegal);
+        }
+        return Zobrist::hash(game.getBoard(), game.getCurrentPlayer());
+    }
+};
+
+// Scenario: The initial position is reached by every game
+TEST_F(GameDatabaseSteps, InitialPositionIsReachedByEveryGame) {
+    EXPECT_EQ(database.gameCount(), 3u);
+
+    PositionStats stats = database.stats(keyAfter(""));
+
+    EXPECT_EQ(stats.games, 3u);
+    EXPECT_EQ(stats.redWins, 1u);
+    EXPECT_EQ(stats.blackWins, 1u);
+    EXPECT_EQ(stats.draws, 1u);
+}
+
+// Scenario: A position after the first move narrows the games
+TEST_F(GameDatabaseSteps, PositionAfterFirstMoveNarrowsGames) {
+    PositionMatches matches = database.find(keyAfter("h2e2"));
+
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches.first[0].game, 0u);
+    EXPECT_EQ(matches.first[1].game, 1u);
+    EXPECT_EQ(matches.first[0].ply, 1);
+
+    // Transposition: both move orders reach the same position
+    EXPECT_EQ(database.find(keyAfter("h2e2 h9g7 h0g2")).size(), 2u);
+    EXPECT_TRUE(database.find(keyAfter("a0a1")).empty());
+}
+
+// Scenario: A stored game replays through the rules engine
+TEST_F(GameDatabaseSteps, StoredGameReplaysThroughRulesEngine) {
+    Game game;
+    ASSERT_TRUE(database.replay(2, game));
+
+    Piece* horse = game.getBoard().getPiece(Position(3, 7));
+    ASSERT_NE(horse, nullptr);
+    EXPECT_EQ(horse->getType(), PieceType::HORSE);
+    EXPECT_EQ(horse->getColor(), Color::RED);
+    EXPECT_EQ(game.getCurrentPlayer(), Color::RED);
+}
+
+// Scenario: Appending more games keeps earlier game numbers stable
+TEST_F(GameDatabaseSteps, AppendingKeepsEarlierGameNumbers) {
+    database.close();
+    givenDatabaseBuiltFrom("[Result \"1-0\"]\n1. b2e2 1-0\n");
+
+    EXPECT_EQ(database.gameCount(), 4u);
+    PositionMatches matches = database.find(keyAfter("b2e2"));
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches.first->game, 3u);
+}
+
+// Scenario: A game torn by an interrupted append is dropped before the next append
+TEST_F(GameDatabaseSteps, TornTailIsDroppedBeforeAppending) {
+    database.close();
+    {
+        // Header of a 5-ply game with only one of its moves written
+        std::FILE* games = std::fopen(GameDatabase::gamesPath(base).c_str(), "ab");
+        ASSERT_NE(games, nullptr);
+        unsigned char torn[42] = {5};
+        std::fwrite(torn, 1, sizeof(torn), games);
+        std::fclose(games);
+    }
+    givenDatabaseBuiltFrom("[Result \"1-0\"]\n1. b2e2 1-0\n");
+
+    EXPECT_EQ(database.gameCount(), 4u);
+    PositionMatches matches = database.find(keyAfter("b2e2"));
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches.first->game, 3u);
+}
+
+// Scenario: A games file shorter than its header is refused
+TEST_F(GameDatabaseSteps, PartialHeaderIsRefused) {
+    database.close();
+    std::FILE* games = std::fopen(GameDatabase::gamesPath(base).c_str(), "wb");
+    ASSERT_NE(games, nullptr);
+    std::fwrite("XQGAM", 1, 5, games);
+    std::fclose(games);
+
+    GameDatabaseWriter writer;
+    EXPECT_FALSE(writer.open(base));
+}
+
+// Scenario: Moves off the board or from an empty square are refused
+TEST_F(GameDatabaseSteps, UnreplayableMovesAreRefused) {
+    database.close();
+    Game game;
+    ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+    PackedPosition start;
+    ASSERT_TRUE(PackedPosition::encode(game, start));
+    GameDatabaseWriter writer;
+    ASSERT_TRUE(writer.open(base));
+    Move offBoard(127, 0);
+    Move fromEmpty(squareIndex(Position(5, 5)), squareIndex(Position(6, 5)));
+    EXPECT_FALSE(writer.appendGame(start, &offBoard, 1, GameResult::UNKNOWN));
+    EXPECT_FALSE(writer.appendGame(start, &fromEmpty, 1, GameResult::UNKNOWN));
+    writer.close();
+
+    // The same damage written past the writer stops the index build
+    std::FILE* games = std::fopen(GameDatabase::gamesPath(base).c_str(), "ab");
+    ASSERT_NE(games, nullptr);
+    std::uint32_t header[2] = {1, 0};
+    std::fwrite(header, 1, sizeof(header), games);
+    std::fwrite(&start, 1, sizeof(start), games);
+    std::fwrite(&offBoard.bits, 1, sizeof(offBoard.bits), games);
+    std::fclose(games);
+    EXPECT_FALSE(GameDatabase::buildIndex(base));
+}
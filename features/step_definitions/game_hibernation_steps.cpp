@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "diagnostics/AllocTracker.h"
+#include "game/Fen.h"
+#include "game/HibernatedGame.h"
+
+class GameHibernationSteps : public ::testing::Test {
+protected:
+    Game game;
+
+    // Deterministic play: the first legal move, cycling the starting square
+    void givenGamePlies(int plies) {
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+        for (int ply = 0; ply < plies; ++ply) {
+            MoveSpan moves = game.allLegalMoves();
+            ASSERT_FALSE(moves.empty());
+            Move move = moves.begin()[(ply * 7) % moves.size()];
+            ASSERT_TRUE(game.makeMove(move.fromPosition(), move.toPosition()).isLegal);
+        }
+    }
+
+    static void thenSameGame(const Game& expected, const Game& actual) {
+        EXPECT_EQ(actual.getBoard().toCodes(), expected.getBoard().toCodes());
+        EXPECT_EQ(actual.getCurrentPlayer(), expected.getCurrentPlayer());
+        EXPECT_EQ(actual.ply(), expected.ply());
+        EXPECT_EQ(actual.isGameOver(), expected.isGameOver());
+        ASSERT_EQ(actual.historyLength(), expected.historyLength());
+        for (int ply = 0; ply < expected.historyLength(); ++ply) {
+            EXPECT_EQ(actual.historyEntry(ply).bits, expected.historyEntry(ply).bits) << "ply " << ply;
+        }
+    }
+};
+
+// Scenario: A resumed game continues exactly where it stopped
+TEST_F(GameHibernationSteps, ResumedGameContinuesWhereItStopped) {
+    givenGamePlies(20);
+    HibernatedGame saved;
+    ASSERT_TRUE(game.hibernate(saved));
+
+    auto fresh = std::make_unique<Game>();
+    ASSERT_TRUE(fresh->resume(saved));
+    thenSameGame(game, *fresh);
+
+    Move next = game.allLegalMoves().begin()[0];
+    EXPECT_TRUE(game.makeMove(next.fromPosition(), next.toPosition()).isLegal);
+    EXPECT_TRUE(fresh->makeMove(next.fromPosition(), next.toPosition()).isLegal);
+    thenSameGame(game, *fresh);
+}
+
+// Scenario: Taken-back moves can still be redone after resuming
+TEST_F(GameHibernationSteps, TakenBackMovesCanBeRedone) {
+    givenGamePlies(20);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(game.takeback());
+    }
+    HibernatedGame saved;
+    ASSERT_TRUE(game.hibernate(saved));
+    Game resumed;
+    ASSERT_TRUE(resumed.resume(saved));
+    EXPECT_EQ(resumed.ply(), 15);
+    thenSameGame(game, resumed);
+
+    while (game.redo()) {
+        ASSERT_TRUE(resumed.redo());
+    }
+    EXPECT_FALSE(resumed.redo());
+    thenSameGame(game, resumed);
+}
+
+// Scenario: A hibernated game is two orders of magnitude smaller
+TEST_F(GameHibernationSteps, HibernatedGameIsMuchSmaller) {
+    AllocCounts before = AllocTracker::thread();
+    auto live = std::make_unique<Game>();
+    ASSERT_TRUE(Fen::parse(Fen::START_POSITION, *live));
+    std::uint64_t liveBytes = AllocTracker::thread().bytes - before.bytes;
+
+    givenGamePlies(40);
+    HibernatedGame saved;
+    ASSERT_TRUE(game.hibernate(saved));
+    EXPECT_EQ(sizeof(HibernatedGame), 48u);
+    EXPECT_EQ(saved.bytes(), 48u + 4u * 40u);
+    if (AllocTracker::isActive()) {
+        // The Game block itself and its pieces, history and checkpoints
+        EXPECT_GT(liveBytes, 100u * sizeof(HibernatedGame));
+    }
+}
+
+// Scenario: The stored form round-trips and damaged data is rejected
+TEST_F(GameHibernationSteps, StoredFormRoundTripsAndRejectsDamage) {
+    givenGamePlies(20);
+    HibernatedGame saved;
+    ASSERT_TRUE(game.hibernate(saved));
+    std::string bytes;
+    saved.serialize(bytes);
+    EXPECT_EQ(bytes.size(), 40u + 4u * 20u);
+
+    HibernatedGame loaded;
+    ASSERT_TRUE(HibernatedGame::deserialize(bytes, loaded));
+    Game resumed;
+    ASSERT_TRUE(resumed.resume(loaded));
+    thenSameGame(game, resumed);
+
+    EXPECT_FALSE(HibernatedGame::deserialize(std::string_view(bytes).substr(0, bytes.size() - 2), loaded));
+    // Ply 0's move replaced by a red rook jumping to the far side
+    std::string damaged = bytes;
+    HistoryEntry illegal(Move(Position(1, 1), Position(10, 9)), EMPTY_CODE, false);
+    std::memcpy(&damaged[40], &illegal, sizeof(illegal));
+    ASSERT_TRUE(HibernatedGame::deserialize(damaged, loaded));
+    EXPECT_FALSE(resumed.resume(loaded));
+    EXPECT_EQ(resumed.historyLength(), 0);
+}
+
+// Scenario: A finished game resumes as finished
+TEST_F(GameHibernationSteps, FinishedGameResumesAsFinished) {
+    ASSERT_TRUE(Fen::parse("4k4/9/9/9/9/9/9/9/4R4/3K5 w - - 0 1", game));
+    ASSERT_TRUE(game.makeMove(Position(2, 5), Position(10, 5)).gameEnded);
+    HibernatedGame saved;
+    ASSERT_TRUE(game.hibernate(saved));
+    Game resumed;
+    ASSERT_TRUE(resumed.resume(saved));
+    EXPECT_TRUE(resumed.isGameOver());
+    EXPECT_EQ(resumed.getWinner(), Color::RED);
+    thenSameGame(game, resumed);
+}
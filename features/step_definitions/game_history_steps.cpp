@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "engine/MoveGenerator.h"
+#include "game/Fen.h"
+#include "game/Zobrist.h"
+
+class GameHistorySteps : public ::testing::Test {
+protected:
+    Game game;
+
+    void SetUp() override {
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+    }
+
+    std::uint64_t key() const {
+        return Zobrist::hash(game.getBoard(), game.getCurrentPlayer());
+    }
+
+    // Plays the first legal move 'plies' times and returns the key after each ply (index 0 = start)
+    std::vector<std::uint64_t> playMoves(int plies) {
+        std::vector<std::uint64_t> keys{key()};
+        for (int i = 0; i < plies; ++i) {
+            BoardState state = BoardState::fromGame(game);
+            Move moves[MoveGenerator::MAX_MOVES];
+            int count = MoveGenerator::generateLegal(state, moves);
+            EXPECT_GT(count, 0);
+            // Vary the choice so the game is not a shuffle of one piece
+            Move move = moves[(i * 7) % count];
+            EXPECT_TRUE(game.makeMove(move.fromPosition(), move.toPosition()).isLegal);
+            keys.push_back(key());
+        }
+        return keys;
+    }
+};
+
+// Scenario: Taking back a capture restores the captured piece
+TEST_F(GameHistorySteps, TakingBackCaptureRestoresCapturedPiece) {
+    std::uint64_t start = key();
+    ASSERT_TRUE(game.makeMove(Position(3, 8), Position(10, 8)).isLegal);
+    HistoryEntry entry = game.historyEntry(0);
+    EXPECT_EQ(entry.move(), Move(Position(3, 8), Position(10, 8)));
+    EXPECT_EQ(entry.captured(), pieceCode(PieceType::HORSE, Color::BLACK));
+
+    ASSERT_TRUE(game.takeback());
+    EXPECT_EQ(key(), start);
+    EXPECT_EQ(game.getCurrentPlayer(), Color::RED);
+    EXPECT_EQ(game.ply(), 0);
+    EXPECT_FALSE(game.takeback());
+
+    ASSERT_TRUE(game.redo());
+    EXPECT_EQ(game.getBoard().getPiece(Position(10, 8))->getType(), PieceType::CANNON);
+    EXPECT_EQ(game.getCurrentPlayer(), Color::BLACK);
+}
+
+// Scenario: Taking back a General capture reopens the game
+TEST_F(GameHistorySteps, TakingBackGeneralCaptureReopensTheGame) {
+    ASSERT_TRUE(Fen::parse("4k4/9/9/9/9/9/9/9/4R4/3K5 w - - 0 1", game));
+    MoveResult result = game.makeMove(Position(2, 5), Position(10, 5));
+    ASSERT_TRUE(result.gameEnded);
+    EXPECT_TRUE(game.historyEntry(0).endedGame());
+
+    ASSERT_TRUE(game.takeback());
+    EXPECT_FALSE(game.isGameOver());
+    EXPECT_EQ(game.getCurrentPlayer(), Color::RED);
+    EXPECT_EQ(game.getBoard().getPiece(Position(10, 5))->getType(), PieceType::GENERAL);
+
+    ASSERT_TRUE(game.redo());
+    EXPECT_TRUE(game.isGameOver());
+    EXPECT_EQ(game.getWinner(), Color::RED);
+}
+
+// Scenario: Seek jumps to any earlier or later ply
+TEST_F(GameHistorySteps, SeekJumpsToAnyEarlierOrLaterPly) {
+    std::vector<std::uint64_t> keys = playMoves(40);
+    ASSERT_EQ(game.historyLength(), 40);
+
+    for (int ply : {0, 40, 17, 3, 33, 32, 16, 15, 39, 1, 40, 24, 8}) {
+        ASSERT_TRUE(game.seek(ply));
+        EXPECT_EQ(game.ply(), ply);
+        EXPECT_EQ(key(), keys[ply]) << "ply " << ply;
+    }
+    EXPECT_FALSE(game.seek(41));
+    EXPECT_FALSE(game.seek(-1));
+}
+
+// Scenario: A new move after a takeback replaces the rest of the line
+TEST_F(GameHistorySteps, NewMoveAfterTakebackReplacesTheRestOfTheLine) {
+    playMoves(3);
+    ASSERT_TRUE(game.takeback());
+    ASSERT_TRUE(game.takeback());
+    ASSERT_EQ(game.historyLength(), 3);
+
+    Move replaced = game.historyEntry(1).move();
+    ASSERT_NE(replaced, Move(Position(10, 1), Position(9, 1)));
+    ASSERT_TRUE(game.makeMove(Position(10, 1), Position(9, 1)).isLegal);
+    EXPECT_EQ(game.historyLength(), 2);
+    EXPECT_FALSE(game.redo());
+    EXPECT_EQ(game.historyEntry(1).move(), Move(Position(10, 1), Position(9, 1)));
+}
+
+// Scenario: Seeking back to a game that ended on a checkpoint ply keeps it over
+TEST_F(GameHistorySteps, SeekToGameEndingOnCheckpointPlyKeepsItOver) {
+    ASSERT_TRUE(Fen::parse("4k4/9/9/9/9/9/9/9/4R4/3K5 b - - 0 1", game));
+    // Generals shuffle for 15 plies, then the rook takes the Black General on ply 16
+    static const Position shuffle[4][2] = {
+        {Position(10, 5), Position(9, 5)}, {Position(1, 4), Position(2, 4)},
+        {Position(9, 5), Position(10, 5)}, {Position(2, 4), Position(1, 4)},
+    };
+    for (int ply = 0; ply < Game::CHECKPOINT_INTERVAL - 1; ++ply) {
+        ASSERT_TRUE(game.makeMove(shuffle[ply % 4][0], shuffle[ply % 4][1]).isLegal) << "ply " << ply;
+    }
+    ASSERT_TRUE(game.makeMove(Position(2, 5), Position(10, 5)).gameEnded);
+    ASSERT_EQ(game.ply(), Game::CHECKPOINT_INTERVAL);
+
+    ASSERT_TRUE(game.seek(0));
+    EXPECT_FALSE(game.isGameOver());
+    ASSERT_TRUE(game.seek(Game::CHECKPOINT_INTERVAL));
+    EXPECT_TRUE(game.isGameOver());
+    EXPECT_EQ(game.getWinner(), Color::RED);
+    EXPECT_FALSE(game.makeMove(Position(2, 4), Position(1, 4)).isLegal);
+}
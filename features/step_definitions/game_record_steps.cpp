@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "game/Game.h"
+#include "game/Fen.h"
+#include "io/GameRecordReader.h"
+#include "io/MappedFile.h"
+
+class GameRecordSteps : public ::testing::Test {
+protected:
+    const std::string twoGames =
+        "[Event \"Club match\"]\n"
+        "[Format \"ICCS\"]\n"
+        "[Result \"1-0\"]\n"
+        "\n"
+        "1. h2e2 h9g7 2. h0g2 i9h9 3. i0h0 b9c7 1-0\n"
+        "\n"
+        "[Event \"Club match\"]\n"
+        "[Format \"WXF\"]\n"
+        "[Result \"0-1\"]\n"
+        "\n"
+        "1. C2.5 H8+7 {main line} 2. H2+3 R9.8 (2... H2+3) 3. R1.2 H2+3 0-1\n";
+
+    std::vector<GameRecord> whenFileIsRead(std::string_view data) {
+        std::vector<GameRecord> records;
+        GameRecordReader reader(data);
+        GameRecord record;
+        while (reader.next(record)) {
+            records.push_back(record);
+        }
+        return records;
+    }
+
+    std::string fenOf(const Game& game) {
+        char buffer[Fen::MAX_LENGTH];
+        return std::string(buffer, Fen::write(game, buffer, sizeof(buffer)));
+    }
+};
+
+// Scenario: Every game and its headers are read
+TEST_F(GameRecordSteps, EveryGameAndItsHeadersAreRead) {
+    std::vector<GameRecord> records = whenFileIsRead(twoGames);
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].header("Event"), "Club match");
+    EXPECT_EQ(records[0].header("Format"), "ICCS");
+    EXPECT_EQ(records[0].result(), GameResult::RED_WIN);
+    EXPECT_EQ(records[1].result(), GameResult::BLACK_WIN);
+    EXPECT_EQ(records[0].startFen(), Fen::START_POSITION);
+}
+
+// Scenario: ICCS and WXF move text replay to the same position
+TEST_F(GameRecordSteps, IccsAndWxfReplayToSamePosition) {
+    std::vector<GameRecord> records = whenFileIsRead(twoGames);
+    ASSERT_EQ(records.size(), 2u);
+
+    Game iccsGame, wxfGame;
+    ReplayResult iccs = records[0].replay(iccsGame);
+    ReplayResult wxf = records[1].replay(wxfGame);
+
+    ASSERT_TRUE(iccs.ok) << "Failed at " << iccs.failedToken;
+    ASSERT_TRUE(wxf.ok) << "Failed at " << wxf.failedToken;
+    EXPECT_EQ(iccs.plies, 6);
+    EXPECT_EQ(wxf.plies, 6);
+    EXPECT_EQ(fenOf(iccsGame), fenOf(wxfGame));
+
+    // Red's central cannon ended up on (3, 5)
+    Piece* cannon = iccsGame.getBoard().getPiece(Position(3, 5));
+    ASSERT_NE(cannon, nullptr);
+    EXPECT_EQ(cannon->getType(), PieceType::CANNON);
+}
+
+// Scenario: An illegal move stops the replay
+TEST_F(GameRecordSteps, IllegalMoveStopsReplay) {
+    std::vector<GameRecord> records = whenFileIsRead("[Event \"Broken\"]\n\n1. h2e2 h9g7 2. h2h9 *\n");
+    ASSERT_EQ(records.size(), 1u);
+
+    Game game;
+    int executed = 0;
+    ReplayResult result = records[0].replay(game, [&](int, const Position&, const Position&, const MoveResult&) {
+        ++executed;
+    });
+
+    EXPECT_FALSE(result.ok);
+    EXPECT_EQ(result.failedToken, "h2h9") << "The cannon already left h2";
+    EXPECT_EQ(executed, 2);
+}
+
+// Scenario: The buffered stream reader sees the same games as the in-memory reader
+TEST_F(GameRecordSteps, BufferedStreamMatchesInMemoryReader) {
+    std::istringstream in(twoGames + twoGames);
+    GameRecordStream stream(in, 32); // forces games to straddle block boundaries
+
+    std::vector<std::string> streamed;
+    GameRecord record;
+    while (stream.next(record)) {
+        streamed.emplace_back(record.moveText());
+    }
+
+    std::string doubled = twoGames + twoGames;
+    std::vector<GameRecord> records = whenFileIsRead(doubled);
+    ASSERT_EQ(streamed.size(), records.size());
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(streamed[i], records[i].moveText());
+    }
+}
+
+// Scenario: Parallel chunked reading finds every game
+TEST_F(GameRecordSteps, ParallelChunkedReadingFindsEveryGame) {
+    std::string path = ::testing::TempDir() + "game_record_steps.pgn";
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int i = 0; i < 20; ++i) {
+            out << twoGames << "\n";
+        }
+    }
+
+    MappedFile file(path);
+    ASSERT_TRUE(file.isOpen());
+
+    std::atomic<int> games{0};
+    std::atomic<int> plies{0};
+    GameRecordReader::forEachGameParallel(file.view(), 4, [&](const GameRecord& record, Game& game, unsigned) {
+        ReplayResult result = record.replay(game);
+        if (result.ok) {
+            ++games;
+            plies += result.plies;
+        }
+    });
+
+    EXPECT_EQ(games.load(), 40);
+    EXPECT_EQ(plies.load(), 240);
+    file.close();
+    std::remove(path.c_str());
+}
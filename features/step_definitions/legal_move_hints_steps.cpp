@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <string_view>
+#include "diagnostics/AllocTracker.h"
+#include "diagnostics/Stats.h"
+#include "game/Fen.h"
+#include "game/Game.h"
+#include "game/PieceFactory.h"
+
+class LegalMoveHintsSteps : public ::testing::Test {
+protected:
+    static constexpr std::string_view MIDDLEGAME =
+        "r1bakab1r/9/1cn4c1/p1p1p1p1p/4n4/2P6/P3P1P1P/1CN1C1N2/9/R1BAKAB1R w - - 0 1";
+    static constexpr std::string_view ENDGAME = "3k5/4a4/4b4/9/2p6/9/6P2/4B4/4A4/3AK1R2 w - - 0 1";
+
+    Game game;
+
+    void givenPosition(std::string_view fen) {
+        ASSERT_TRUE(Fen::parse(fen, game));
+    }
+
+    // Every query agrees with isMoveLegal() on all 90 x 90 square pairs
+    void thenHintsMatchProbing() {
+        int total = 0;
+        for (int from = 0; from < BOARD_SQUARES; ++from) {
+            Position fromPos = squarePosition(from);
+            SquareSet expected;
+            for (int to = 0; to < BOARD_SQUARES; ++to) {
+                expected[to] = game.isMoveLegal(fromPos, squarePosition(to));
+            }
+            EXPECT_EQ(game.legalDestinations(fromPos), expected) << "from square " << from;
+            MoveSpan moves = game.legalMovesFrom(fromPos);
+            EXPECT_EQ(static_cast<std::size_t>(moves.size()), expected.count());
+            for (Move move : moves) {
+                EXPECT_EQ(move.from(), from);
+                EXPECT_TRUE(expected[move.to()]);
+            }
+            total += static_cast<int>(expected.count());
+        }
+        MoveSpan all = game.allLegalMoves();
+        EXPECT_EQ(all.size(), total);
+        for (Move move : all) {
+            EXPECT_TRUE(game.isMoveLegal(move.fromPosition(), move.toPosition()));
+        }
+    }
+};
+
+// Scenario: Cached moves are exactly the moves the referee accepts
+TEST_F(LegalMoveHintsSteps, CachedMovesMatchReferee) {
+    for (std::string_view fen : {Fen::START_POSITION, MIDDLEGAME, ENDGAME}) {
+        givenPosition(fen);
+        thenHintsMatchProbing();
+    }
+    givenPosition(Fen::START_POSITION);
+    EXPECT_EQ(game.allLegalMoves().size(), 44);
+}
+
+// Scenario: The cache follows moves, takebacks and seeks
+TEST_F(LegalMoveHintsSteps, CacheFollowsMovesTakebacksAndSeeks) {
+    givenPosition(Fen::START_POSITION);
+    SquareSet initialCannon = game.legalDestinations(Position(3, 2));
+    ASSERT_TRUE(initialCannon.any());
+
+    ASSERT_TRUE(game.makeMove(Position(3, 2), Position(3, 5)).isLegal);
+    EXPECT_TRUE(game.legalMovesFrom(Position(3, 5)).empty()); // Red's cannon, Black to move
+    EXPECT_TRUE(game.legalDestinations(Position(8, 2)).any());
+    thenHintsMatchProbing();
+
+    ASSERT_TRUE(game.takeback());
+    EXPECT_EQ(game.legalDestinations(Position(3, 2)), initialCannon);
+    thenHintsMatchProbing();
+
+    ASSERT_TRUE(game.seek(1));
+    EXPECT_TRUE(game.legalDestinations(Position(3, 2)).none());
+    thenHintsMatchProbing();
+}
+
+// Scenario: Editing the board directly refreshes the hints
+TEST_F(LegalMoveHintsSteps, DirectBoardEditRefreshesHints) {
+    givenPosition(Fen::START_POSITION);
+    EXPECT_TRUE(game.legalDestinations(Position(1, 1)).test(squareIndex(3, 1)));
+    game.getBoard().setPiece(Position(2, 1), PieceFactory::create(PieceType::ROOK, Color::BLACK));
+    SquareSet rook = game.legalDestinations(Position(1, 1));
+    EXPECT_TRUE(rook.test(squareIndex(2, 1)));
+    EXPECT_FALSE(rook.test(squareIndex(3, 1)));
+    thenHintsMatchProbing();
+}
+
+// Scenario: Queries after the first one are lookups that do not allocate
+TEST_F(LegalMoveHintsSteps, RepeatedQueriesDoNotAllocate) {
+    givenPosition(MIDDLEGAME);
+    StatsSnapshot before = Stats::snapshot();
+    NoAllocGuard guard("legal move hints");
+    int total = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            total += game.legalMovesFrom(squarePosition(square)).size();
+            total += static_cast<int>(game.legalDestinations(squarePosition(square)).count());
+        }
+    }
+    EXPECT_EQ(guard.allocations(), 0u);
+    EXPECT_EQ(total, 4 * game.allLegalMoves().size());
+    if (Stats::ENABLED) {
+        EXPECT_EQ((Stats::snapshot() - before).counter(StatCounter::LEGAL_MOVE_CACHE_BUILDS), 1u);
+    }
+}
+
+// Scenario: There are no hints for the wrong side, empty squares or a finished game
+TEST_F(LegalMoveHintsSteps, NoHintsForWrongSideEmptySquaresOrFinishedGame) {
+    givenPosition(Fen::START_POSITION);
+    EXPECT_TRUE(game.legalMovesFrom(Position(10, 1)).empty());
+    EXPECT_TRUE(game.legalMovesFrom(Position(5, 5)).empty());
+    EXPECT_TRUE(game.legalMovesFrom(Position(0, 5)).empty());
+    EXPECT_TRUE(game.legalDestinations(Position(11, 1)).none());
+
+    givenPosition("4k4/9/9/9/9/9/9/9/4R4/3K5 w - - 0 1");
+    ASSERT_TRUE(game.makeMove(Position(2, 5), Position(10, 5)).gameEnded);
+    EXPECT_TRUE(game.allLegalMoves().empty());
+    EXPECT_TRUE(game.legalDestinations(Position(1, 4)).none());
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "engine/MateSolver.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+#include "position_steps.h"
+
+class MateSolverSteps : public PositionSteps {
+protected:
+    MateSolverSettings settings;
+    MateResult result;
+
+    void SetUp() override {
+        settings.tableMegabytes = 4;
+    }
+
+    void whenSolverRuns(std::uint64_t nodes = 0) {
+        MateSolver solver(settings);
+        SearchLimits limits;
+        limits.nodes = nodes;
+        result = solver.solve(state, limits);
+    }
+
+    std::string mainLine() const {
+        std::string text;
+        for (Move move : result.mainLine) {
+            char iccs[Notation::ICCS_LENGTH];
+            Notation::writeIccs(move.fromPosition(), move.toPosition(), iccs);
+            text += (text.empty() ? "" : " ") + std::string(iccs, Notation::ICCS_LENGTH);
+        }
+        return text;
+    }
+};
+
+// Scenario: The solver proves a mate in one
+TEST_F(MateSolverSteps, ProvesMateInOne) {
+    givenPosition("3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1");
+    whenSolverRuns();
+    EXPECT_EQ(result.status, MateStatus::PROVEN);
+    EXPECT_EQ(mainLine(), "a4d4");
+}
+
+// Scenario: The solver proves a long checking sequence and returns its main line
+TEST_F(MateSolverSteps, ProvesLongCheckingSequence) {
+    givenPosition("9/3ka4/5a3/2R6/9/9/9/1H1C5/3K5/9 w - - 0 1");
+    whenSolverRuns();
+    ASSERT_EQ(result.status, MateStatus::PROVEN);
+    ASSERT_GE(result.mainLine.size(), 9u) << mainLine();
+    EXPECT_EQ(result.mainLine.size() % 2, 1u) << mainLine();
+
+    BoardState replay = state;
+    for (std::size_t i = 0; i < result.mainLine.size(); ++i) {
+        ASSERT_TRUE(MoveGenerator::isLegal(replay, result.mainLine[i])) << "ply " << i << ": " << mainLine();
+        replay.makeMove(result.mainLine[i]);
+        if (i % 2 == 0) {
+            EXPECT_TRUE(MoveGenerator::isInCheck(replay, Color::BLACK)) << "ply " << i << ": " << mainLine();
+        }
+    }
+    Move replies[MoveGenerator::MAX_MOVES];
+    EXPECT_EQ(MoveGenerator::generateLegal(replay, replies), 0);
+}
+
+// Scenario: A position without a checking move is disproven
+TEST_F(MateSolverSteps, NoCheckingMoveIsDisproven) {
+    givenPosition("3k5/9/9/9/9/9/P8/9/9/4K4 w - - 0 1");
+    whenSolverRuns();
+    EXPECT_EQ(result.status, MateStatus::DISPROVEN);
+    EXPECT_TRUE(result.mainLine.empty());
+}
+
+// Scenario: Quiet moves are searched when checks-only is turned off
+TEST_F(MateSolverSteps, QuietMovesWhenChecksOnlyIsOff) {
+    // a0a8 leaves Black without a move, which loses in Xiangqi, but gives no
+    // check; the rook checks that remain only run into the ply limit
+    givenPosition("4k4/9/9/9/9/9/9/9/9/R2K1R3 w - - 0 1");
+    settings.maxPly = 9;
+    whenSolverRuns();
+    EXPECT_EQ(result.status, MateStatus::UNKNOWN);
+
+    settings.checksOnly = false;
+    whenSolverRuns();
+    EXPECT_EQ(result.status, MateStatus::PROVEN);
+    EXPECT_EQ(mainLine(), "a0a8");
+}
+
+// Scenario: A node limit leaves the result unknown
+TEST_F(MateSolverSteps, NodeLimitLeavesResultUnknown) {
+    givenPosition("9/3ka4/5a3/2R6/9/9/9/1H1C5/3K5/9 w - - 0 1");
+    whenSolverRuns(20);
+    EXPECT_EQ(result.status, MateStatus::UNKNOWN);
+    EXPECT_TRUE(result.mainLine.empty());
+    EXPECT_LE(result.nodes, 20u);
+}
+
+// Scenario: A refutation that rests on perpetual check is not reported as disproven
+TEST_F(MateSolverSteps, PerpetualCheckRefutationIsUnknown) {
+    // The lone rook can check forever but never mates
+    givenPosition("3k5/9/9/9/9/9/9/9/9/4K1R2 w - - 0 1");
+    whenSolverRuns();
+    EXPECT_EQ(result.status, MateStatus::UNKNOWN);
+    EXPECT_TRUE(result.mainLine.empty());
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine/Mcts.h"
+#include "engine/UcciEngine.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+#include "position_steps.h"
+
+class MctsSteps : public PositionSteps {
+protected:
+    MctsSettings settings;
+    SearchResult result;
+
+    void SetUp() override {
+        settings.treeMegabytes = 8;
+        givenPosition(Fen::START_POSITION);
+    }
+
+    void whenMctsRuns(std::uint64_t playouts) {
+        Mcts mcts(settings);
+        SearchLimits limits;
+        limits.nodes = playouts;
+        result = mcts.run(state, std::vector<std::uint64_t>(), limits);
+    }
+
+    bool isLegal(Move move) {
+        BoardState copy = state;
+        return !move.isNull() && MoveGenerator::isLegal(copy, move);
+    }
+};
+
+// Scenario: MCTS finds a mate in one
+TEST_F(MctsSteps, MctsFindsMateInOne) {
+    givenPosition("3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1");
+    whenMctsRuns(3000);
+    // a4a8 also wins at once: Black is left without a move, which loses in Xiangqi
+    EXPECT_TRUE(result.best == iccs("a4d4") || result.best == iccs("a4a8"));
+    EXPECT_GE(result.score, Search::MATE_BOUND);
+    BoardState after = state;
+    after.makeMove(result.best);
+    Move replies[MoveGenerator::MAX_MOVES];
+    EXPECT_EQ(MoveGenerator::generateLegal(after, replies), 0);
+}
+
+// Scenario: MCTS takes undefended material
+TEST_F(MctsSteps, MctsTakesUndefendedMaterial) {
+    givenPosition("3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1");
+    whenMctsRuns(3000);
+    EXPECT_EQ(result.best, iccs("i4e4"));
+}
+
+// Scenario: Four threads share one tree within the playout limit
+TEST_F(MctsSteps, FourThreadsShareOneTreeWithinThePlayoutLimit) {
+    settings.threads = 4;
+    settings.batchSize = 8;
+    Mcts mcts(settings);
+    SearchLimits limits;
+    limits.nodes = 4000;
+    result = mcts.run(state, std::vector<std::uint64_t>(), limits);
+
+    EXPECT_GE(result.nodes, 4000u);
+    EXPECT_LE(result.nodes, 4000u + 4 * 8);
+    EXPECT_TRUE(isLegal(result.best));
+    EXPECT_GT(mcts.treeNodes(), 1000u);
+    EXPECT_GT(result.depth, 1);
+}
+
+// Scenario: A temperature makes the move choice vary
+TEST_F(MctsSteps, TemperatureMakesTheMoveChoiceVary) {
+    settings.temperature = 3.0;
+    std::set<std::uint16_t> chosen;
+    for (int i = 0; i < 20; ++i) {
+        settings.seed = 1000 + static_cast<std::uint64_t>(i);
+        whenMctsRuns(300);
+        EXPECT_TRUE(isLegal(result.best));
+        chosen.insert(result.best.bits);
+    }
+    EXPECT_GE(chosen.size(), 2u);
+}
+
+// Scenario: The UCCI engine searches with MCTS when asked
+TEST_F(MctsSteps, UcciEngineSearchesWithMctsWhenAsked) {
+    std::mutex mutex;
+    std::vector<std::string> lines;
+    UcciEngine engine([&](std::string_view line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.emplace_back(line);
+    });
+    EXPECT_TRUE(engine.handleCommand("setoption searchmode mcts"));
+    EXPECT_TRUE(engine.handleCommand("setoption usebook false"));
+    EXPECT_TRUE(engine.handleCommand("setoption threads 2"));
+    EXPECT_TRUE(engine.handleCommand("position startpos"));
+    EXPECT_TRUE(engine.handleCommand("go nodes 2000"));
+    engine.stopSearch();
+
+    std::string bestmove;
+    for (const std::string& line : lines) {
+        if (line.rfind("bestmove ", 0) == 0) {
+            bestmove = line.substr(9, 4);
+        }
+    }
+    ASSERT_EQ(bestmove.size(), 4u);
+    EXPECT_TRUE(isLegal(iccs(bestmove)));
+}
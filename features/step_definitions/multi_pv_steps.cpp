@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "engine/Search.h"
+#include "engine/UcciEngine.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+#include "position_steps.h"
+
+class MultiPvSteps : public PositionSteps {
+protected:
+    Search search{4};
+    SearchResult result;
+    std::vector<std::pair<int, int>> reported; // depth, multiPv
+
+    void SetUp() override {
+        givenPosition(Fen::START_POSITION);
+    }
+
+    void whenEngineSearches(int depth, int lines) {
+        SearchLimits limits;
+        limits.depth = depth;
+        limits.multiPv = lines;
+        result = search.run(state, std::vector<std::uint64_t>(), limits, [this](const SearchInfo& info) {
+            reported.emplace_back(info.depth, info.multiPv);
+        });
+    }
+
+    bool isLegalLine(const PvLine& line) {
+        BoardState copy = state;
+        for (int i = 0; i < line.length; ++i) {
+            if (!MoveGenerator::isLegal(copy, line.moves[i])) {
+                return false;
+            }
+            copy.makeMove(line.moves[i]);
+        }
+        return line.length > 0;
+    }
+};
+
+// Scenario: Three lines with different first moves, best first
+TEST_F(MultiPvSteps, ThreeLinesBestFirst) {
+    whenEngineSearches(4, 3);
+    ASSERT_EQ(result.lineCount, 3);
+    std::set<std::uint16_t> firstMoves;
+    for (int i = 0; i < result.lineCount; ++i) {
+        EXPECT_TRUE(isLegalLine(result.lines[i])) << "line " << i;
+        firstMoves.insert(result.lines[i].moves[0].bits);
+        if (i > 0) {
+            EXPECT_LE(result.lines[i].score, result.lines[i - 1].score);
+        }
+    }
+    EXPECT_EQ(firstMoves.size(), 3u);
+    EXPECT_EQ(result.best, result.lines[0].moves[0]);
+    EXPECT_EQ(result.score, result.lines[0].score);
+    EXPECT_EQ(result.depth, 4);
+}
+
+// Scenario: The first line finds the same winning move as a single-line search
+TEST_F(MultiPvSteps, FirstLineFindsWinningMove) {
+    givenPosition("3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1");
+    whenEngineSearches(4, 3);
+    ASSERT_EQ(result.lineCount, 3);
+    EXPECT_EQ(result.lines[0].moves[0], iccs("i4e4"));
+    EXPECT_LT(result.lines[1].score, result.lines[0].score);
+    EXPECT_LT(result.lines[2].score, result.lines[0].score);
+}
+
+// Scenario: No more lines than legal moves
+TEST_F(MultiPvSteps, NoMoreLinesThanLegalMoves) {
+    givenPosition("3k5/9/9/9/9/9/9/9/9/4K4 w - - 0 1");
+    Move moves[MoveGenerator::MAX_MOVES];
+    BoardState copy = state;
+    int legal = MoveGenerator::generateLegal(copy, moves);
+    ASSERT_LT(legal, 8);
+    whenEngineSearches(2, 8);
+    EXPECT_EQ(result.lineCount, legal);
+}
+
+// Scenario: Every line of every iteration is reported
+TEST_F(MultiPvSteps, EveryLineOfEveryIterationIsReported) {
+    whenEngineSearches(3, 2);
+    std::vector<std::pair<int, int>> expected = {{1, 1}, {1, 2}, {2, 1}, {2, 2}, {3, 1}, {3, 2}};
+    EXPECT_EQ(reported, expected);
+}
+
+// Scenario: The UCCI engine reports multipv lines
+TEST_F(MultiPvSteps, UcciEngineReportsMultiPvLines) {
+    std::mutex mutex;
+    std::vector<std::string> lines;
+    UcciEngine engine([&](std::string_view line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.emplace_back(line);
+    });
+    engine.handleCommand("setoption multipv 3");
+    engine.handleCommand("position startpos");
+    engine.handleCommand("go depth 2");
+    for (int i = 0; i < 500; ++i) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!lines.empty() && lines.back().rfind("bestmove", 0) == 0) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    engine.stopSearch();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (int depth = 1; depth <= 2; ++depth) {
+        for (int line = 1; line <= 3; ++line) {
+            std::string prefix = "info depth " + std::to_string(depth) + " multipv " + std::to_string(line) + " ";
+            int count = 0;
+            for (const std::string& text : lines) {
+                count += text.rfind(prefix, 0) == 0;
+            }
+            EXPECT_EQ(count, 1) << prefix;
+        }
+    }
+    EXPECT_EQ(lines.back().rfind("bestmove", 0), 0u);
+}
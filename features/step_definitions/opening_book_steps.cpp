@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include "game/Game.h"
+#include "game/Fen.h"
+#include "game/Zobrist.h"
+#include "io/GameRecordReader.h"
+#include "io/OpeningBook.h"
+#include "position_steps.h"
+
+class OpeningBookSteps : public ::testing::Test {
+protected:
+    std::string path;
+    OpeningBook book;
+    Game game;
+
+    void SetUp() override {
+        path = ::testing::TempDir() + "opening_book_steps.book";
+        givenBookBuiltFrom(
+            "[Result \"1-0\"]\n1. h2e2 h9g7 1-0\n\n"
+            "[Result \"1-0\"]\n1. h2e2 b9c7 1-0\n\n"
+            "[Result \"1/2-1/2\"]\n1. h2e2 h9g7 1/2-1/2\n\n"
+            "[Result \"0-1\"]\n1. b2e2 h9g7 0-1\n");
+        Fen::parse(Fen::START_POSITION, game);
+    }
+
+    void TearDown() override {
+        book.close();
+        std::remove(path.c_str());
+    }
+
+    void givenBookBuiltFrom(std::string_view pgn) {
+        OpeningBookBuilder builder(20);
+        Game scratch;
+        GameRecordReader reader(pgn);
+        GameRecord record;
+        while (reader.next(record)) {
+            ASSERT_TRUE(builder.addGame(record, scratch));
+        }
+        ASSERT_TRUE(builder.write(path));
+        ASSERT_TRUE(book.open(path));
+    }
+};
+
+// Scenario: Probing the initial position lists the book moves with statistics
+TEST_F(OpeningBookSteps, ProbingInitialPositionListsMovesWithStatistics) {
+    BookMoves moves = book.probe(game);
+
+    ASSERT_EQ(moves.size(), 2u);
+    // Highest weight first
+    EXPECT_EQ(Move(moves.first[0].move), iccs("h2e2"));
+    EXPECT_EQ(moves.first[0].games, 3u);
+    EXPECT_EQ(moves.first[0].wins, 2u);
+    EXPECT_EQ(moves.first[0].draws, 1u);
+    EXPECT_EQ(Move(moves.first[1].move), iccs("b2e2"));
+    EXPECT_EQ(moves.first[1].wins, 0u);
+
+    // Black's replies after h2e2 are keyed on the position after the move
+    game.makeMove(Position(3, 8), Position(3, 5));
+    EXPECT_EQ(book.probe(game).size(), 2u);
+}
+
+// Scenario: Weighted picks follow the recorded results
+TEST_F(OpeningBookSteps, WeightedPicksFollowRecordedResults) {
+    std::uint64_t key = Zobrist::hash(game.getBoard(), game.getCurrentPlayer());
+    for (std::uint64_t random = 0; random < 100; ++random) {
+        EXPECT_EQ(book.pick(game, random * 0x9E3779B97F4A7C15ULL), iccs("h2e2"));
+    }
+    EXPECT_EQ(book.best(key), iccs("h2e2"));
+}
+
+// Scenario: Positions outside the book return no move
+TEST_F(OpeningBookSteps, PositionsOutsideBookReturnNoMove) {
+    game.makeMove(Position(1, 1), Position(2, 1));
+
+    EXPECT_TRUE(book.probe(game).empty());
+    EXPECT_TRUE(book.pick(game, 12345).isNull());
+}
+
+// Scenario: Interpolation search finds every key of a large book
+TEST_F(OpeningBookSteps, InterpolationSearchFindsEveryKeyOfLargeBook) {
+    book.close();
+    OpeningBookBuilder builder;
+    for (std::uint64_t i = 1; i <= 5000; ++i) {
+        builder.add(i * 0x9E3779B97F4A7C15ULL, Move(i % 90, (i + 1) % 90), Color::RED, GameResult::RED_WIN);
+    }
+    ASSERT_TRUE(builder.write(path));
+    ASSERT_TRUE(book.open(path));
+
+    for (std::uint64_t i = 1; i <= 5000; ++i) {
+        BookMoves moves = book.probe(i * 0x9E3779B97F4A7C15ULL);
+        ASSERT_EQ(moves.size(), 1u) << "key " << i;
+        EXPECT_EQ(Move(moves.first->move), Move(i % 90, (i + 1) % 90));
+    }
+    EXPECT_TRUE(book.probe(0).empty());
+    EXPECT_TRUE(book.probe(~0ULL).empty());
+}
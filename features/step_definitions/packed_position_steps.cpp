@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "game/Game.h"
+#include "game/Fen.h"
+#include "game/PackedPosition.h"
+#include "game/Zobrist.h"
+
+class PackedPositionSteps : public ::testing::Test {
+protected:
+    Game game;
+
+    void givenPosition(Game& target, const std::string& fen) {
+        ASSERT_TRUE(Fen::parse(fen, target)) << "Failed to load " << fen;
+    }
+
+    PackedPosition whenPositionIsPacked(const Game& source) {
+        PackedPosition packed;
+        EXPECT_TRUE(PackedPosition::encode(source, packed));
+        return packed;
+    }
+
+    std::string fenOf(const Game& source) {
+        char buffer[Fen::MAX_LENGTH];
+        return std::string(buffer, Fen::write(source, buffer, sizeof(buffer)));
+    }
+};
+
+// Scenario: A position survives an encode/decode round trip
+TEST_F(PackedPositionSteps, PositionSurvivesRoundTrip) {
+    givenPosition(game, std::string(Fen::START_POSITION));
+
+    PackedPosition packed = whenPositionIsPacked(game);
+    Game restored;
+    ASSERT_TRUE(packed.decode(restored));
+
+    EXPECT_EQ(packed.pieceCount(), 32);
+    EXPECT_EQ(fenOf(restored), fenOf(game));
+}
+
+// Scenario: The position hash is stable across builds
+TEST_F(PackedPositionSteps, PositionHashIsStable) {
+    givenPosition(game, std::string(Fen::START_POSITION));
+
+    PackedPosition packed = whenPositionIsPacked(game);
+
+    // Pinned: changing the key table or code layout invalidates stored caches
+    EXPECT_EQ(packed.hash(), 0x17d3a3b2258dac9aULL);
+    EXPECT_EQ(packed.hash(), Zobrist::hash(game.getBoard(), game.getCurrentPlayer()));
+}
+
+// Scenario: Side to move is part of the encoding
+TEST_F(PackedPositionSteps, SideToMoveIsPartOfEncoding) {
+    Game blackToMove;
+    givenPosition(game, "4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1");
+    givenPosition(blackToMove, "4k4/9/9/9/9/9/9/9/9/4K4 b - - 0 1");
+
+    PackedPosition red = whenPositionIsPacked(game);
+    PackedPosition black = whenPositionIsPacked(blackToMove);
+
+    EXPECT_NE(red, black);
+    EXPECT_NE(red.hash(), black.hash());
+    EXPECT_EQ(black.sideToMove(), Color::BLACK);
+}
+
+// Scenario: A corrupt record is rejected
+TEST_F(PackedPositionSteps, CorruptRecordIsRejected) {
+    givenPosition(game, "4k4/9/9/9/9/9/9/9/9/4K4 w - - 0 1");
+    PackedPosition packed = whenPositionIsPacked(game);
+
+    // Mark a square past the 90th as occupied
+    packed.occupancy[11] |= 0x80;
+
+    Game restored;
+    EXPECT_FALSE(packed.decode(restored));
+}
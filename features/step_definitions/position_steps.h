@@ -0,0 +1,25 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <string_view>
+#include "engine/BoardState.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+
+// A move written in ICCS, e.g. "h2e2"
+inline Move iccs(std::string_view text) {
+    Position from, to;
+    EXPECT_TRUE(Notation::parseIccs(text, from, to));
+    return Move(from, to);
+}
+
+// Fixture base for the engine steps: the position under test as a BoardState
+class PositionSteps : public ::testing::Test {
+protected:
+    BoardState state;
+
+    void givenPosition(std::string_view fen) {
+        Game game;
+        ASSERT_TRUE(Fen::parse(fen, game));
+        state = BoardState::fromGame(game);
+    }
+};
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "engine/MoveGenerator.h"
+#include "engine/Search.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+#include "position_steps.h"
+
+class SearchSteps : public PositionSteps {
+protected:
+    Search search{1};
+    SearchResult result;
+
+    void whenEngineSearches(const SearchLimits& limits) {
+        result = search.run(state, std::vector<std::uint64_t>(), limits);
+    }
+
+    std::uint64_t perft(int depth) {
+        Move moves[MoveGenerator::MAX_MOVES];
+        int count = MoveGenerator::generateLegal(state, moves);
+        if (depth == 1) {
+            return static_cast<std::uint64_t>(count);
+        }
+        std::uint64_t total = 0;
+        for (int i = 0; i < count; ++i) {
+            PieceCode captured = state.makeMove(moves[i]);
+            total += perft(depth - 1);
+            state.unmakeMove(moves[i], captured);
+        }
+        return total;
+    }
+};
+
+// Scenario: Move generation matches the known perft counts
+TEST_F(SearchSteps, MoveGenerationMatchesPerftCounts) {
+    givenPosition(Fen::START_POSITION);
+
+    EXPECT_EQ(perft(1), 44u);
+    EXPECT_EQ(perft(2), 1920u);
+    EXPECT_EQ(perft(3), 79666u);
+}
+
+// Scenario: The search finds a mate in one
+TEST_F(SearchSteps, SearchFindsMateInOne) {
+    givenPosition("3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1");
+    SearchLimits limits;
+    limits.depth = 3;
+
+    whenEngineSearches(limits);
+
+    EXPECT_EQ(result.best, iccs("a4d4"));
+    EXPECT_EQ(result.score, Search::MATE_SCORE - 1);
+}
+
+// Scenario: The search takes undefended material
+TEST_F(SearchSteps, SearchTakesUndefendedMaterial) {
+    givenPosition("3k5/9/9/9/9/4n3R/9/9/9/4K4 w - - 0 1");
+    SearchLimits limits;
+    limits.nodes = 20000;
+
+    whenEngineSearches(limits);
+
+    EXPECT_EQ(result.best, iccs("i4e4"));
+    EXPECT_LE(result.nodes, 20000u);
+}
+
+// Scenario: A mated side has no move
+TEST_F(SearchSteps, MatedSideHasNoMove) {
+    givenPosition("3k5/9/9/9/9/3R5/9/9/9/4K4 b - - 0 1");
+    SearchLimits limits;
+    limits.depth = 3;
+
+    whenEngineSearches(limits);
+
+    EXPECT_TRUE(result.best.isNull());
+    EXPECT_EQ(result.score, -Search::MATE_SCORE);
+}
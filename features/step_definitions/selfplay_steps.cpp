@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "engine/SelfPlay.h"
+#include "engine/Sprt.h"
+
+class SelfPlaySteps : public ::testing::Test {
+protected:
+    Sprt sprt{0.0, 5.0};
+
+    void whenTestEngineScores(int wins, int draws, int losses) {
+        for (int i = 0; i < wins; ++i) {
+            sprt.addWin();
+        }
+        for (int i = 0; i < draws; ++i) {
+            sprt.addDraw();
+        }
+        for (int i = 0; i < losses; ++i) {
+            sprt.addLoss();
+        }
+    }
+
+    SearchLimits depthLimit(int depth) {
+        SearchLimits limits;
+        limits.depth = depth;
+        return limits;
+    }
+};
+
+// Scenario: A clear run of wins accepts the improvement
+TEST_F(SelfPlaySteps, ClearRunOfWinsAcceptsImprovement) {
+    whenTestEngineScores(600, 800, 400);
+
+    EXPECT_EQ(sprt.decision(), Sprt::Decision::ACCEPT_H1);
+    EXPECT_GT(sprt.eloEstimate(), 30.0);
+}
+
+// Scenario: A run of losses rejects the improvement
+TEST_F(SelfPlaySteps, RunOfLossesRejectsImprovement) {
+    whenTestEngineScores(400, 800, 600);
+
+    EXPECT_EQ(sprt.decision(), Sprt::Decision::ACCEPT_H0);
+    EXPECT_LT(sprt.llr(), sprt.lowerBound());
+}
+
+// Scenario: A mate ends the game with a win for the mating side
+TEST_F(SelfPlaySteps, MateEndsGameWithWinForMatingSide) {
+    Game game;
+    Search red(1);
+    Search black(1);
+
+    SelfPlayGame record = SelfPlayRunner::playGame(game, "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1",
+                                                   red, depthLimit(3), black, depthLimit(3), 100);
+
+    EXPECT_EQ(record.result, GameResult::RED_WIN);
+    EXPECT_EQ(record.plies, 1);
+    EXPECT_STREQ(record.reason, "no legal moves");
+    EXPECT_EQ(game.getCurrentPlayer(), Color::BLACK);
+}
+
+// Scenario: A match plays every opening with both colours
+TEST_F(SelfPlaySteps, MatchPlaysEveryOpeningWithBothColours) {
+    std::vector<std::string> openings = SelfPlayRunner::loadOpenings(
+        "# two short openings\n"
+        "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C2C4/9/RNBAKABNR b - - 0 1\n"
+        "\n"
+        "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1\n");
+    ASSERT_EQ(openings.size(), 2u);
+    SelfPlaySettings settings;
+    settings.games = 4;
+    settings.threads = 2;
+    settings.maxPlies = 40;
+    settings.stopOnSprt = false;
+    SelfPlayRunner runner({"test", depthLimit(1), 1}, {"base", depthLimit(1), 1}, settings, openings);
+
+    std::vector<SelfPlayGame> games;
+    Sprt result = runner.run([&](const SelfPlayGame& game, const Sprt&) { games.push_back(game); });
+
+    ASSERT_EQ(games.size(), 4u);
+    EXPECT_EQ(result.games(), 4);
+    int redGamesPerOpening[2] = {0, 0};
+    for (const SelfPlayGame& game : games) {
+        EXPECT_NE(game.result, GameResult::UNKNOWN);
+        redGamesPerOpening[game.opening] += game.testIsRed;
+    }
+    EXPECT_EQ(redGamesPerOpening[0], 1);
+    EXPECT_EQ(redGamesPerOpening[1], 1);
+}
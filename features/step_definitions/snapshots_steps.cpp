@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "engine/LiveGame.h"
+#include "engine/MoveGenerator.h"
+#include "engine/Search.h"
+#include "game/Zobrist.h"
+
+class SnapshotsSteps : public ::testing::Test {
+protected:
+    LiveGame live;
+
+    // First legal move in the current position, played through the live game
+    bool playFirstLegalMove() {
+        BoardState state = live.snapshot()->state;
+        Move moves[MoveGenerator::MAX_MOVES];
+        if (MoveGenerator::generateLegal(state, moves) == 0) {
+            return false;
+        }
+        return live.makeMove(moves[0].fromPosition(), moves[0].toPosition()).isLegal;
+    }
+};
+
+// Scenario: A snapshot does not change when the live game advances
+TEST_F(SnapshotsSteps, SnapshotDoesNotChangeWhenLiveGameAdvances) {
+    SnapshotPtr before = live.snapshot();
+    std::uint64_t initialKey = before->state.key();
+    ASSERT_TRUE(live.makeMove(Position(3, 8), Position(3, 5)).isLegal);
+
+    EXPECT_EQ(before->state.key(), initialKey);
+    EXPECT_EQ(before->state.at(squareIndex(3, 8)), pieceCode(PieceType::CANNON, Color::RED));
+    EXPECT_EQ(before->ply, 0);
+
+    SnapshotPtr after = live.snapshot();
+    EXPECT_EQ(after->ply, 1);
+    EXPECT_EQ(after->lastMove, Move(Position(3, 8), Position(3, 5)));
+    EXPECT_EQ(after->state.at(squareIndex(3, 5)), pieceCode(PieceType::CANNON, Color::RED));
+    EXPECT_EQ(after->state.key(), Zobrist::hash(live.game().getBoard(), live.game().getCurrentPlayer()));
+}
+
+// Scenario: Snapshots share the game history
+TEST_F(SnapshotsSteps, SnapshotsShareTheGameHistory) {
+    std::vector<std::uint64_t> keys;
+    for (int i = 0; i < 3; ++i) {
+        keys.push_back(live.snapshot()->state.key());
+        ASSERT_TRUE(playFirstLegalMove());
+    }
+
+    SnapshotPtr latest = live.snapshot();
+    EXPECT_EQ(latest->historyKeys(), keys);
+    EXPECT_EQ(latest->previous->previous->previous->ply, 0);
+}
+
+// Scenario: An illegal move publishes nothing
+TEST_F(SnapshotsSteps, IllegalMovePublishesNothing) {
+    SnapshotPtr before = live.snapshot();
+    EXPECT_FALSE(live.makeMove(Position(1, 1), Position(5, 1)).isLegal);
+    EXPECT_EQ(live.snapshot(), before);
+}
+
+// Scenario: Analysis threads read snapshots while the game advances
+TEST_F(SnapshotsSteps, AnalysisThreadsReadSnapshotsWhileGameAdvances) {
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::atomic<int> searches{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            Search search(1);
+            SearchLimits limits;
+            limits.depth = 2;
+            while (!done.load()) {
+                SnapshotPtr snapshot = live.snapshot();
+                BoardState rebuilt(snapshot->state.squares(), snapshot->state.sideToMove());
+                if (rebuilt.key() != snapshot->state.key() ||
+                    static_cast<int>(snapshot->historyKeys().size()) != snapshot->ply) {
+                    inconsistent.fetch_add(1);
+                }
+                if (!snapshot->gameOver) {
+                    search.run(snapshot->state, snapshot->historyKeys(), limits);
+                    searches.fetch_add(1);
+                }
+            }
+        });
+    }
+
+    int played = 0;
+    while (played < 30 && playFirstLegalMove()) {
+        ++played;
+        std::this_thread::yield();
+    }
+    done.store(true);
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(played, 30);
+    EXPECT_EQ(live.snapshot()->ply, 30);
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_GT(searches.load(), 0);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "game/Fen.h"
+#include "game/GameDelta.h"
+#include "game/Zobrist.h"
+
+class SpectatorStreamSteps : public ::testing::Test {
+protected:
+    Game game;
+    GameDeltaEncoder encoder;
+    std::string stream;
+    std::vector<std::size_t> frameEnds; // stream length after each update()
+
+    void givenStream(std::string_view fen, int keyframeInterval) {
+        ASSERT_TRUE(Fen::parse(fen, game));
+        encoder = GameDeltaEncoder(keyframeInterval);
+        stream.clear();
+        frameEnds.clear();
+        update();
+    }
+
+    void update() {
+        encoder.update(game, stream);
+        frameEnds.push_back(stream.size());
+    }
+
+    // Deterministic play, cycling through the legal moves
+    void play(int plies) {
+        for (int i = 0; i < plies; ++i) {
+            MoveSpan moves = game.allLegalMoves();
+            ASSERT_FALSE(moves.empty());
+            Move move = moves.begin()[(game.ply() * 5 + 3) % moves.size()];
+            ASSERT_TRUE(game.makeMove(move.fromPosition(), move.toPosition()).isLegal);
+            update();
+        }
+    }
+
+    void thenMatches(const GameDeltaDecoder& spectator, const Game& expected) {
+        ASSERT_TRUE(spectator.synced());
+        EXPECT_EQ(spectator.codes(), expected.getBoard().toCodes());
+        EXPECT_EQ(spectator.sideToMove(), expected.getCurrentPlayer());
+        EXPECT_EQ(spectator.ply(), expected.ply());
+        EXPECT_EQ(spectator.key(), Zobrist::hash(expected.getBoard(), expected.getCurrentPlayer()));
+        EXPECT_EQ(spectator.isGameOver(), expected.isGameOver());
+    }
+
+    // Decodes the whole stream, returning the statuses in order
+    std::vector<GameDeltaDecoder::Status> decodeAll(GameDeltaDecoder& spectator, std::string_view data) {
+        std::vector<GameDeltaDecoder::Status> statuses;
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::size_t consumed = 0;
+            GameDeltaDecoder::Status status = spectator.read(data.substr(offset), consumed);
+            if (status == GameDeltaDecoder::Status::INCOMPLETE) {
+                break;
+            }
+            statuses.push_back(status);
+            offset += consumed;
+        }
+        return statuses;
+    }
+};
+
+// Scenario: Spectators follow a game from deltas and keyframes
+TEST_F(SpectatorStreamSteps, SpectatorsFollowDeltasAndKeyframes) {
+    givenStream(Fen::START_POSITION, 8);
+    GameDeltaDecoder spectator;
+    Game replay;
+    ASSERT_TRUE(Fen::parse(Fen::START_POSITION, replay));
+    std::size_t offset = 0;
+    int keyframes = 0;
+    int deltas = 0;
+    for (int ply = 0; ply <= 30; ++ply) {
+        if (ply > 0) {
+            play(1);
+            Move move = game.historyEntry(ply - 1).move();
+            ASSERT_TRUE(replay.makeMove(move.fromPosition(), move.toPosition()).isLegal);
+        }
+        std::size_t frame = stream.size() - offset;
+        (frame == GameDelta::KEYFRAME_BYTES ? keyframes : deltas) += 1;
+        EXPECT_TRUE(frame == GameDelta::DELTA_BYTES || frame == GameDelta::KEYFRAME_BYTES);
+        std::size_t consumed = 0;
+        ASSERT_EQ(spectator.read(std::string_view(stream).substr(offset), consumed), GameDeltaDecoder::Status::APPLIED);
+        EXPECT_EQ(consumed, frame);
+        offset += consumed;
+        thenMatches(spectator, replay);
+    }
+    EXPECT_EQ(keyframes, 4);
+    EXPECT_EQ(deltas, 27);
+}
+
+// Scenario: A takeback or a new line is sent as a keyframe
+TEST_F(SpectatorStreamSteps, TakebackAndNewLineAreKeyframes) {
+    givenStream(Fen::START_POSITION, GameDeltaEncoder::DEFAULT_KEYFRAME_INTERVAL);
+    play(10);
+    GameDeltaDecoder spectator;
+    decodeAll(spectator, stream);
+    thenMatches(spectator, game);
+
+    std::size_t before = stream.size();
+    ASSERT_TRUE(game.takeback());
+    update();
+    EXPECT_EQ(stream.size() - before, GameDelta::KEYFRAME_BYTES);
+    decodeAll(spectator, std::string_view(stream).substr(before));
+    thenMatches(spectator, game);
+
+    // A different move from ply 9, tried, taken back and replayed: one delta
+    MoveSpan moves = game.allLegalMoves();
+    Move other = moves.begin()[0].bits == game.historyEntry(9).bits ? moves.begin()[1] : moves.begin()[0];
+    ASSERT_TRUE(game.makeMove(other.fromPosition(), other.toPosition()).isLegal);
+    ASSERT_TRUE(game.takeback());
+    ASSERT_TRUE(game.redo());
+    before = stream.size();
+    update();
+    EXPECT_EQ(stream.size() - before, GameDelta::DELTA_BYTES);
+    decodeAll(spectator, std::string_view(stream).substr(before));
+    thenMatches(spectator, game);
+
+    before = stream.size();
+    update();
+    EXPECT_EQ(stream.size(), before); // nothing changed
+}
+
+// Scenario: A damaged delta is detected and the next keyframe resynchronises
+TEST_F(SpectatorStreamSteps, DamagedDeltaIsDetectedAndKeyframeResyncs) {
+    givenStream(Fen::START_POSITION, 8);
+    play(12);
+    // Ply 3's delta starts where ply 2's frame ends; its key is bytes 3-6
+    std::string damaged = stream;
+    damaged[frameEnds[2] + 4] ^= 0x40;
+
+    GameDeltaDecoder spectator;
+    std::vector<GameDeltaDecoder::Status> statuses = decodeAll(spectator, damaged);
+    ASSERT_EQ(statuses.size(), 13u);
+    EXPECT_EQ(statuses[2], GameDeltaDecoder::Status::APPLIED);
+    EXPECT_EQ(statuses[3], GameDeltaDecoder::Status::CORRUPT);
+    for (int ply = 4; ply < 8; ++ply) {
+        EXPECT_EQ(statuses[ply], GameDeltaDecoder::Status::NEEDS_KEYFRAME) << "ply " << ply;
+    }
+    for (int ply = 8; ply <= 12; ++ply) {
+        EXPECT_EQ(statuses[ply], GameDeltaDecoder::Status::APPLIED) << "ply " << ply;
+    }
+    EXPECT_EQ(damaged.size() - frameEnds[7], GameDelta::KEYFRAME_BYTES + 4 * GameDelta::DELTA_BYTES);
+    thenMatches(spectator, game);
+}
+
+// Scenario: A spectator joining mid-game starts from a keyframe
+TEST_F(SpectatorStreamSteps, LateSpectatorStartsFromKeyframe) {
+    givenStream(Fen::START_POSITION, GameDeltaEncoder::DEFAULT_KEYFRAME_INTERVAL);
+    play(15);
+    std::string joining;
+    ASSERT_EQ(GameDeltaEncoder::writeKeyframe(game, joining), GameDelta::KEYFRAME_BYTES);
+    GameDeltaDecoder spectator;
+    decodeAll(spectator, joining);
+    thenMatches(spectator, game);
+
+    for (int i = 0; i < 5; ++i) {
+        std::size_t before = stream.size();
+        play(1);
+        decodeAll(spectator, std::string_view(stream).substr(before));
+        thenMatches(spectator, game);
+    }
+}
+
+// Scenario: The capture of a General ends the game for spectators
+TEST_F(SpectatorStreamSteps, GeneralCaptureEndsGameForSpectators) {
+    givenStream("4k4/9/9/9/9/9/9/9/4R4/3K5 w - - 0 1", GameDeltaEncoder::DEFAULT_KEYFRAME_INTERVAL);
+    GameDeltaDecoder spectator;
+    decodeAll(spectator, stream);
+    std::size_t before = stream.size();
+    ASSERT_TRUE(game.makeMove(Position(2, 5), Position(10, 5)).gameEnded);
+    update();
+    ASSERT_EQ(stream.size() - before, GameDelta::DELTA_BYTES);
+    EXPECT_NE(stream[before] & GameDelta::GAME_OVER_FLAG, 0);
+    decodeAll(spectator, std::string_view(stream).substr(before));
+    thenMatches(spectator, game);
+    EXPECT_TRUE(spectator.isGameOver());
+    EXPECT_EQ(spectator.winner(), Color::RED);
+}
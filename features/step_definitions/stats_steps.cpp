@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "diagnostics/Stats.h"
+#include "engine/Search.h"
+#include "game/Fen.h"
+
+class StatsSteps : public ::testing::Test {
+protected:
+    Game game;
+
+    void SetUp() override {
+        ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+    }
+
+    void thenRejectedBecause(const Position& from, const Position& to, MoveRejection reason) {
+        MoveResult result = game.makeMove(from, to);
+        EXPECT_FALSE(result.isLegal);
+        EXPECT_EQ(result.rejection, reason) << moveRejectionName(result.rejection);
+    }
+};
+
+// Scenario Outline: Rejected moves report why they were rejected
+TEST_F(StatsSteps, RejectedMovesReportWhy) {
+    thenRejectedBecause(Position(5, 5), Position(6, 5), MoveRejection::NO_PIECE);
+    thenRejectedBecause(Position(10, 1), Position(9, 1), MoveRejection::WRONG_COLOR);
+    thenRejectedBecause(Position(1, 1), Position(2, 2), MoveRejection::GEOMETRY);
+    thenRejectedBecause(Position(1, 1), Position(1, 2), MoveRejection::OWN_PIECE);
+    thenRejectedBecause(Position(1, 1), Position(5, 1), MoveRejection::BLOCKED_PATH);
+    thenRejectedBecause(Position(3, 2), Position(8, 2), MoveRejection::CANNON_SCREEN);
+    thenRejectedBecause(Position(1, 2), Position(2, 4), MoveRejection::HORSE_LEG);
+    EXPECT_STREQ(moveRejectionName(MoveRejection::HORSE_LEG), "horse leg");
+}
+
+// Scenario: makeMove calls are counted by rejection reason
+TEST_F(StatsSteps, MakeMoveCallsAreCountedByRejectionReason) {
+    StatsSnapshot before = Stats::snapshot();
+
+    game.makeMove(Position(1, 1), Position(5, 1));
+    game.makeMove(Position(1, 9), Position(5, 9));
+    EXPECT_TRUE(game.makeMove(Position(3, 8), Position(3, 5)).isLegal);
+
+    StatsSnapshot delta = Stats::snapshot() - before;
+    std::uint64_t expectedCalls = Stats::ENABLED ? 3 : 0;
+    std::uint64_t expectedBlocked = Stats::ENABLED ? 2 : 0;
+    EXPECT_EQ(delta.counter(StatCounter::MAKE_MOVE_CALLS), expectedCalls);
+    EXPECT_EQ(delta.rejection(MoveRejection::BLOCKED_PATH), expectedBlocked);
+}
+
+// Scenario: A snapshot is taken while the search keeps running
+TEST_F(StatsSteps, SnapshotIsTakenWhileSearchKeepsRunning) {
+    Search search(1);
+    SearchLimits limits;
+    limits.infinite = true;
+    BoardState state = BoardState::fromGame(game);
+    std::thread worker([&]() { search.run(state, std::vector<std::uint64_t>(), limits); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    StatsSnapshot first = Stats::snapshot();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    StatsSnapshot second = Stats::snapshot();
+    search.stop();
+    worker.join();
+
+    if (Stats::ENABLED) {
+        EXPECT_GT(second.counter(StatCounter::NODES), first.counter(StatCounter::NODES));
+    } else {
+        EXPECT_EQ(second.counter(StatCounter::NODES), 0u);
+    }
+}
+
+// Scenario: Beta cutoffs are broken down by move index
+TEST_F(StatsSteps, BetaCutoffsAreBrokenDownByMoveIndex) {
+    Search search(1);
+    SearchLimits limits;
+    limits.depth = 5;
+    StatsSnapshot before = Stats::snapshot();
+
+    search.run(BoardState::fromGame(game), std::vector<std::uint64_t>(), limits);
+
+    StatsSnapshot delta = Stats::snapshot() - before;
+    std::uint64_t byIndex = 0;
+    for (std::uint64_t count : delta.cutoffsByMoveIndex) {
+        byIndex += count;
+    }
+    EXPECT_EQ(byIndex, delta.counter(StatCounter::BETA_CUTOFFS));
+    if (Stats::ENABLED) {
+        EXPECT_GT(delta.cutoffsByMoveIndex[0] * 2, byIndex);
+        EXPECT_GT(delta.counter(StatCounter::TT_HITS), 0u);
+    }
+}
+
+// Scenario: Per-node phases are sampled and still add up within the search time
+TEST_F(StatsSteps, PerNodePhasesAreSampledWithinSearchTime) {
+    Search search(1);
+    SearchLimits limits;
+    limits.depth = 5;
+    StatsSnapshot before = Stats::snapshot();
+
+    search.run(BoardState::fromGame(game), std::vector<std::uint64_t>(), limits);
+
+    StatsSnapshot delta = Stats::snapshot() - before;
+    if (Stats::ENABLED) {
+        // Thousands of calls, so a 1-in-64 sample still lands on some of each
+        EXPECT_GT(delta.phaseNs(StatPhase::EVALUATION), 0u);
+        EXPECT_GT(delta.phaseNs(StatPhase::MOVE_GENERATION), 0u);
+        EXPECT_LT(delta.phaseNs(StatPhase::EVALUATION) + delta.phaseNs(StatPhase::MOVE_GENERATION),
+                  delta.phaseNs(StatPhase::SEARCH) * 2);
+    } else {
+        EXPECT_EQ(delta.phaseNs(StatPhase::SEARCH), 0u);
+    }
+}
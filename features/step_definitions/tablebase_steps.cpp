@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include "engine/MoveGenerator.h"
+#include "engine/Tablebase.h"
+#include "game/Fen.h"
+#include "game/Notation.h"
+
+class TablebaseSteps : public ::testing::Test {
+protected:
+    Tablebase tablebase;
+    BoardState state;
+    TablebaseResult result;
+
+    void SetUp() override {
+        givenTablebasesGeneratedFor("KRvK");
+    }
+
+    void givenTablebasesGeneratedFor(std::string_view name) {
+        TablebaseMaterial material;
+        ASSERT_TRUE(TablebaseMaterial::parse(name, material));
+        ASSERT_TRUE(tablebase.generate(material, 2));
+    }
+
+    void whenPositionIsProbed(std::string_view fen, const Tablebase& source) {
+        Game game;
+        ASSERT_TRUE(Fen::parse(fen, game));
+        state = BoardState::fromGame(game);
+        result = source.probe(state);
+    }
+
+    void whenMoveIsPlayed(std::string_view iccs, const Tablebase& source) {
+        Position from, to;
+        ASSERT_TRUE(Notation::parseIccs(iccs, from, to));
+        ASSERT_TRUE(MoveGenerator::isLegal(state, Move(from, to)));
+        state.makeMove(Move(from, to));
+        result = source.probe(state);
+    }
+
+    void thenResultIs(Wdl wdl, int plies) {
+        ASSERT_TRUE(result.found);
+        EXPECT_EQ(result.wdl, wdl);
+        EXPECT_EQ(result.pliesToMate, plies);
+    }
+};
+
+// Scenario: Bare Generals are drawn
+TEST_F(TablebaseSteps, BareGeneralsAreDrawn) {
+    whenPositionIsProbed("4k4/9/9/9/9/9/9/9/9/3K5 w - - 0 1", tablebase);
+
+    thenResultIs(Wdl::DRAW, 0);
+    EXPECT_TRUE(tablebase.probeWdl(state).found);
+    EXPECT_EQ(tablebase.probeWdl(state).wdl, Wdl::DRAW);
+}
+
+// Scenario: A Rook mates a lone General
+TEST_F(TablebaseSteps, RookMatesLoneGeneral) {
+    whenPositionIsProbed("3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1", tablebase);
+    thenResultIs(Wdl::WIN, 1);
+
+    whenMoveIsPlayed("a4d4", tablebase);
+    thenResultIs(Wdl::LOSS, 0);
+}
+
+// Scenario: Tables written to disk are mapped back unchanged
+TEST_F(TablebaseSteps, TablesWrittenToDiskAreMappedBackUnchanged) {
+    std::filesystem::path directory = std::filesystem::path(::testing::TempDir()) / "tablebase_steps";
+    std::filesystem::create_directories(directory);
+    ASSERT_TRUE(tablebase.write(directory.string()));
+
+    Tablebase loaded;
+    EXPECT_EQ(loaded.loadDirectory(directory.string()), 2);
+
+    const char* fens[] = {
+        "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1",
+        "3k5/9/9/9/9/R8/9/9/9/4K4 b - - 0 1",
+        "4k4/9/9/9/9/9/9/9/9/4KR3 w - - 0 1",
+        "5k3/9/9/4R4/9/9/9/9/4K4/9 b - - 0 1",
+        "4k4/9/9/9/9/9/9/9/9/3K5 w - - 0 1",
+    };
+    for (const char* fen : fens) {
+        whenPositionIsProbed(fen, tablebase);
+        TablebaseResult generated = result;
+        whenPositionIsProbed(fen, loaded);
+        EXPECT_EQ(result.found, generated.found) << fen;
+        EXPECT_EQ(result.wdl, generated.wdl) << fen;
+        EXPECT_EQ(result.pliesToMate, generated.pliesToMate) << fen;
+        EXPECT_EQ(loaded.probeWdl(state).wdl, generated.wdl) << fen;
+    }
+    std::filesystem::remove_all(directory);
+}
+
+// Scenario: Black's material uses the colour-mirrored table
+TEST_F(TablebaseSteps, BlackMaterialUsesMirroredTable) {
+    whenPositionIsProbed("4k4/9/9/9/r8/9/9/9/9/3K5 b - - 0 1", tablebase);
+
+    thenResultIs(Wdl::WIN, 1);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "engine/TimeManager.h"
+
+class TimeManagementSteps : public ::testing::Test {
+protected:
+    TimeManager time;
+
+    void givenClock(std::int64_t remainingMs, std::int64_t incrementMs, int movesToGo) {
+        ClockState clock;
+        clock.remainingMs = remainingMs;
+        clock.incrementMs = incrementMs;
+        clock.movesToGo = movesToGo;
+        time.start(0, clock);
+    }
+};
+
+// Scenario: Sudden death spends a small share of the clock
+TEST_F(TimeManagementSteps, SuddenDeathSpendsSmallShare) {
+    givenClock(60000, 0, 0);
+
+    EXPECT_GE(time.softMs(), 1500);
+    EXPECT_LE(time.softMs(), 2500);
+    EXPECT_GT(time.hardMs(), time.softMs());
+    EXPECT_LE(time.hardMs(), 8000);
+}
+
+// Scenario: The last move before the time control keeps a reserve
+TEST_F(TimeManagementSteps, LastMoveBeforeControlKeepsReserve) {
+    givenClock(10000, 0, 1);
+
+    EXPECT_GT(time.softMs(), 5000);
+    EXPECT_LT(time.hardMs(), 9000);
+}
+
+// Scenario: A stable best move cuts the budget and a score drop extends it
+TEST_F(TimeManagementSteps, StableMoveCutsBudgetAndScoreDropExtendsIt) {
+    givenClock(60000, 0, 0);
+    Move best(10, 20);
+
+    for (int depth = 1; depth <= 5; ++depth) {
+        time.shouldStop(depth, best, 50);
+    }
+    EXPECT_LT(time.targetMs(), time.softMs());
+
+    time.shouldStop(6, Move(30, 40), -20);
+    EXPECT_GT(time.targetMs(), time.softMs());
+    EXPECT_LE(time.targetMs(), time.hardMs());
+}
+
+// Scenario: The clock is only read once per node check interval
+TEST_F(TimeManagementSteps, ClockIsOnlyReadEveryCheckInterval) {
+    time.start(1, ClockState());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    EXPECT_FALSE(time.hardDeadlineReached(1));
+    EXPECT_FALSE(time.hardDeadlineReached(TimeManager::CHECK_INTERVAL - 1));
+    EXPECT_TRUE(time.hardDeadlineReached(TimeManager::CHECK_INTERVAL));
+}
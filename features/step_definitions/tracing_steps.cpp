@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "diagnostics/Trace.h"
+#include "engine/Search.h"
+#include "game/Fen.h"
+
+class TracingSteps : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Trace::start();
+    }
+
+    void TearDown() override {
+        Trace::stop();
+    }
+
+    static std::string traceJson() {
+        std::ostringstream out;
+        Trace::writeJson(out);
+        return out.str();
+    }
+
+    static int countOf(const std::string& text, const std::string& needle) {
+        int count = 0;
+        for (std::size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+
+    static std::string threadIdOf(const std::string& json, const std::string& name) {
+        std::size_t event = json.find("\"name\":\"" + name + "\"");
+        if (event == std::string::npos) {
+            return "";
+        }
+        std::size_t tid = json.find("\"tid\":", event) + 6;
+        return json.substr(tid, json.find(',', tid) - tid);
+    }
+};
+
+// Scenario: Spans are written as Chrome complete events
+TEST_F(TracingSteps, SpansAreWrittenAsChromeCompleteEvents) {
+    {
+        TraceSpan span("unit span", "value", 7);
+    }
+    Trace::stop();
+    {
+        TraceSpan span("after stop");
+    }
+
+    std::string json = traceJson();
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(countOf(json, "\"name\":\"unit span\""), 1);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("\"args\":{\"value\":7}"), std::string::npos);
+    EXPECT_EQ(json.find("after stop"), std::string::npos);
+}
+
+// Scenario: Spans from concurrent threads land on separate tracks
+TEST_F(TracingSteps, SpansFromConcurrentThreadsLandOnSeparateTracks) {
+    std::atomic<int> arrived{0};
+    auto worker = [&arrived](const char* name) {
+        {
+            TraceSpan span(name);
+        }
+        // Keep the thread, and so its ring, alive until both have recorded
+        arrived.fetch_add(1);
+        while (arrived.load() < 2) {
+            std::this_thread::yield();
+        }
+    };
+    std::thread first(worker, "first thread");
+    std::thread second(worker, "second thread");
+    first.join();
+    second.join();
+
+    std::string json = traceJson();
+    std::string firstId = threadIdOf(json, "first thread");
+    std::string secondId = threadIdOf(json, "second thread");
+    ASSERT_FALSE(firstId.empty());
+    ASSERT_FALSE(secondId.empty());
+    EXPECT_NE(firstId, secondId);
+}
+
+// Scenario: The ring buffer keeps the newest spans
+TEST_F(TracingSteps, RingBufferKeepsTheNewestSpans) {
+    const std::int64_t total = static_cast<std::int64_t>(Trace::RING_SIZE) + 10;
+    for (std::int64_t i = 0; i < total; ++i) {
+        TraceSpan span("ring span", "i", i);
+    }
+
+    std::string json = traceJson();
+    // The slot the writer would fill next is never trusted, so a full ring shows one fewer
+    EXPECT_EQ(countOf(json, "\"name\":\"ring span\""), static_cast<int>(Trace::RING_SIZE) - 1);
+    EXPECT_EQ(json.find("{\"i\":10}"), std::string::npos);
+    EXPECT_NE(json.find("{\"i\":11}"), std::string::npos);
+    EXPECT_NE(json.find("{\"i\":" + std::to_string(total - 1) + "}"), std::string::npos);
+}
+
+// Scenario: A search records one span per iteration
+TEST_F(TracingSteps, SearchRecordsOneSpanPerIteration) {
+    Game game;
+    ASSERT_TRUE(Fen::parse(Fen::START_POSITION, game));
+    Search search(1);
+    SearchLimits limits;
+    limits.depth = 3;
+    search.run(BoardState::fromGame(game), std::vector<std::uint64_t>(), limits);
+
+    std::string json = traceJson();
+    int expected = Trace::ENABLED ? 3 : 0;
+    EXPECT_EQ(countOf(json, "\"name\":\"search iteration\""), expected);
+    if (Trace::ENABLED) {
+        EXPECT_NE(json.find("\"args\":{\"depth\":3}"), std::string::npos);
+        EXPECT_GT(countOf(json, "\"name\":\"root move\""), 0);
+    }
+}
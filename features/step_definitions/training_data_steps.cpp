@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine/MoveGenerator.h"
+#include "engine/TrainingGenerator.h"
+#include "game/Fen.h"
+
+class TrainingDataSteps : public ::testing::Test {
+protected:
+    std::string path;
+    TrainingDataWriter writer;
+
+    void SetUp() override {
+        path = ::testing::TempDir() + "training_data_steps.bin";
+        std::remove(path.c_str());
+    }
+
+    void TearDown() override {
+        writer.close();
+        std::remove(path.c_str());
+    }
+
+    // Positions from the start position with distinct, checkable fields
+    static TrainingRecord makeRecord(int thread, int index) {
+        static PackedPosition start = [] {
+            Game game;
+            Fen::parse(Fen::START_POSITION, game);
+            PackedPosition packed;
+            PackedPosition::encode(game, packed);
+            return packed;
+        }();
+        TrainingRecord record{};
+        record.position = start;
+        record.score = static_cast<std::int16_t>(index % 30000);
+        record.move = static_cast<std::uint16_t>(index / 30000 + 1);
+        record.result = static_cast<std::int8_t>(index % 3 - 1);
+        record.reserved[0] = static_cast<std::uint8_t>(thread);
+        return record;
+    }
+
+    void whenRecordsAreWritten(int count) {
+        TrainingDataWriter::Buffer buffer(writer);
+        for (int i = 0; i < count; ++i) {
+            buffer.add(makeRecord(0, i));
+        }
+    }
+
+    void thenReaderReturnsSameRecords(int count) {
+        TrainingDataReader reader;
+        ASSERT_TRUE(reader.open(path));
+        TrainingRecord record;
+        int read = 0;
+        while (reader.next(record)) {
+            TrainingRecord expected = makeRecord(0, read);
+            ASSERT_EQ(record.position, expected.position);
+            ASSERT_EQ(record.score, expected.score) << "record " << read;
+            ASSERT_EQ(record.move, expected.move);
+            ASSERT_EQ(record.result, expected.result);
+            ++read;
+        }
+        EXPECT_FALSE(reader.corrupt());
+        EXPECT_EQ(read, count);
+    }
+};
+
+// Scenario: Records written uncompressed are read back in order
+TEST_F(TrainingDataSteps, UncompressedRecordsRoundTrip) {
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::NONE));
+    whenRecordsAreWritten(20000);
+    ASSERT_TRUE(writer.close());
+    EXPECT_EQ(writer.recordsWritten(), 20000u);
+    EXPECT_EQ(std::filesystem::file_size(path), writer.bytesWritten());
+    thenReaderReturnsSameRecords(20000);
+}
+
+// Scenario: Compressed chunks are smaller and read back the same
+TEST_F(TrainingDataSteps, CompressedRecordsRoundTrip) {
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::ZLIB));
+    if (!TrainingDataWriter::ZLIB_AVAILABLE) {
+        EXPECT_EQ(writer.compression(), TrainingDataWriter::NONE);
+    }
+    whenRecordsAreWritten(20000);
+    ASSERT_TRUE(writer.close());
+    if (TrainingDataWriter::ZLIB_AVAILABLE) {
+        EXPECT_LT(std::filesystem::file_size(path), 20000 * sizeof(TrainingRecord) / 2);
+    }
+    thenReaderReturnsSameRecords(20000);
+}
+
+// Scenario: Several threads append whole chunks without losing records
+TEST_F(TrainingDataSteps, ThreadBuffersAppendWholeChunks) {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 10000;
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::NONE));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([this, t] {
+            TrainingDataWriter::Buffer buffer(writer);
+            for (int i = 0; i < PER_THREAD; ++i) {
+                buffer.add(makeRecord(t, i));
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    ASSERT_TRUE(writer.close());
+
+    TrainingDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    int nextIndex[THREADS] = {};
+    TrainingRecord record;
+    int read = 0;
+    while (reader.next(record)) {
+        int thread = record.reserved[0];
+        ASSERT_LT(thread, THREADS);
+        TrainingRecord expected = makeRecord(thread, nextIndex[thread]++);
+        ASSERT_EQ(record.score, expected.score);
+        ASSERT_EQ(record.move, expected.move);
+        ++read;
+    }
+    EXPECT_FALSE(reader.corrupt());
+    EXPECT_EQ(read, THREADS * PER_THREAD);
+    for (int count : nextIndex) {
+        EXPECT_EQ(count, PER_THREAD);
+    }
+}
+
+// Scenario: Generated records are legal positions labelled from the mover's side
+TEST_F(TrainingDataSteps, GeneratedRecordsAreLegalAndLabelled) {
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::ZLIB));
+    TrainingSettings settings;
+    settings.games = 2;
+    settings.threads = 2;
+    settings.nodes = 300;
+    settings.maxPlies = 60;
+    settings.hashMegabytes = 1;
+    TrainingGenerator generator(settings, {});
+    std::vector<TrainingGame> games;
+    std::uint64_t positions = generator.run(writer, [&games](const TrainingGame& game) { games.push_back(game); });
+    ASSERT_TRUE(writer.close());
+    ASSERT_EQ(games.size(), 2u);
+    EXPECT_EQ(positions, static_cast<std::uint64_t>(games[0].positions + games[1].positions));
+    EXPECT_GT(positions, 0u);
+
+    TrainingDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    TrainingRecord record;
+    std::uint64_t read = 0;
+    while (reader.next(record)) {
+        Game game;
+        ASSERT_TRUE(record.position.decode(game));
+        BoardState state = BoardState::fromGame(game);
+        EXPECT_TRUE(MoveGenerator::isLegal(state, Move(record.move))) << "record " << read;
+        EXPECT_GE(record.result, -1);
+        EXPECT_LE(record.result, 1);
+        ++read;
+    }
+    EXPECT_FALSE(reader.corrupt());
+    EXPECT_EQ(read, positions);
+}
+
+// Scenario: Generated records are legal positions labelled from the mover's side
+TEST_F(TrainingDataSteps, ResultsFollowTheSideToMove) {
+    Game game;
+    Search search(1);
+    TrainingSettings settings;
+    settings.nodes = 300;
+    settings.maxPlies = 60;
+    std::uint64_t random = settings.seed;
+    std::vector<TrainingRecord> records;
+    TrainingGame played = TrainingGenerator::playGame(game, Fen::START_POSITION, search, settings, random, records);
+    ASSERT_EQ(static_cast<int>(records.size()), played.positions);
+    ASSERT_FALSE(records.empty());
+
+    for (const TrainingRecord& record : records) {
+        int expected = 0;
+        if (played.result == GameResult::RED_WIN) {
+            expected = record.position.sideToMove() == Color::RED ? 1 : -1;
+        } else if (played.result == GameResult::BLACK_WIN) {
+            expected = record.position.sideToMove() == Color::BLACK ? 1 : -1;
+        }
+        EXPECT_EQ(record.result, expected);
+    }
+    // Consecutive records alternate sides
+    for (std::size_t i = 1; i < records.size(); ++i) {
+        EXPECT_NE(records[i].position.sideToMove(), records[i - 1].position.sideToMove());
+    }
+}
+
+// Scenario: A truncated chunk is reported as corrupt
+TEST_F(TrainingDataSteps, TruncatedChunkIsCorrupt) {
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::NONE));
+    whenRecordsAreWritten(10000);
+    ASSERT_TRUE(writer.close());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+
+    TrainingDataReader reader;
+    ASSERT_TRUE(reader.open(path));
+    TrainingRecord record;
+    std::size_t read = 0;
+    while (reader.next(record)) {
+        ++read;
+    }
+    EXPECT_EQ(read, TrainingDataWriter::CHUNK_RECORDS);
+    EXPECT_TRUE(reader.corrupt());
+}
+
+// Scenario: A chunk header with an impossible record count is reported as corrupt
+TEST_F(TrainingDataSteps, ImpossibleRecordCountIsCorrupt) {
+    ASSERT_TRUE(writer.open(path, TrainingDataWriter::NONE));
+    ASSERT_TRUE(writer.close());
+    for (std::uint32_t recordCount : {0xFFFFFFFFu, static_cast<std::uint32_t>(TrainingDataWriter::CHUNK_RECORDS + 1)}) {
+        std::filesystem::resize_file(path, 16);
+        {
+            TrainingChunkHeader header{recordCount, 4, TrainingDataWriter::NONE, 0};
+            std::ofstream out(path, std::ios::binary | std::ios::app);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write("abcd", 4);
+        }
+        ASSERT_EQ(std::filesystem::file_size(path), 36u);
+
+        TrainingDataReader reader;
+        ASSERT_TRUE(reader.open(path));
+        TrainingRecord record;
+        EXPECT_FALSE(reader.next(record));
+        EXPECT_TRUE(reader.corrupt());
+        EXPECT_FALSE(reader.next(record));
+    }
+}
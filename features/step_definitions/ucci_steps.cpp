@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "engine/UcciEngine.h"
+#include "game/Notation.h"
+
+class UcciSteps : public ::testing::Test {
+protected:
+    std::mutex mutex;
+    std::vector<std::string> lines;
+    UcciEngine engine{[this](std::string_view line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.emplace_back(line);
+    }};
+
+    void whenServerSends(std::string_view command) {
+        EXPECT_TRUE(engine.handleCommand(command));
+    }
+
+    int countLines(std::string_view prefix) {
+        std::lock_guard<std::mutex> lock(mutex);
+        int count = 0;
+        for (const std::string& line : lines) {
+            count += line.rfind(prefix, 0) == 0;
+        }
+        return count;
+    }
+
+    std::string lastLine(std::string_view prefix) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = lines.rbegin(); it != lines.rend(); ++it) {
+            if (it->rfind(prefix, 0) == 0) {
+                return *it;
+            }
+        }
+        return "";
+    }
+
+    // Polls until the search thread has printed bestmove (or gives up)
+    bool waitForBestMove() {
+        for (int i = 0; i < 500 && countLines("bestmove") == 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return countLines("bestmove") > 0;
+    }
+};
+
+// Scenario: The engine identifies itself and answers isready
+TEST_F(UcciSteps, EngineIdentifiesItselfAndAnswersIsReady) {
+    whenServerSends("ucci");
+    whenServerSends("isready");
+
+    EXPECT_EQ(countLines("id name"), 1);
+    EXPECT_EQ(countLines("ucciok"), 1);
+    EXPECT_EQ(lines.back(), "readyok");
+}
+
+// Scenario: Position moves are applied to the game before searching
+TEST_F(UcciSteps, PositionMovesAreAppliedBeforeSearching) {
+    whenServerSends("position startpos moves h2e2 h9g7");
+    whenServerSends("go depth 3");
+
+    EXPECT_EQ(engine.game().getCurrentPlayer(), Color::RED);
+    ASSERT_TRUE(waitForBestMove());
+    EXPECT_GE(countLines("info depth"), 3);
+
+    std::string best = lastLine("bestmove").substr(9, 4);
+    Position from, to;
+    ASSERT_TRUE(Notation::parseIccs(best, from, to));
+    EXPECT_TRUE(engine.game().isMoveLegal(from, to));
+}
+
+// Scenario: An infinite search keeps answering until it is stopped
+TEST_F(UcciSteps, InfiniteSearchKeepsAnsweringUntilStopped) {
+    whenServerSends("go infinite");
+    whenServerSends("isready");
+
+    EXPECT_EQ(countLines("readyok"), 1);
+    EXPECT_EQ(countLines("bestmove"), 0);
+    EXPECT_TRUE(engine.isSearching());
+
+    whenServerSends("stop");
+    EXPECT_EQ(countLines("bestmove"), 1);
+    EXPECT_FALSE(engine.isSearching());
+}
+
+// Scenario: A ponder search only reports its move after ponderhit
+TEST_F(UcciSteps, PonderSearchReportsAfterPonderHit) {
+    whenServerSends("position startpos moves h2e2");
+    whenServerSends("go ponder depth 2");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_EQ(countLines("bestmove"), 0);
+
+    whenServerSends("ponderhit");
+    EXPECT_TRUE(waitForBestMove());
+    EXPECT_EQ(countLines("bestmove"), 1);
+}
+
+// Scenario: An illegal move in the list leaves the position before the moves
+TEST_F(UcciSteps, IllegalPositionMoveLeavesThePositionBeforeTheMoves) {
+    whenServerSends("position startpos moves h2e2 h9g7 a0a5");
+
+    EXPECT_EQ(lastLine("info string"), "info string invalid position");
+    EXPECT_EQ(engine.game().ply(), 0);
+    EXPECT_EQ(engine.game().getCurrentPlayer(), Color::RED);
+    Position from, to;
+    ASSERT_TRUE(Notation::parseIccs("h2e2", from, to));
+    EXPECT_TRUE(engine.game().isMoveLegal(from, to));
+}
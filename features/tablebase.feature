@@ -0,0 +1,28 @@
+Feature: Endgame tablebases
+  As an engine
+  I want perfect play in positions with few pieces left
+  So that won endgames are converted and drawn ones are not overpressed
+
+  Background:
+    Given tablebases generated for "KRvK"
+
+  @Tablebase
+  Scenario: Bare Generals are drawn
+    When the position "4k4/9/9/9/9/9/9/9/9/3K5 w - - 0 1" is probed
+    Then the tablebase reports a draw
+
+  @Tablebase
+  Scenario: A Rook mates a lone General
+    When the position "3k5/9/9/9/9/R8/9/9/9/4K4 w - - 0 1" is probed
+    Then the tablebase reports a win in 1 ply
+    And after "a4d4" the tablebase reports a loss in 0 plies
+
+  @Tablebase
+  Scenario: Tables written to disk are mapped back unchanged
+    When the tables are written and loaded from a directory
+    Then every probe answers as the generated tables did
+
+  @Tablebase
+  Scenario: Black's material uses the colour-mirrored table
+    When the position "4k4/9/9/9/r8/9/9/9/9/3K5 b - - 0 1" is probed
+    Then the tablebase reports a win in 1 ply
@@ -0,0 +1,30 @@
+Feature: Search time management
+  As a bot on a blitz server
+  I want each move to get a share of the clock that fits the time control
+  So that the engine neither flags nor wastes its time
+
+  @TimeManagement
+  Scenario: Sudden death spends a small share of the clock
+    Given 60 seconds left and no increment
+    When the move budget is computed
+    Then the soft deadline is about 2 seconds and the hard one at most 8 seconds
+
+  @TimeManagement
+  Scenario: The last move before the time control keeps a reserve
+    Given 10 seconds left with 1 move to go
+    When the move budget is computed
+    Then the hard deadline stays below 9 seconds
+
+  @TimeManagement
+  Scenario: A stable best move cuts the budget and a score drop extends it
+    Given 60 seconds left and no increment
+    When the same best move is found for 5 iterations
+    Then the target falls below the soft deadline
+    When the best move changes and the score drops
+    Then the target rises above the soft deadline
+
+  @TimeManagement
+  Scenario: The clock is only read once per node check interval
+    Given a fixed move time of 1 millisecond that has already passed
+    Then the hard deadline is not noticed before the node check interval
+    And it is noticed at the node check interval
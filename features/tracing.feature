@@ -0,0 +1,28 @@
+Feature: Chrome trace output
+  As an engine developer
+  I want scoped spans written in the Chrome trace-event format
+  So that stalls across threads show up on a timeline in chrome://tracing or Perfetto
+
+  @Trace
+  Scenario: Spans are written as Chrome complete events
+    Given tracing has started
+    When a span with an argument closes and another closes after tracing stops
+    Then the trace JSON holds one complete event with its argument
+
+  @Trace
+  Scenario: Spans from concurrent threads land on separate tracks
+    Given tracing has started
+    When two threads each close a span while both are running
+    Then the two events carry different thread ids
+
+  @Trace
+  Scenario: The ring buffer keeps the newest spans
+    Given tracing has started
+    When more spans close on one thread than its ring holds
+    Then the oldest spans are dropped and the newest are written
+
+  @Trace
+  Scenario: A search records one span per iteration
+    Given tracing has started
+    When a 3-ply search runs
+    Then the trace holds "search iteration" spans for depths 1 to 3 when tracing is compiled in
@@ -0,0 +1,42 @@
+Feature: Self-play training data
+  As the evaluation tuner
+  I want self-play positions streamed to a compact binary file
+  So that millions of labelled positions can be generated and read back cheaply
+
+  @TrainingData
+  Scenario: Records written uncompressed are read back in order
+    Given a training file opened without compression
+    When 20000 records are written through one buffer
+    Then the reader returns the same 20000 records in order
+
+  @TrainingData
+  Scenario: Compressed chunks are smaller and read back the same
+    Given a training file opened with zlib compression
+    When 20000 records are written through one buffer
+    Then the file is smaller than the uncompressed records
+    And the reader returns the same 20000 records in order
+
+  @TrainingData
+  Scenario: Several threads append whole chunks without losing records
+    Given a training file opened without compression
+    When 4 threads each write 10000 records through their own buffer
+    Then the reader returns all 40000 records, each thread's records in order
+
+  @TrainingData
+  Scenario: Generated records are legal positions labelled from the mover's side
+    Given a training file opened with zlib compression
+    When 2 games are generated at 300 nodes per move on 2 threads
+    Then every record decodes to a position where its move is legal
+    And every record's result agrees with its game's result from the side to move
+
+  @TrainingData
+  Scenario: A truncated chunk is reported as corrupt
+    Given a training file with 10000 records written uncompressed
+    When the last 100 bytes are cut off
+    Then the reader stops after the first chunk and reports the file as corrupt
+
+  @TrainingData
+  Scenario: A chunk header with an impossible record count is reported as corrupt
+    Given a training file whose only chunk claims 4294967295 records in 4 bytes
+    When it is read
+    Then no record is returned and the file is reported as corrupt
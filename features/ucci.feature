@@ -0,0 +1,37 @@
+Feature: UCCI engine protocol
+  As a game server
+  I want to talk to the engine over the UCCI text protocol
+  So that engines run as isolated, restartable worker processes
+
+  @Ucci
+  Scenario: The engine identifies itself and answers isready
+    When the server sends "ucci" and "isready"
+    Then the engine replies with its id, "ucciok" and "readyok"
+
+  @Ucci
+  Scenario: Position moves are applied to the game before searching
+    When the server sends "position startpos moves h2e2 h9g7"
+    And the server sends "go depth 3"
+    Then it is Red to move in the engine's game
+    And the engine reports search info and a legal bestmove
+
+  @Ucci
+  Scenario: An infinite search keeps answering until it is stopped
+    When the server sends "go infinite"
+    And the server sends "isready"
+    Then "readyok" arrives while no bestmove has been sent
+    When the server sends "stop"
+    Then exactly one bestmove is sent
+
+  @Ucci
+  Scenario: A ponder search only reports its move after ponderhit
+    When the server sends "position startpos moves h2e2" and "go ponder depth 2"
+    Then no bestmove is sent while pondering
+    When the server sends "ponderhit"
+    Then exactly one bestmove is sent
+
+  @Ucci
+  Scenario: An illegal move in the list leaves the position before the moves
+    When the server sends "position startpos moves h2e2 h9g7 a0a5"
+    Then the engine answers "info string invalid position"
+    And the engine is at the start position with Red to move
@@ -0,0 +1,113 @@
+// Replacement global operator new/delete that feed AllocTracker's per-thread
+// counters. Kept out of chinese_chess_core: CMake compiles it straight into
+// the executables that want tracking, since a replacement must be linked
+// exactly once per program.
+#include "AllocTracker.h"
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace {
+
+void* allocate(std::size_t size) {
+    void* pointer = std::malloc(size ? size : 1);
+    if (pointer) {
+        AllocTracker::recordAllocation(size);
+    }
+    return pointer;
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    std::size_t align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    // The MSVC runtime has no aligned_alloc
+    void* pointer = _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc wants a size that is a multiple of the alignment
+    std::size_t rounded = ((size ? size : 1) + align - 1) / align * align;
+    void* pointer = std::aligned_alloc(align, rounded);
+#endif
+    if (pointer) {
+        AllocTracker::recordAllocation(size);
+    }
+    return pointer;
+}
+
+void release(void* pointer) {
+    if (pointer) {
+        AllocTracker::recordDeallocation();
+        std::free(pointer);
+    }
+}
+
+void releaseAligned(void* pointer) {
+    if (pointer) {
+        AllocTracker::recordDeallocation();
+#ifdef _WIN32
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+struct Activate {
+    Activate() { AllocTracker::activate(); }
+} activateTracking;
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* pointer = allocate(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = allocateAligned(size, alignment);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { releaseAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { releaseAligned(pointer); }
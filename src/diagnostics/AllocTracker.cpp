@@ -0,0 +1,64 @@
+#include "AllocTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// Trivially constructed and destroyed, so it is safe to touch from operator new
+// at any point in a thread's life
+thread_local AllocCounts threadCounts;
+
+std::atomic<bool> active{false};
+
+void abortOnViolation(const char* scope, std::uint64_t allocations) {
+    std::fprintf(stderr, "%llu heap allocation(s) inside NoAllocGuard \"%s\"\n",
+                 static_cast<unsigned long long>(allocations), scope);
+    std::abort();
+}
+
+std::atomic<AllocTracker::ViolationHandler> violationHandler{abortOnViolation};
+
+} // namespace
+
+bool AllocTracker::isActive() {
+    return active.load(std::memory_order_relaxed);
+}
+
+AllocCounts AllocTracker::thread() {
+    return threadCounts;
+}
+
+void AllocTracker::activate() {
+    active.store(true, std::memory_order_relaxed);
+}
+
+void AllocTracker::recordAllocation(std::size_t bytes) {
+    ++threadCounts.allocations;
+    threadCounts.bytes += bytes;
+}
+
+void AllocTracker::recordDeallocation() {
+    ++threadCounts.deallocations;
+}
+
+AllocTracker::ViolationHandler AllocTracker::setViolationHandler(ViolationHandler handler) {
+    return violationHandler.exchange(handler ? handler : abortOnViolation, std::memory_order_relaxed);
+}
+
+void AllocTracker::reportViolation(const char* scope, std::uint64_t allocations) {
+    violationHandler.load(std::memory_order_relaxed)(scope, allocations);
+}
+
+NoAllocGuard::NoAllocGuard(const char* scope) : scope_(scope), start_(threadCounts.allocations) {}
+
+NoAllocGuard::~NoAllocGuard() {
+    std::uint64_t count = allocations();
+    if (count > 0) {
+        AllocTracker::reportViolation(scope_, count);
+    }
+}
+
+std::uint64_t NoAllocGuard::allocations() const {
+    return threadCounts.allocations - start_;
+}
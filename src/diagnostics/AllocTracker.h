@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Heap allocation counters for the zero-allocation checks on the hot paths.
+//
+// Counting happens only when AllocInterposer.cpp, which replaces the global
+// operator new/delete, is linked into the executable; -DCHINESE_CHESS_ALLOC_TRACKING=ON
+// (the default) does that for the test binary. Elsewhere the counts stay zero
+// and isActive() is false, so the guards cost nothing in the tools.
+
+struct AllocCounts {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t bytes = 0;
+};
+
+class AllocTracker {
+public:
+    using ViolationHandler = void (*)(const char* scope, std::uint64_t allocations);
+
+    static bool isActive();
+    // Totals for the calling thread since it started
+    static AllocCounts thread();
+
+    // Hooks for the interposer
+    static void activate();
+    static void recordAllocation(std::size_t bytes);
+    static void recordDeallocation();
+
+    // Called when a NoAllocGuard saw allocations; the default prints and aborts.
+    // Returns the previous handler.
+    static ViolationHandler setViolationHandler(ViolationHandler handler);
+    static void reportViolation(const char* scope, std::uint64_t allocations);
+};
+
+// Reports a violation if the calling thread allocates while the guard is alive.
+// Other threads are not watched.
+class NoAllocGuard {
+private:
+    const char* scope_;
+    std::uint64_t start_;
+
+public:
+    explicit NoAllocGuard(const char* scope);
+    ~NoAllocGuard();
+
+    NoAllocGuard(const NoAllocGuard&) = delete;
+    NoAllocGuard& operator=(const NoAllocGuard&) = delete;
+
+    std::uint64_t allocations() const;
+};
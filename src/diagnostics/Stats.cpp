@@ -0,0 +1,114 @@
+#include "Stats.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Stats::ThreadBlock>> blocks;
+};
+
+// Never destroyed: thread_local releasers may run after static destruction
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+// Hands the thread's block back for reuse when the thread exits
+struct BlockReleaser {
+    Stats::ThreadBlock* block;
+    ~BlockReleaser() { block->inUse.store(false, std::memory_order_release); }
+};
+
+void clear(std::atomic<std::uint64_t>* values, int count) {
+    for (int i = 0; i < count; ++i) {
+        values[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace
+
+Stats::ThreadBlock& Stats::acquire() {
+    Registry& reg = registry();
+    ThreadBlock* block = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (auto& candidate : reg.blocks) {
+            if (!candidate->inUse.load(std::memory_order_acquire)) {
+                block = candidate.get();
+                break;
+            }
+        }
+        if (!block) {
+            reg.blocks.push_back(std::make_unique<ThreadBlock>());
+            block = reg.blocks.back().get();
+        }
+        block->inUse.store(true, std::memory_order_relaxed);
+    }
+    thread_local BlockReleaser releaser{block};
+    return *block;
+}
+
+StatsSnapshot Stats::snapshot() {
+    StatsSnapshot total;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& block : reg.blocks) {
+        for (int i = 0; i < StatsSnapshot::COUNTERS; ++i) {
+            total.counters[i] += block->counters[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < StatsSnapshot::REJECTIONS; ++i) {
+            total.rejections[i] += block->rejections[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < StatsSnapshot::CUTOFF_BUCKETS; ++i) {
+            total.cutoffsByMoveIndex[i] += block->cutoffs[i].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < StatsSnapshot::PHASES; ++i) {
+            total.phaseNanos[i] += block->phaseNanos[i].load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+void Stats::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& block : reg.blocks) {
+        clear(block->counters, StatsSnapshot::COUNTERS);
+        clear(block->rejections, StatsSnapshot::REJECTIONS);
+        clear(block->cutoffs, StatsSnapshot::CUTOFF_BUCKETS);
+        clear(block->phaseNanos, StatsSnapshot::PHASES);
+    }
+}
+
+StatsSnapshot StatsSnapshot::operator-(const StatsSnapshot& earlier) const {
+    StatsSnapshot delta = *this;
+    for (int i = 0; i < COUNTERS; ++i) {
+        delta.counters[i] -= earlier.counters[i];
+    }
+    for (int i = 0; i < REJECTIONS; ++i) {
+        delta.rejections[i] -= earlier.rejections[i];
+    }
+    for (int i = 0; i < CUTOFF_BUCKETS; ++i) {
+        delta.cutoffsByMoveIndex[i] -= earlier.cutoffsByMoveIndex[i];
+    }
+    for (int i = 0; i < PHASES; ++i) {
+        delta.phaseNanos[i] -= earlier.phaseNanos[i];
+    }
+    return delta;
+}
+
+const char* statCounterName(StatCounter counter) {
+    static const char* const NAMES[] = {
+        "nodes", "qnodes", "tt_probes", "tt_hits", "null_move_tries", "null_move_cutoffs",
+        "beta_cutoffs", "make_move_calls", "legal_move_cache_builds",
+    };
+    return NAMES[static_cast<int>(counter)];
+}
+
+const char* statPhaseName(StatPhase phase) {
+    static const char* const NAMES[] = {"search", "move_generation", "evaluation", "tablebase_probe"};
+    return NAMES[static_cast<int>(phase)];
+}
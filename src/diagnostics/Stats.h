@@ -0,0 +1,148 @@
+#pragma once
+#include "game/Game.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Instrumentation counters, compiled in with -DCHINESE_CHESS_STATS=ON.
+//
+// Each thread increments its own cache-line aligned block with plain relaxed
+// load/store pairs (no locked instructions); snapshot() sums every block with
+// relaxed loads while the threads keep running. Blocks outlive their threads
+// and are reused, so totals are cumulative until reset(). Phases that run once
+// per node (evaluation, move generation) would cost as much to time as to run,
+// so STATS_PHASE_SAMPLED times one call in PHASE_SAMPLE_INTERVAL and scales it
+// up. Without the build option the STATS_* macros compile to nothing.
+
+enum class StatCounter {
+    NODES, QNODES, TT_PROBES, TT_HITS, NULL_MOVE_TRIES, NULL_MOVE_CUTOFFS,
+    BETA_CUTOFFS, MAKE_MOVE_CALLS, LEGAL_MOVE_CACHE_BUILDS,
+    COUNT
+};
+
+enum class StatPhase {
+    SEARCH, MOVE_GENERATION, EVALUATION, TABLEBASE_PROBE,
+    COUNT
+};
+
+struct StatsSnapshot {
+    static constexpr int COUNTERS = static_cast<int>(StatCounter::COUNT);
+    static constexpr int REJECTIONS = static_cast<int>(MoveRejection::COUNT);
+    static constexpr int CUTOFF_BUCKETS = 8; // move index 0..6, then 7+
+    static constexpr int PHASES = static_cast<int>(StatPhase::COUNT);
+
+    std::uint64_t counters[COUNTERS] = {};
+    std::uint64_t rejections[REJECTIONS] = {};
+    std::uint64_t cutoffsByMoveIndex[CUTOFF_BUCKETS] = {};
+    std::uint64_t phaseNanos[PHASES] = {};
+
+    std::uint64_t counter(StatCounter counter) const { return counters[static_cast<int>(counter)]; }
+    std::uint64_t rejection(MoveRejection reason) const { return rejections[static_cast<int>(reason)]; }
+    std::uint64_t phaseNs(StatPhase phase) const { return phaseNanos[static_cast<int>(phase)]; }
+
+    // Difference between two snapshots, for per-search or per-interval numbers
+    StatsSnapshot operator-(const StatsSnapshot& earlier) const;
+};
+
+const char* statCounterName(StatCounter counter);
+const char* statPhaseName(StatPhase phase);
+
+class Stats {
+public:
+#ifdef CHINESE_CHESS_STATS
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+    static constexpr std::uint32_t PHASE_SAMPLE_INTERVAL = 64; // a power of two
+
+    struct alignas(64) ThreadBlock {
+        std::atomic<std::uint64_t> counters[StatsSnapshot::COUNTERS] = {};
+        std::atomic<std::uint64_t> rejections[StatsSnapshot::REJECTIONS] = {};
+        std::atomic<std::uint64_t> cutoffs[StatsSnapshot::CUTOFF_BUCKETS] = {};
+        std::atomic<std::uint64_t> phaseNanos[StatsSnapshot::PHASES] = {};
+        std::uint32_t phaseCalls[StatsSnapshot::PHASES] = {}; // owner only, picks the sampled calls
+        std::atomic<bool> inUse{false};
+    };
+
+private:
+    static ThreadBlock& acquire();
+
+    // Single writer per block, so no read-modify-write instruction is needed
+    static void add(std::atomic<std::uint64_t>& value, std::uint64_t amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+public:
+    static ThreadBlock& local() {
+        thread_local ThreadBlock& block = acquire();
+        return block;
+    }
+
+    static void increment(StatCounter counter) { add(local().counters[static_cast<int>(counter)], 1); }
+    static void reject(MoveRejection reason) { add(local().rejections[static_cast<int>(reason)], 1); }
+    static void cutoff(int moveIndex) {
+        add(local().cutoffs[moveIndex < StatsSnapshot::CUTOFF_BUCKETS ? moveIndex : StatsSnapshot::CUTOFF_BUCKETS - 1], 1);
+    }
+    static void addTime(StatPhase phase, std::uint64_t nanos) { add(local().phaseNanos[static_cast<int>(phase)], nanos); }
+    // True for one call of 'phase' in PHASE_SAMPLE_INTERVAL on this thread
+    static bool samplePhase(StatPhase phase) {
+        return (local().phaseCalls[static_cast<int>(phase)]++ & (PHASE_SAMPLE_INTERVAL - 1)) == 0;
+    }
+
+    static StatsSnapshot snapshot();
+    static void reset();
+};
+
+// Adds the scope's wall time to a phase
+class StatsPhaseTimer {
+private:
+    StatPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit StatsPhaseTimer(StatPhase phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+    ~StatsPhaseTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        Stats::addTime(phase_, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+};
+
+// StatsPhaseTimer for one call in PHASE_SAMPLE_INTERVAL, counted that many times
+class StatsSampledPhaseTimer {
+private:
+    StatPhase phase_;
+    bool timing_;
+    std::chrono::steady_clock::time_point start_;
+
+public:
+    explicit StatsSampledPhaseTimer(StatPhase phase) : phase_(phase), timing_(Stats::samplePhase(phase)) {
+        if (timing_) {
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~StatsSampledPhaseTimer() {
+        if (timing_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            Stats::addTime(phase_, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) *
+                                       Stats::PHASE_SAMPLE_INTERVAL);
+        }
+    }
+};
+
+#define STATS_CONCAT_INNER(a, b) a##b
+#define STATS_CONCAT(a, b) STATS_CONCAT_INNER(a, b)
+
+#ifdef CHINESE_CHESS_STATS
+#define STATS_INC(counter) Stats::increment(StatCounter::counter)
+#define STATS_REJECT(reason) Stats::reject(reason)
+#define STATS_CUTOFF(moveIndex) Stats::cutoff(moveIndex)
+#define STATS_PHASE(phase) StatsPhaseTimer STATS_CONCAT(statsPhaseTimer, __LINE__)(StatPhase::phase)
+#define STATS_PHASE_SAMPLED(phase) StatsSampledPhaseTimer STATS_CONCAT(statsPhaseTimer, __LINE__)(StatPhase::phase)
+#else
+#define STATS_INC(counter) ((void)0)
+#define STATS_REJECT(reason) ((void)0)
+#define STATS_CUTOFF(moveIndex) ((void)0)
+#define STATS_PHASE(phase) ((void)0)
+#define STATS_PHASE_SAMPLED(phase) ((void)0)
+#endif
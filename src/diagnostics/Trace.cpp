@@ -0,0 +1,164 @@
+#include "Trace.h"
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Trace::ThreadRing>> rings;
+};
+
+// Never destroyed: thread_local releasers may run after static destruction
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+struct RingReleaser {
+    Trace::ThreadRing* ring;
+    ~RingReleaser() { ring->inUse.store(false, std::memory_order_release); }
+};
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// Names are literals from this codebase, but keep the JSON valid regardless
+void writeString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+void writeMicros(std::ostream& out, std::uint64_t nanos) {
+    out << nanos / 1000 << '.' << (nanos % 1000) / 100 << (nanos % 100) / 10 << nanos % 10;
+}
+
+} // namespace
+
+std::atomic<bool> Trace::recording_{false};
+std::atomic<std::uint64_t> Trace::sessionStartNs_{0};
+
+Trace::ThreadRing& Trace::acquire() {
+    Registry& reg = registry();
+    ThreadRing* ring = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (auto& candidate : reg.rings) {
+            if (!candidate->inUse.load(std::memory_order_acquire)) {
+                ring = candidate.get();
+                break;
+            }
+        }
+        if (!ring) {
+            reg.rings.push_back(std::make_unique<ThreadRing>());
+            ring = reg.rings.back().get();
+            ring->threadId = static_cast<int>(reg.rings.size());
+        }
+        ring->inUse.store(true, std::memory_order_relaxed);
+    }
+    thread_local RingReleaser releaser{ring};
+    return *ring;
+}
+
+void Trace::start() {
+    sessionStartNs_.store(nowNs(), std::memory_order_relaxed);
+    recording_.store(true, std::memory_order_release);
+}
+
+void Trace::stop() {
+    recording_.store(false, std::memory_order_release);
+}
+
+std::uint64_t Trace::nowNs() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Trace::record(const TraceEvent& event) {
+    ThreadRing& ring = local();
+    std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    Slot& slot = ring.slots[head % RING_SIZE];
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.argName.store(event.argName, std::memory_order_relaxed);
+    slot.arg.store(event.arg, std::memory_order_relaxed);
+    slot.startNs.store(event.startNs, std::memory_order_relaxed);
+    slot.durationNs.store(event.durationNs, std::memory_order_relaxed);
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::writeJson(std::ostream& out) {
+#ifdef _WIN32
+    const int pid = _getpid();
+#else
+    const int pid = static_cast<int>(getpid());
+#endif
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    const std::uint64_t sessionStart = sessionStartNs_.load(std::memory_order_relaxed);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<TraceEvent> events;
+    for (const auto& ring : reg.rings) {
+        std::uint64_t head = ring->head.load(std::memory_order_acquire);
+        std::uint64_t begin = head > RING_SIZE ? head - RING_SIZE : 0;
+        events.clear();
+        for (std::uint64_t i = begin; i < head; ++i) {
+            const Slot& slot = ring->slots[i % RING_SIZE];
+            TraceEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.argName = slot.argName.load(std::memory_order_relaxed);
+            event.arg = slot.arg.load(std::memory_order_relaxed);
+            event.startNs = slot.startNs.load(std::memory_order_relaxed);
+            event.durationNs = slot.durationNs.load(std::memory_order_relaxed);
+            events.push_back(event);
+        }
+        // The writer may have lapped the copy; drop the slots it reused, counting
+        // the one it may be filling right now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t after = ring->head.load(std::memory_order_relaxed);
+        std::uint64_t skip = after + 1 > begin + RING_SIZE ? after + 1 - RING_SIZE - begin : 0;
+
+        for (std::uint64_t i = skip; i < events.size(); ++i) {
+            const TraceEvent& event = events[i];
+            if (!event.name || event.startNs < sessionStart) {
+                continue;
+            }
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeString(out, event.name);
+            out << ",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":" << pid << ",\"tid\":" << ring->threadId << ",\"ts\":";
+            writeMicros(out, event.startNs);
+            out << ",\"dur\":";
+            writeMicros(out, event.durationNs);
+            if (event.argName) {
+                out << ",\"args\":{";
+                writeString(out, event.argName);
+                out << ':' << event.arg << '}';
+            }
+            out << '}';
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+}
+
+bool Trace::writeFile(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    writeJson(out);
+    return static_cast<bool>(out);
+}
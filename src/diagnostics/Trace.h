@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Scoped tracing spans, compiled in with -DCHINESE_CHESS_TRACE=ON and recorded
+// between Trace::start() and Trace::stop().
+//
+// Each thread appends finished spans to its own ring buffer (single writer, no
+// locks); the newest RING_SIZE - 1 spans per thread are written out. writeJson() emits the
+// Chrome trace-event format, which chrome://tracing and Perfetto load directly.
+// Span and argument names must be string literals: only the pointers are stored.
+// Without the build option the TRACE_* macros compile to nothing.
+
+struct TraceEvent {
+    const char* name = nullptr;
+    const char* argName = nullptr;
+    std::int64_t arg = 0;
+    std::uint64_t startNs = 0;
+    std::uint64_t durationNs = 0;
+};
+
+class Trace {
+public:
+#ifdef CHINESE_CHESS_TRACE
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+    static constexpr std::uint64_t RING_SIZE = 1 << 14;
+
+    struct Slot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<const char*> argName{nullptr};
+        std::atomic<std::int64_t> arg{0};
+        std::atomic<std::uint64_t> startNs{0};
+        std::atomic<std::uint64_t> durationNs{0};
+    };
+
+    struct ThreadRing {
+        Slot slots[RING_SIZE];
+        std::atomic<std::uint64_t> head{0}; // spans ever written; the writer publishes with release
+        std::atomic<bool> inUse{false};
+        int threadId = 0;
+    };
+
+private:
+    static ThreadRing& acquire();
+    static std::atomic<bool> recording_;
+    static std::atomic<std::uint64_t> sessionStartNs_;
+
+public:
+    static ThreadRing& local() {
+        thread_local ThreadRing& ring = acquire();
+        return ring;
+    }
+
+    static bool isRecording() { return recording_.load(std::memory_order_relaxed); }
+    // Begins recording; spans from earlier sessions are no longer written out
+    static void start();
+    static void stop();
+
+    static std::uint64_t nowNs();
+    static void record(const TraceEvent& event);
+
+    // Spans recorded so far, oldest first per thread. Safe while threads keep
+    // recording: slots overwritten during the copy are dropped.
+    static void writeJson(std::ostream& out);
+    static bool writeFile(const std::string& path);
+};
+
+class TraceSpan {
+private:
+    TraceEvent event_;
+    bool active_;
+
+public:
+    // A null name records nothing, for spans that only apply to some calls
+    explicit TraceSpan(const char* name, const char* argName = nullptr, std::int64_t arg = 0)
+        : active_(name && Trace::isRecording()) {
+        if (active_) {
+            event_.name = name;
+            event_.argName = argName;
+            event_.arg = arg;
+            event_.startNs = Trace::nowNs();
+        }
+    }
+    ~TraceSpan() {
+        if (active_) {
+            event_.durationNs = Trace::nowNs() - event_.startNs;
+            Trace::record(event_);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#ifdef CHINESE_CHESS_TRACE
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_SPAN_ARG(name, argName, arg) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name, argName, arg)
+#define TRACE_SPAN_IF(condition, name, argName, arg) \
+    TraceSpan TRACE_CONCAT(traceSpan, __LINE__)((condition) ? (name) : nullptr, argName, arg)
+#else
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_SPAN_ARG(name, argName, arg) ((void)0)
+#define TRACE_SPAN_IF(condition, name, argName, arg) ((void)0)
+#endif
@@ -0,0 +1,129 @@
+#include "Analyzer.h"
+#include "io/GameRecordReader.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+BatchAnalyzer::BatchAnalyzer(const AnalysisSettings& settings, AnalysisCache* cache)
+    : settings_(settings), cache_(cache) {
+    settings_.depth = std::min(std::max(1, settings_.depth), Search::MAX_PLY - 1);
+}
+
+PositionAnalysis BatchAnalyzer::analyze(const BoardState& state, Search& search) const {
+    PositionAnalysis result;
+    result.key = state.key();
+    CachedAnalysis entry;
+    if (cache_ && cache_->lookup(state.key(), settings_.depth, entry)) {
+        result.best = Move(entry.move);
+        result.score = entry.score;
+        result.depth = entry.depth;
+        result.cached = true;
+        return result;
+    }
+
+    SearchLimits limits;
+    limits.depth = settings_.depth;
+    SearchResult searched = search.run(state, std::vector<std::uint64_t>(), limits);
+    result.best = searched.best;
+    result.score = searched.score;
+    result.depth = searched.depth;
+    if (cache_ && !searched.best.isNull()) {
+        cache_->store(state.key(), searched.best, searched.score, searched.depth);
+    }
+    return result;
+}
+
+template <typename AnalyzeItem>
+AnalysisSummary BatchAnalyzer::runPool(std::size_t itemCount, AnalyzeItem analyzeItem, const ItemCallback& onItem) const {
+    AnalysisSummary summary;
+    std::mutex mutex;
+    std::atomic<std::size_t> nextItem{0};
+
+    auto worker = [&]() {
+        Game game;
+        Search search(settings_.hashMegabytes);
+        AnalyzedItem item;
+        while (true) {
+            std::size_t index = nextItem.fetch_add(1);
+            if (index >= itemCount) {
+                break;
+            }
+            item.index = index;
+            item.positions.clear();
+            item.ok = analyzeItem(index, game, search, item.positions);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ++summary.items;
+            summary.failed += item.ok ? 0 : 1;
+            summary.positions += item.positions.size();
+            for (const PositionAnalysis& position : item.positions) {
+                summary.cacheHits += position.cached ? 1 : 0;
+            }
+            if (onItem) {
+                onItem(item);
+            }
+        }
+    };
+
+    unsigned threads = std::max(1u, std::min<unsigned>(settings_.threads, static_cast<unsigned>(std::max<std::size_t>(1, itemCount))));
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return summary;
+}
+
+AnalysisSummary BatchAnalyzer::analyzeGames(std::string_view data, const ItemCallback& onItem) const {
+    // Game boundaries first, so that workers take whole games in input order
+    std::vector<std::string_view> games;
+    GameRecordReader reader(data);
+    GameRecord record;
+    while (reader.next(record)) {
+        games.push_back(record.raw());
+    }
+
+    return runPool(games.size(), [&](std::size_t index, Game& game, Search& search, std::vector<PositionAnalysis>& out) {
+        GameRecord record;
+        GameRecordReader::parseRecord(games[index], record);
+        if (!Fen::parse(record.startFen(), game)) {
+            return false;
+        }
+        BoardState state = BoardState::fromGame(game);
+        ReplayResult replay = record.replay(game, [&](int ply, const Position& from, const Position& to, const MoveResult&) {
+            Move played(from, to);
+            PositionAnalysis analysis = analyze(state, search);
+            analysis.ply = ply;
+            analysis.played = played;
+            out.push_back(analysis);
+            state.makeMove(played);
+        });
+        return replay.ok;
+    }, onItem);
+}
+
+AnalysisSummary BatchAnalyzer::analyzePositions(std::string_view text, const ItemCallback& onItem) const {
+    std::vector<std::string_view> fens;
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        std::size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string_view::npos || line[first] == '#') {
+            continue;
+        }
+        std::size_t last = line.find_last_not_of(" \t\r");
+        fens.push_back(line.substr(first, last - first + 1));
+    }
+
+    return runPool(fens.size(), [&](std::size_t index, Game& game, Search& search, std::vector<PositionAnalysis>& out) {
+        if (!Fen::parse(fens[index], game)) {
+            return false;
+        }
+        out.push_back(analyze(BoardState::fromGame(game), search));
+        return true;
+    }, onItem);
+}
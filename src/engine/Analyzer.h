@@ -0,0 +1,65 @@
+#pragma once
+#include "Search.h"
+#include "io/AnalysisCache.h"
+#include <functional>
+#include <string_view>
+#include <vector>
+
+struct AnalysisSettings {
+    int depth = 8;
+    unsigned threads = 1;
+    std::size_t hashMegabytes = 16; // per worker
+};
+
+struct PositionAnalysis {
+    int ply = 0;            // within the game; 0 for single positions
+    std::uint64_t key = 0;
+    Move played;            // the game move from this position; null for single positions
+    Move best;              // null when the side to move has no legal move
+    int score = 0;          // for the side to move
+    int depth = 0;          // of the result used, which may exceed the requested depth
+    bool cached = false;
+};
+
+struct AnalyzedItem {
+    std::size_t index = 0; // game or line number in the input, from 0
+    bool ok = true;        // false for an unreadable FEN or an illegal game
+    std::vector<PositionAnalysis> positions;
+};
+
+struct AnalysisSummary {
+    std::size_t items = 0;
+    std::size_t failed = 0;
+    std::uint64_t positions = 0;
+    std::uint64_t cacheHits = 0;
+};
+
+// Offline analysis of game records or FEN lists on a pool of threads. Each
+// worker owns a Game (the referee for replayed moves) and a Search and takes
+// the next game or position from a shared counter. Every position before a
+// game move is searched to the requested depth unless the cache already holds
+// a result at least that deep; new results go into the cache as soon as they
+// exist, so overlapping games analysed at the same time share them too.
+// Positions are searched without their game history, matching the cache key.
+class BatchAnalyzer {
+public:
+    // Called under a lock after every game or position, in completion order
+    using ItemCallback = std::function<void(const AnalyzedItem&)>;
+
+private:
+    AnalysisSettings settings_;
+    AnalysisCache* cache_;
+
+    template <typename AnalyzeItem>
+    AnalysisSummary runPool(std::size_t itemCount, AnalyzeItem analyzeItem, const ItemCallback& onItem) const;
+    PositionAnalysis analyze(const BoardState& state, Search& search) const;
+
+public:
+    // 'cache' may be null; it is not owned
+    explicit BatchAnalyzer(const AnalysisSettings& settings, AnalysisCache* cache = nullptr);
+
+    // 'data' holds PGN-style records, typically a MappedFile
+    AnalysisSummary analyzeGames(std::string_view data, const ItemCallback& onItem) const;
+    // One FEN per line; blank lines and '#' comments are skipped
+    AnalysisSummary analyzePositions(std::string_view text, const ItemCallback& onItem) const;
+};
@@ -0,0 +1,79 @@
+#include "BoardState.h"
+#include "game/Zobrist.h"
+
+BoardState::BoardState() : side_(Color::RED), key_(0), generals_{-1, -1} {
+    squares_.fill(EMPTY_CODE);
+}
+
+BoardState::BoardState(const PieceCodes& squares, Color sideToMove)
+    : squares_(squares), side_(sideToMove), generals_{-1, -1} {
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        PieceCode code = squares_[square];
+        if (code != EMPTY_CODE && pieceCodeType(code) == PieceType::GENERAL) {
+            generals_[static_cast<int>(pieceCodeColor(code))] = square;
+        }
+    }
+    key_ = Zobrist::hash(squares_, side_);
+}
+
+BoardState BoardState::fromBoard(const Board& board, Color sideToMove) {
+    return BoardState(board.toCodes(), sideToMove);
+}
+
+BoardState BoardState::fromGame(const Game& game) {
+    return fromBoard(game.getBoard(), game.getCurrentPlayer());
+}
+
+void BoardState::toGame(Game& game) const {
+    game.getBoard().loadCodes(squares_);
+    game.startFromBoard(side_);
+}
+
+int BoardState::pieceCount() const {
+    int count = 0;
+    for (PieceCode code : squares_) {
+        count += (code != EMPTY_CODE);
+    }
+    return count;
+}
+
+PieceCode BoardState::makeMove(Move move) {
+    int from = move.from();
+    int to = move.to();
+    PieceCode moved = squares_[from];
+    PieceCode captured = squares_[to];
+
+    key_ = Zobrist::afterMove(key_, moved, captured, from, to);
+    squares_[to] = moved;
+    squares_[from] = EMPTY_CODE;
+    if (pieceCodeType(moved) == PieceType::GENERAL) {
+        generals_[static_cast<int>(side_)] = to;
+    }
+    if (captured != EMPTY_CODE && pieceCodeType(captured) == PieceType::GENERAL) {
+        generals_[static_cast<int>(opponent(side_))] = -1;
+    }
+    side_ = opponent(side_);
+    return captured;
+}
+
+void BoardState::unmakeMove(Move move, PieceCode captured) {
+    int from = move.from();
+    int to = move.to();
+    PieceCode moved = squares_[to];
+
+    side_ = opponent(side_);
+    squares_[from] = moved;
+    squares_[to] = captured;
+    key_ = Zobrist::afterMove(key_, moved, captured, from, to);
+    if (pieceCodeType(moved) == PieceType::GENERAL) {
+        generals_[static_cast<int>(side_)] = from;
+    }
+    if (captured != EMPTY_CODE && pieceCodeType(captured) == PieceType::GENERAL) {
+        generals_[static_cast<int>(opponent(side_))] = to;
+    }
+}
+
+void BoardState::makeNullMove() {
+    side_ = opponent(side_);
+    key_ ^= Zobrist::sideKey();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "game/Game.h"
+#include "game/Move.h"
+#include "game/PieceCode.h"
+#include <cstdint>
+
+// Compact, copyable value board for search and analysis: one PieceCode per
+// square, the side to move, an incrementally updated Zobrist key and the two
+// General squares. Copying one is a 100-byte memcpy and make/unmake never
+// allocates, unlike Board with its unique_ptr cells.
+class BoardState {
+private:
+    PieceCodes squares_;
+    Color side_;
+    std::uint64_t key_;
+    int generals_[2]; // by Color; -1 when absent
+
+public:
+    BoardState();
+    BoardState(const PieceCodes& squares, Color sideToMove);
+
+    static BoardState fromBoard(const Board& board, Color sideToMove);
+    static BoardState fromGame(const Game& game);
+    // Loads into a Game through Board::loadCodes()
+    void toGame(Game& game) const;
+
+    const PieceCodes& squares() const { return squares_; }
+    PieceCode at(int square) const { return squares_[square]; }
+    Color sideToMove() const { return side_; }
+    std::uint64_t key() const { return key_; }
+    int generalSquare(Color color) const { return generals_[static_cast<int>(color)]; }
+    int pieceCount() const;
+
+    // Returns the captured code (EMPTY_CODE if none); the move must be pseudo-legal
+    PieceCode makeMove(Move move);
+    void unmakeMove(Move move, PieceCode captured);
+    void makeNullMove();
+    void unmakeNullMove() { makeNullMove(); }
+};
+
+constexpr Color opponent(Color color) {
+    return color == Color::RED ? Color::BLACK : Color::RED;
+}
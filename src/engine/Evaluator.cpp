@@ -0,0 +1,225 @@
+#include "Evaluator.h"
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CHINESE_CHESS_AVX2_KERNEL 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr int DEFAULT_MATERIAL[PIECE_TYPE_COUNT] = {
+    0,   // GENERAL: always present, never traded
+    120, // GUARD
+    600, // ROOK
+    270, // HORSE
+    285, // CANNON
+    120, // ELEPHANT
+    30,  // SOLDIER
+};
+
+// Square bonus for Red; row 1 is Red's back rank
+int defaultSquareBonus(PieceType type, int row, int col) {
+    int centre = std::abs(col - 5);
+    switch (type) {
+        case PieceType::ROOK:
+            return (row >= 6 ? 10 : 0) + (col == 4 || col == 6 ? 6 : 0) - (row == 1 && (col == 1 || col == 9) ? 10 : 0);
+        case PieceType::HORSE:
+            return 12 - 3 * centre + (row >= 4 && row <= 8 ? 3 * (row - 3) : 0) - (row == 1 ? 10 : 0);
+        case PieceType::CANNON:
+            return (col == 5 ? 15 : 0) + (row == 3 ? 5 : 0) - (row >= 9 ? 10 : 0);
+        case PieceType::SOLDIER:
+            if (row <= 5) {
+                return row == 5 && col == 5 ? 10 : 0;
+            }
+            // Crossed the river: sideways moves and pressure on the palace
+            return 60 + 10 - 3 * centre + (row == 8 || row == 9 ? 20 : 0) - (row == 10 ? 30 : 0);
+        case PieceType::GUARD:
+            return row == 2 && col == 5 ? 5 : 0;
+        default:
+            return 0;
+    }
+}
+
+} // namespace
+
+EvalWeights EvalWeights::defaults() {
+    EvalWeights weights;
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        weights.material[type] = DEFAULT_MATERIAL[type];
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            Position pos = squarePosition(square);
+            weights.squares[type][square] = defaultSquareBonus(static_cast<PieceType>(type), pos.row, pos.col);
+        }
+    }
+    return weights;
+}
+
+void EvalWeights::write(std::ostream& out) const {
+    out << "# general guard rook horse cannon elephant soldier\nmaterial";
+    for (int value : material) {
+        out << ' ' << value;
+    }
+    out << '\n';
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        out << "squares " << type << '\n';
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            out << squares[type][square] << (square % BOARD_COLS == BOARD_COLS - 1 ? '\n' : ' ');
+        }
+    }
+}
+
+bool EvalWeights::parse(std::string_view text, EvalWeights& out) {
+    std::string stripped;
+    std::istringstream lines{std::string(text)};
+    for (std::string line; std::getline(lines, line);) {
+        stripped += line.substr(0, line.find('#'));
+        stripped += '\n';
+    }
+
+    EvalWeights weights;
+    bool seenMaterial = false;
+    bool seenSquares[PIECE_TYPE_COUNT] = {};
+    std::istringstream in(stripped);
+    for (std::string word; in >> word;) {
+        if (word == "material") {
+            for (int& value : weights.material) {
+                if (!(in >> value)) {
+                    return false;
+                }
+            }
+            seenMaterial = true;
+        } else if (word == "squares") {
+            int type = -1;
+            if (!(in >> type) || type < 0 || type >= PIECE_TYPE_COUNT) {
+                return false;
+            }
+            for (int& value : weights.squares[type]) {
+                if (!(in >> value)) {
+                    return false;
+                }
+            }
+            seenSquares[type] = true;
+        } else {
+            return false;
+        }
+    }
+    for (bool seen : seenSquares) {
+        if (!seen) {
+            return false;
+        }
+    }
+    if (!seenMaterial) {
+        return false;
+    }
+    out = weights;
+    return true;
+}
+
+Evaluator::Evaluator(const EvalWeights& weights) : weights_(weights) {
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        PieceCode red = pieceCode(static_cast<PieceType>(type), Color::RED);
+        PieceCode black = pieceCode(static_cast<PieceType>(type), Color::BLACK);
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            Position pos = squarePosition(square);
+            int mirrored = squareIndex(BOARD_ROWS + 1 - pos.row, pos.col);
+            table_[square][red] = weights.material[type] + weights.squares[type][square];
+            table_[square][black] = -(weights.material[type] + weights.squares[type][mirrored]);
+        }
+    }
+}
+
+int Evaluator::evaluate(const BoardState& state) const {
+    int score = 0;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        score += table_[square][state.at(square)];
+    }
+    return state.sideToMove() == Color::RED ? score : -score;
+}
+
+int EvalBatch::add(const BoardState& state) {
+    if (full()) {
+        return -1;
+    }
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        codes[square][size] = state.at(square);
+    }
+    sideToMove[size] = state.sideToMove();
+    return size++;
+}
+
+void Evaluator::evaluateBatchScalar(const EvalBatch& batch, int* scores) const {
+    int sums[EvalBatch::MAX_LANES] = {};
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        const std::array<int, 16>& row = table_[square];
+        for (int lane = 0; lane < batch.size; ++lane) {
+            sums[lane] += row[batch.codes[square][lane]];
+        }
+    }
+    for (int lane = 0; lane < batch.size; ++lane) {
+        scores[lane] = batch.sideToMove[lane] == Color::RED ? sums[lane] : -sums[lane];
+    }
+}
+
+#ifdef CHINESE_CHESS_AVX2_KERNEL
+
+namespace {
+
+// Eight lanes at a time. A code's low three bits index a register of the
+// square's Red or Black entries (vpermd); bit 3, shifted into the sign bit,
+// picks between the two. Lanes past batch.size hold stale codes, which is
+// harmless: their sums are never stored.
+__attribute__((target("avx2")))
+void evaluateAvx2(const std::array<std::array<int, 16>, BOARD_SQUARES>& table, const EvalBatch& batch, int* sums) {
+    for (int lane = 0; lane < batch.size; lane += 8) {
+        __m256i sum = _mm256_setzero_si256();
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            __m256i codes = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&batch.codes[square][lane])));
+            __m256i red = _mm256_load_si256(reinterpret_cast<const __m256i*>(&table[square][0]));
+            __m256i black = _mm256_load_si256(reinterpret_cast<const __m256i*>(&table[square][8]));
+            __m256 redValues = _mm256_castsi256_ps(_mm256_permutevar8x32_epi32(red, codes));
+            __m256 blackValues = _mm256_castsi256_ps(_mm256_permutevar8x32_epi32(black, codes));
+            __m256 isBlack = _mm256_castsi256_ps(_mm256_slli_epi32(codes, 28));
+            sum = _mm256_add_epi32(sum, _mm256_castps_si256(_mm256_blendv_ps(redValues, blackValues, isBlack)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(&sums[lane]), sum);
+    }
+}
+
+} // namespace
+
+bool Evaluator::hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+void Evaluator::evaluateBatch(const EvalBatch& batch, int* scores) const {
+    if (!hasAvx2()) {
+        evaluateBatchScalar(batch, scores);
+        return;
+    }
+    int sums[EvalBatch::MAX_LANES];
+    evaluateAvx2(table_, batch, sums);
+    for (int lane = 0; lane < batch.size; ++lane) {
+        scores[lane] = batch.sideToMove[lane] == Color::RED ? sums[lane] : -sums[lane];
+    }
+}
+
+#else
+
+bool Evaluator::hasAvx2() {
+    return false;
+}
+
+void Evaluator::evaluateBatch(const EvalBatch& batch, int* scores) const {
+    evaluateBatchScalar(batch, scores);
+}
+
+#endif
+
+int Evaluator::pieceValue(PieceType type) {
+    return DEFAULT_MATERIAL[static_cast<int>(type)];
+}
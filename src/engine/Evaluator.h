@@ -0,0 +1,62 @@
+#pragma once
+#include "BoardState.h"
+#include <array>
+#include <ostream>
+#include <string_view>
+
+constexpr int PIECE_TYPE_COUNT = 7;
+
+// Evaluation weights from Red's point of view: material plus a bonus per
+// piece type and square. Black pieces read the table mirrored top-to-bottom.
+struct EvalWeights {
+    std::array<int, PIECE_TYPE_COUNT> material{};
+    std::array<std::array<int, BOARD_SQUARES>, PIECE_TYPE_COUNT> squares{};
+
+    static EvalWeights defaults();
+
+    // Text form: "material" and seven values, then "squares <type>" and the
+    // type's 90 values row by row from Red's back rank. '#' starts a comment.
+    void write(std::ostream& out) const;
+    static bool parse(std::string_view text, EvalWeights& out);
+};
+
+// Positions laid out structure-of-arrays for Evaluator::evaluateBatch():
+// codes[square][lane], so one square of every position is contiguous
+struct EvalBatch {
+    static constexpr int MAX_LANES = 64;
+
+    alignas(32) PieceCode codes[BOARD_SQUARES][MAX_LANES];
+    Color sideToMove[MAX_LANES];
+    int size = 0;
+
+    void clear() { size = 0; }
+    bool full() const { return size == MAX_LANES; }
+    // Returns the lane, or -1 when the batch is full
+    int add(const BoardState& state);
+};
+
+// Static evaluation in centipawns for the side to move
+class Evaluator {
+private:
+    EvalWeights weights_;
+    // Material + square bonus, signed for Red, by square then piece code. A
+    // square's 16 entries are two AVX2 registers: Red codes, then Black codes.
+    alignas(32) std::array<std::array<int, 16>, BOARD_SQUARES> table_{};
+
+public:
+    Evaluator() : Evaluator(EvalWeights::defaults()) {}
+    explicit Evaluator(const EvalWeights& weights);
+
+    const EvalWeights& weights() const { return weights_; }
+    int evaluate(const BoardState& state) const;
+
+    // scores[lane] = evaluate() of each position in the batch. Uses AVX2 when
+    // the CPU has it (eight positions per instruction), the scalar loop otherwise.
+    void evaluateBatch(const EvalBatch& batch, int* scores) const;
+    void evaluateBatchScalar(const EvalBatch& batch, int* scores) const;
+    // False when built for another architecture or the CPU lacks AVX2
+    static bool hasAvx2();
+
+    // Default material value, also used for capture ordering
+    static int pieceValue(PieceType type);
+};
@@ -0,0 +1,55 @@
+#include "LiveGame.h"
+#include "game/Fen.h"
+#include <algorithm>
+
+std::vector<std::uint64_t> GameSnapshot::historyKeys() const {
+    std::vector<std::uint64_t> keys;
+    keys.reserve(static_cast<std::size_t>(ply));
+    for (const GameSnapshot* node = previous.get(); node; node = node->previous.get()) {
+        keys.push_back(node->state.key());
+    }
+    std::reverse(keys.begin(), keys.end());
+    return keys;
+}
+
+LiveGame::LiveGame() {
+    loadFen(Fen::START_POSITION);
+}
+
+void LiveGame::publish(SnapshotPtr snapshot) {
+    std::atomic_store_explicit(&current_, std::move(snapshot), std::memory_order_release);
+}
+
+SnapshotPtr LiveGame::snapshot() const {
+    return std::atomic_load_explicit(&current_, std::memory_order_acquire);
+}
+
+bool LiveGame::loadFen(std::string_view fen) {
+    if (!Fen::parse(fen, game_)) {
+        return false;
+    }
+    auto first = std::make_shared<GameSnapshot>();
+    first->state = BoardState::fromGame(game_);
+    publish(std::move(first));
+    return true;
+}
+
+MoveResult LiveGame::makeMove(const Position& from, const Position& to) {
+    MoveResult result = game_.makeMove(from, to);
+    if (!result.isLegal) {
+        return result;
+    }
+
+    // Only this thread replaces current_, so a plain read of it is safe here
+    const SnapshotPtr& previous = current_;
+    auto next = std::make_shared<GameSnapshot>();
+    next->state = previous->state;
+    next->lastMove = Move(from, to);
+    next->state.makeMove(next->lastMove);
+    next->ply = previous->ply + 1;
+    next->gameOver = result.gameEnded;
+    next->winner = result.gameEnded ? result.winner : Color::RED;
+    next->previous = previous;
+    publish(std::move(next));
+    return result;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "BoardState.h"
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Immutable position published by a LiveGame. Snapshots form a persistent
+// list through 'previous', so each move costs one small allocation and the
+// history is shared with every older snapshot instead of being copied.
+struct GameSnapshot {
+    BoardState state;
+    Move lastMove;   // null for the first snapshot
+    int ply = 0;     // moves played since the game was loaded
+    bool gameOver = false;
+    Color winner = Color::RED;
+    std::shared_ptr<const GameSnapshot> previous;
+
+    // Keys of the earlier positions, oldest first, as Search::run() expects
+    std::vector<std::uint64_t> historyKeys() const;
+};
+
+using SnapshotPtr = std::shared_ptr<const GameSnapshot>;
+
+// A Game owned by one thread (the player's move path) that publishes a
+// snapshot after every legal move. Any number of analysis threads call
+// snapshot() and search or inspect the result without touching the Game, so
+// spectators, hints and audits never hold up the player.
+class LiveGame {
+private:
+    Game game_;
+    SnapshotPtr current_; // read and replaced only through std::atomic_load/store
+
+    void publish(SnapshotPtr snapshot);
+
+public:
+    LiveGame();
+
+    // Owner thread only
+    bool loadFen(std::string_view fen);
+    MoveResult makeMove(const Position& from, const Position& to);
+    const Game& game() const { return game_; }
+
+    // Any thread; the snapshot stays valid for as long as it is held
+    SnapshotPtr snapshot() const;
+};
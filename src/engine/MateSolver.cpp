@@ -0,0 +1,242 @@
+#include "MateSolver.h"
+#include "diagnostics/Trace.h"
+#include <algorithm>
+
+namespace {
+
+constexpr std::uint32_t INF = MateSolver::INFINITE_NUMBER;
+
+std::uint32_t saturatingAdd(std::uint32_t a, std::uint32_t b) {
+    return a >= INF - b ? INF : a + b;
+}
+
+} // namespace
+
+MateSolver::MateSolver(const MateSolverSettings& settings) {
+    setSettings(settings);
+}
+
+void MateSolver::setSettings(const MateSolverSettings& settings) {
+    settings_ = settings;
+    settings_.maxPly = std::min(std::max(1, settings_.maxPly), 1000);
+    std::size_t buckets = std::max<std::size_t>(1, settings_.tableMegabytes * 1024 * 1024 / (sizeof(Entry) * BUCKET_ENTRIES));
+    std::size_t power = 1;
+    while (power * 2 <= buckets) {
+        power *= 2;
+    }
+    entries_.assign(power * BUCKET_ENTRIES, Entry());
+    mask_ = power - 1;
+}
+
+const MateSolver::Entry* MateSolver::probe(std::uint64_t key) const {
+    const Entry* bucket = &entries_[(key & mask_) * BUCKET_ENTRIES];
+    for (int i = 0; i < BUCKET_ENTRIES; ++i) {
+        if (bucket[i].key == key && (bucket[i].phi | bucket[i].delta) != 0) {
+            return &bucket[i];
+        }
+    }
+    return nullptr;
+}
+
+void MateSolver::store(std::uint64_t key, const Numbers& numbers, bool replace) {
+    // Solved positions live in the first slot and unfinished work in the
+    // second; first-visit seeds only take a free slot, so the numbers mid()
+    // backs up for a child are still there when its parent reads them
+    Entry* bucket = &entries_[(key & mask_) * BUCKET_ENTRIES];
+    const bool solved = numbers.phi == 0 || numbers.delta == 0;
+    Entry* slot = nullptr;
+    for (int i = 0; i < BUCKET_ENTRIES && !slot; ++i) {
+        if (bucket[i].key == key && (bucket[i].phi | bucket[i].delta) != 0) {
+            slot = &bucket[i];
+        }
+    }
+    if (!slot || (solved && slot != &bucket[0])) {
+        if (slot) {
+            *slot = Entry();
+        }
+        slot = &bucket[solved ? 0 : 1];
+        if (!replace && (slot->phi | slot->delta) != 0) {
+            return;
+        }
+    }
+    Entry& entry = *slot;
+    entry.key = key;
+    entry.phi = numbers.phi;
+    entry.delta = numbers.delta;
+    entry.distance = static_cast<std::uint16_t>(std::min(numbers.distance, 0xFFFF));
+    entry.pathDependent = numbers.pathDependent ? 1 : 0;
+}
+
+int MateSolver::generateMoves(BoardState& state, Move* moves) const {
+    int count = MoveGenerator::generateLegal(state, moves);
+    if (!settings_.checksOnly || state.sideToMove() != attacker_) {
+        return count;
+    }
+    const Color defender = opponent(attacker_);
+    int checks = 0;
+    for (int i = 0; i < count; ++i) {
+        PieceCode captured = state.makeMove(moves[i]);
+        bool check = MoveGenerator::isInCheck(state, defender);
+        state.unmakeMove(moves[i], captured);
+        if (check) {
+            moves[checks++] = moves[i];
+        }
+    }
+    return checks;
+}
+
+MateSolver::Numbers MateSolver::childNumbers(BoardState& child, int ply) {
+    const bool repeated = std::find(pathKeys_.begin(), pathKeys_.end(), child.key()) != pathKeys_.end();
+    if (repeated || ply > settings_.maxPly) {
+        // The attacker fails: the mover wins if it is the defender
+        return child.sideToMove() == attacker_ ? Numbers{INF, 0, 0, true} : Numbers{0, INF, 0, true};
+    }
+    if (const Entry* entry = probe(child.key())) {
+        return Numbers{entry->phi, entry->delta, entry->distance, entry->pathDependent != 0};
+    }
+    // First visit: the move count seeds delta, so wide nodes look harder to
+    // refute (attacker) or to break (defender); no move at all is decided here
+    Move moves[MoveGenerator::MAX_MOVES];
+    const int count = generateMoves(child, moves);
+    Numbers numbers = count == 0 ? Numbers{INF, 0, 0} : Numbers{1, static_cast<std::uint32_t>(count), 0};
+    store(child.key(), numbers, false);
+    return numbers;
+}
+
+void MateSolver::mid(BoardState& state, std::uint32_t thresholdPhi, std::uint32_t thresholdDelta, int ply) {
+    ++nodes_;
+    if (stopRequested_.load(std::memory_order_relaxed) || (limits_.nodes > 0 && nodes_ >= limits_.nodes) ||
+        time_.hardDeadlineReached(nodes_)) {
+        aborted_ = true;
+        return;
+    }
+
+    Move moves[MoveGenerator::MAX_MOVES];
+    const int count = generateMoves(state, moves);
+    if (count == 0) {
+        // No (checking) move for the attacker, or the defender is mated
+        store(state.key(), Numbers{INF, 0, 0});
+        return;
+    }
+
+    pathKeys_.push_back(state.key());
+    Numbers numbers{0, 0, 0};
+    while (true) {
+        // phi is the smallest child delta, delta the sum of the child phis
+        numbers = Numbers{INF, 0, 0};
+        int best = 0;
+        std::uint32_t bestPhi = INF;
+        std::uint32_t secondDelta = INF;
+        int winDistance = 0xFFFF;
+        int lossDistance = 0;
+        bool anyDependent = false;
+        bool independentWin = false;
+        for (int i = 0; i < count; ++i) {
+            PieceCode captured = state.makeMove(moves[i]);
+            Numbers child = childNumbers(state, ply + 1);
+            state.unmakeMove(moves[i], captured);
+
+            if (child.delta < numbers.phi) {
+                secondDelta = numbers.phi;
+                numbers.phi = child.delta;
+                best = i;
+                bestPhi = child.phi;
+            } else if (child.delta < secondDelta) {
+                secondDelta = child.delta;
+            }
+            numbers.delta = saturatingAdd(numbers.delta, child.phi);
+            if (child.delta == 0) {
+                winDistance = std::min(winDistance, child.distance + 1);
+                independentWin = independentWin || !child.pathDependent;
+            }
+            anyDependent = anyDependent || child.pathDependent;
+            lossDistance = std::max(lossDistance, child.distance + 1);
+        }
+        if (numbers.phi == 0) {
+            numbers.distance = winDistance;
+        } else if (numbers.delta == 0) {
+            numbers.distance = lossDistance;
+        }
+        // A win needs one winning move that holds on any path; anything else
+        // may rest on every child
+        numbers.pathDependent = numbers.phi == 0 ? !independentWin : anyDependent;
+        if (numbers.phi >= thresholdPhi || numbers.delta >= thresholdDelta || aborted_) {
+            break;
+        }
+
+        std::uint32_t childPhi = thresholdDelta >= INF ? INF : thresholdDelta - numbers.delta + bestPhi;
+        std::uint32_t childDelta = std::min(thresholdPhi, saturatingAdd(secondDelta, 1));
+        PieceCode captured = state.makeMove(moves[best]);
+        mid(state, childPhi, childDelta, ply + 1);
+        state.unmakeMove(moves[best], captured);
+    }
+    pathKeys_.pop_back();
+    store(state.key(), numbers);
+}
+
+void MateSolver::buildMainLine(BoardState state, std::vector<Move>& line) {
+    // The proof is in the table; entries lost to collisions are solved again
+    pathKeys_.clear();
+    for (int ply = 0; ply <= settings_.maxPly && !aborted_; ++ply) {
+        Move moves[MoveGenerator::MAX_MOVES];
+        const int count = generateMoves(state, moves);
+        if (count == 0) {
+            return;
+        }
+        const bool attacking = state.sideToMove() == attacker_;
+        pathKeys_.push_back(state.key());
+        Move chosen;
+        int chosenDistance = attacking ? 0xFFFF : -1;
+        for (int i = 0; i < count; ++i) {
+            PieceCode captured = state.makeMove(moves[i]);
+            Numbers child = childNumbers(state, ply + 1);
+            if (child.phi != 0 && child.delta != 0) {
+                mid(state, INF, INF, ply + 1);
+                child = childNumbers(state, ply + 1);
+            }
+            state.unmakeMove(moves[i], captured);
+            // The attacker takes the quickest proven mate, the defender the slowest
+            if (attacking && child.delta == 0 && child.distance < chosenDistance) {
+                chosen = moves[i];
+                chosenDistance = child.distance;
+            } else if (!attacking && child.distance > chosenDistance) {
+                chosen = moves[i];
+                chosenDistance = child.distance;
+            }
+        }
+        if (chosen.isNull()) {
+            return;
+        }
+        line.push_back(chosen);
+        state.makeMove(chosen);
+    }
+}
+
+MateResult MateSolver::solve(const BoardState& root, const SearchLimits& limits) {
+    TRACE_SPAN("mate solve");
+    limits_ = limits;
+    time_.start(limits.moveTimeMs, limits.clock);
+    aborted_ = false;
+    nodes_ = 0;
+    attacker_ = root.sideToMove();
+    std::fill(entries_.begin(), entries_.end(), Entry());
+    pathKeys_.clear();
+
+    MateResult result;
+    BoardState state = root;
+    mid(state, INF, INF, 0);
+    const Entry* entry = probe(root.key());
+    if (!aborted_ && entry && entry->phi == 0) {
+        result.status = MateStatus::PROVEN;
+        buildMainLine(root, result.mainLine);
+        if (aborted_) {
+            result.status = MateStatus::UNKNOWN;
+            result.mainLine.clear();
+        }
+    } else if (!aborted_ && entry && entry->delta == 0 && !entry->pathDependent) {
+        result.status = MateStatus::DISPROVEN;
+    }
+    result.nodes = nodes_;
+    result.timeMs = time_.elapsedMs();
+    return result;
+}
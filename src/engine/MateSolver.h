@@ -0,0 +1,93 @@
+#pragma once
+#include "Search.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+enum class MateStatus {
+    UNKNOWN,    // a limit was reached first
+    PROVEN,     // the side to move mates by force
+    DISPROVEN,  // no forced mate, without relying on a repetition or the ply limit
+};
+
+struct MateSolverSettings {
+    std::size_t tableMegabytes = 16;
+    bool checksOnly = true; // the attacker may only give check, as in compositions
+    int maxPly = 127;       // lines longer than this count as failures
+};
+
+struct MateResult {
+    MateStatus status = MateStatus::UNKNOWN;
+    // Attacker moves, defender replies, ending in mate. The defender resists
+    // as long as the proof allows; the line is the proof's, not necessarily the shortest mate.
+    std::vector<Move> mainLine;
+    std::uint64_t nodes = 0;
+    std::int64_t timeMs = 0;
+};
+
+// Depth-first proof-number search (df-pn) for forced mates by the side to move.
+//
+// Every node carries a proof number phi and a disproof number delta for the
+// side to move, kept in the solver's own table; the search always descends
+// into the most promising child under thresholds and only backs up when the
+// child's numbers exceed them. A repeated position or a line longer than
+// maxPly fails for the attacker (perpetual check loses in Xiangqi). Such a
+// verdict only holds on the path that reached it, yet it is backed up into
+// the table like any other; entries whose numbers rest on one are tagged, and
+// a disproof of the root that rests on one is reported as UNKNOWN. Proofs
+// need no tag, as a cutoff only ever takes moves away from the attacker. A
+// defender without a legal move is mated, stalemate included.
+class MateSolver {
+public:
+    static constexpr std::uint32_t INFINITE_NUMBER = 100000000;
+
+    struct Entry {
+        std::uint64_t key = 0;
+        std::uint32_t phi = 0;
+        std::uint32_t delta = 0;
+        std::uint16_t distance = 0; // plies to mate (or to escape) once solved
+        std::uint16_t pathDependent = 0; // the numbers rest on a repetition or the ply limit
+    };
+
+private:
+    static constexpr int BUCKET_ENTRIES = 2;
+
+    MateSolverSettings settings_;
+    std::vector<Entry> entries_; // buckets of BUCKET_ENTRIES
+    std::uint64_t mask_ = 0;
+    Color attacker_ = Color::RED;
+
+    std::atomic<bool> stopRequested_{false};
+    bool aborted_ = false;
+    SearchLimits limits_;
+    TimeManager time_;
+    std::uint64_t nodes_ = 0;
+    std::vector<std::uint64_t> pathKeys_;
+
+    struct Numbers {
+        std::uint32_t phi;
+        std::uint32_t delta;
+        int distance;
+        bool pathDependent = false;
+    };
+
+    int generateMoves(BoardState& state, Move* moves) const;
+    Numbers childNumbers(BoardState& child, int ply);
+    // 'replace' false only fills a free slot
+    void store(std::uint64_t key, const Numbers& numbers, bool replace = true);
+    const Entry* probe(std::uint64_t key) const;
+    void mid(BoardState& state, std::uint32_t thresholdPhi, std::uint32_t thresholdDelta, int ply);
+    void buildMainLine(BoardState state, std::vector<Move>& line);
+
+public:
+    explicit MateSolver(const MateSolverSettings& settings = MateSolverSettings());
+
+    void setSettings(const MateSolverSettings& settings);
+    const MateSolverSettings& settings() const { return settings_; }
+
+    // Honours limits.nodes and the hard deadline from moveTimeMs or the clock
+    MateResult solve(const BoardState& root, const SearchLimits& limits = SearchLimits());
+    // From any thread; sticks until resetSignals(), like Search::stop()
+    void stop() { stopRequested_.store(true, std::memory_order_relaxed); }
+    void resetSignals() { stopRequested_.store(false, std::memory_order_relaxed); }
+};
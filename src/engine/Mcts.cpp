@@ -0,0 +1,439 @@
+#include "Mcts.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+enum NodeState : std::uint8_t {
+    UNEXPANDED, EXPANDING, EXPANDED,
+    TERMINAL, // no legal move: the side to move has lost
+    FROZEN,   // the arena was full; stays a leaf
+};
+
+constexpr double VALUE_SCALE = 1 << 20;
+constexpr double EVAL_SCALE = 400.0; // centipawns per logistic unit
+constexpr std::uint64_t DEFAULT_PLAYOUTS = 20000;
+constexpr std::int64_t INFO_INTERVAL_MS = 250;
+
+double winProbability(int centipawns) {
+    return 1.0 / (1.0 + std::exp(-centipawns / EVAL_SCALE));
+}
+
+int centipawns(double winProbability) {
+    double p = std::min(std::max(winProbability, 1e-6), 1.0 - 1e-6);
+    int score = static_cast<int>(EVAL_SCALE * std::log(p / (1.0 - p)));
+    return std::min(std::max(score, -Search::TABLEBASE_WIN + 1), Search::TABLEBASE_WIN - 1);
+}
+
+} // namespace
+
+struct Mcts::Leaf {
+    BoardState state;
+    std::uint32_t path[MAX_DEPTH + 1];
+    int length = 0;      // nodes on the path, root included
+    double value = 0.0;  // win probability for the side to move at the leaf
+    bool known = false;  // decided during selection (mate or repetition)
+    int lane = -1;       // playout end state's lane in Worker::batch, -1 when mated
+    bool flipped = false; // the other side is to move at the end of the playout
+};
+
+struct Mcts::Worker {
+    std::uint64_t random;
+    std::vector<Leaf> leaves;
+    EvalBatch batch;
+    int scores[EvalBatch::MAX_LANES];
+
+    std::uint64_t next() {
+        random ^= random >> 12;
+        random ^= random << 25;
+        random ^= random >> 27;
+        return random * 0x2545F4914F6CDD1DULL;
+    }
+};
+
+Mcts::Mcts(const MctsSettings& settings) {
+    setSettings(settings);
+}
+
+void Mcts::setSettings(const MctsSettings& settings) {
+    settings_ = settings;
+    settings_.threads = std::max(1, settings_.threads);
+    settings_.batchSize = std::min(std::max(1, settings_.batchSize), EvalBatch::MAX_LANES);
+    std::size_t capacity = std::max<std::size_t>(1024, settings_.treeMegabytes * 1024 * 1024 / sizeof(Node));
+    if (capacity != capacity_) {
+        nodes_.reset(new Node[capacity]);
+        capacity_ = capacity;
+    }
+}
+
+void Mcts::resetSignals() {
+    stopRequested_.store(false, std::memory_order_relaxed);
+    ponderHit_.store(false, std::memory_order_relaxed);
+}
+
+std::uint32_t Mcts::allocate(std::uint32_t count) {
+    // A CAS loop rather than fetch_add, so failed requests never push the cursor past the end
+    std::uint32_t first = used_.load(std::memory_order_relaxed);
+    do {
+        if (first + count > capacity_) {
+            return 0; // index 0 is the root, never a child
+        }
+    } while (!used_.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+    return first;
+}
+
+bool Mcts::expand(Node& node, BoardState& state) {
+    std::uint8_t expected = UNEXPANDED;
+    if (!node.state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acquire)) {
+        return false;
+    }
+    Move moves[MoveGenerator::MAX_MOVES];
+    int count = MoveGenerator::generateLegal(state, moves);
+    if (count == 0) {
+        node.state.store(TERMINAL, std::memory_order_release);
+        return true;
+    }
+    std::uint32_t first = allocate(static_cast<std::uint32_t>(count));
+    if (first == 0) {
+        node.state.store(FROZEN, std::memory_order_release);
+        return true;
+    }
+    for (int i = 0; i < count; ++i) {
+        Node& child = nodes_[first + i];
+        child.visits.store(0, std::memory_order_relaxed);
+        child.valueSum.store(0, std::memory_order_relaxed);
+        child.firstChild.store(0, std::memory_order_relaxed);
+        child.childCount.store(0, std::memory_order_relaxed);
+        child.state.store(UNEXPANDED, std::memory_order_relaxed);
+        child.move = moves[i];
+    }
+    node.firstChild.store(first, std::memory_order_relaxed);
+    node.childCount.store(static_cast<std::uint16_t>(count), std::memory_order_relaxed);
+    node.state.store(EXPANDED, std::memory_order_release);
+    return true;
+}
+
+bool Mcts::isRepetition(const std::uint64_t* pathKeys, int length) const {
+    // Keys include the side to move, so any equal key is the same position
+    std::uint64_t key = pathKeys[length - 1];
+    for (int i = length - 3; i >= 0; i -= 2) {
+        if (pathKeys[i] == key) {
+            return true;
+        }
+    }
+    return std::find(history_.begin(), history_.end(), key) != history_.end();
+}
+
+void Mcts::selectLeaf(Leaf& leaf, Worker& worker) {
+    std::uint64_t keys[MAX_DEPTH + 1];
+    leaf.state = root_;
+    leaf.length = 0;
+    leaf.known = false;
+
+    std::uint32_t index = 0;
+    for (;;) {
+        Node& node = nodes_[index];
+        std::uint32_t earlierVisits = node.visits.fetch_add(VIRTUAL_LOSS, std::memory_order_relaxed);
+        keys[leaf.length] = leaf.state.key();
+        leaf.path[leaf.length++] = index;
+
+        if (leaf.length > 1 && isRepetition(keys, leaf.length)) {
+            leaf.value = 0.5;
+            leaf.known = true;
+            break;
+        }
+        std::uint8_t state = node.state.load(std::memory_order_acquire);
+        // A node is played out on its first visit and expanded on the next
+        if (state == UNEXPANDED && earlierVisits > 0 && expand(node, leaf.state)) {
+            state = node.state.load(std::memory_order_acquire);
+        }
+        if (state == TERMINAL) {
+            leaf.value = 0.0;
+            leaf.known = true;
+            break;
+        }
+        if (state != EXPANDED || leaf.length > MAX_DEPTH) {
+            break;
+        }
+
+        // UCT; virtual losses show up as visits without value
+        std::uint32_t first = node.firstChild.load(std::memory_order_relaxed);
+        int count = node.childCount.load(std::memory_order_relaxed);
+        double logParent = std::log(static_cast<double>(node.visits.load(std::memory_order_relaxed)) + 1.0);
+        std::uint32_t best = first;
+        double bestScore = -1.0;
+        for (int i = 0; i < count; ++i) {
+            const Node& child = nodes_[first + i];
+            if (child.state.load(std::memory_order_relaxed) == TERMINAL) {
+                // Mates the opponent: nothing else is worth exploring
+                best = first + static_cast<std::uint32_t>(i);
+                break;
+            }
+            std::uint32_t visits = child.visits.load(std::memory_order_relaxed);
+            double score;
+            if (visits == 0) {
+                // Unvisited children first, in random order
+                score = 1e9 + static_cast<double>(worker.next() & 0xFFFF);
+            } else {
+                double q = static_cast<double>(child.valueSum.load(std::memory_order_relaxed)) / (VALUE_SCALE * visits);
+                score = q + settings_.exploration * std::sqrt(logParent / visits);
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                best = first + static_cast<std::uint32_t>(i);
+            }
+        }
+        leaf.state.makeMove(nodes_[best].move);
+        index = best;
+    }
+
+    int depth = maxDepth_.load(std::memory_order_relaxed);
+    while (leaf.length - 1 > depth && !maxDepth_.compare_exchange_weak(depth, leaf.length - 1, std::memory_order_relaxed)) {
+    }
+}
+
+void Mcts::evaluateBatch(Leaf* leaves, int count, Worker& worker) const {
+    // Play every leaf out first, then score all the end states in one batch
+    worker.batch.clear();
+    for (int n = 0; n < count; ++n) {
+        Leaf& leaf = leaves[n];
+        if (leaf.known) {
+            continue;
+        }
+        BoardState state = leaf.state;
+        const Color leafSide = state.sideToMove();
+        bool mated = false;
+        for (int ply = 0; ply < settings_.playoutPlies && !mated; ++ply) {
+            // Random legal move: draw pseudo-legal moves until one does not leave the mover in check
+            Move moves[MoveGenerator::MAX_MOVES];
+            int remaining = MoveGenerator::generatePseudoLegal(state, moves);
+            mated = true;
+            while (remaining > 0) {
+                int i = static_cast<int>(worker.next() % static_cast<std::uint64_t>(remaining));
+                PieceCode captured = state.makeMove(moves[i]);
+                if (!MoveGenerator::leavesMoverInCheck(state)) {
+                    mated = false;
+                    break;
+                }
+                state.unmakeMove(moves[i], captured);
+                moves[i] = moves[--remaining];
+            }
+        }
+        leaf.flipped = state.sideToMove() != leafSide;
+        leaf.lane = mated ? -1 : worker.batch.add(state);
+        if (mated) {
+            leaf.value = leaf.flipped ? 1.0 : 0.0;
+        }
+    }
+
+    evaluator_.evaluateBatch(worker.batch, worker.scores);
+    for (int n = 0; n < count; ++n) {
+        Leaf& leaf = leaves[n];
+        if (leaf.known || leaf.lane < 0) {
+            continue;
+        }
+        double sideToMoveWins = winProbability(worker.scores[leaf.lane]);
+        leaf.value = leaf.flipped ? 1.0 - sideToMoveWins : sideToMoveWins;
+    }
+}
+
+void Mcts::backpropagate(const Leaf& leaf) {
+    // Each node holds the value for the side that moved into it
+    double value = 1.0 - leaf.value;
+    for (int i = leaf.length - 1; i >= 0; --i) {
+        Node& node = nodes_[leaf.path[i]];
+        node.valueSum.fetch_add(static_cast<std::int64_t>(value * VALUE_SCALE), std::memory_order_relaxed);
+        node.visits.fetch_sub(VIRTUAL_LOSS - 1, std::memory_order_relaxed);
+        value = 1.0 - value;
+    }
+    playouts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Mcts::limitReached() {
+    if (limits_.ponder && ponderHit_.load(std::memory_order_relaxed)) {
+        // The opponent played the expected move: our clock starts now
+        limits_.ponder = false;
+        time_.restart();
+    }
+    if (stopRequested_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (limits_.infinite || limits_.ponder) {
+        return false;
+    }
+    if (limits_.nodes > 0 && playouts() >= limits_.nodes) {
+        return true;
+    }
+    return time_.isTimed() && time_.elapsedMs() >= time_.targetMs();
+}
+
+void Mcts::work(int index) {
+    Worker worker;
+    worker.random = settings_.seed ^ (0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(index + 1));
+    worker.leaves.resize(static_cast<std::size_t>(settings_.batchSize));
+    std::int64_t nextInfoMs = INFO_INTERVAL_MS;
+
+    while (!finished_.load(std::memory_order_relaxed)) {
+        for (Leaf& leaf : worker.leaves) {
+            selectLeaf(leaf, worker);
+        }
+        evaluateBatch(worker.leaves.data(), settings_.batchSize, worker);
+        for (const Leaf& leaf : worker.leaves) {
+            backpropagate(leaf);
+        }
+        // Every thread enforces the playout budget, so the overshoot stays within one batch each
+        if (playoutBudget_ > 0 && playouts() >= playoutBudget_) {
+            finished_.store(true, std::memory_order_relaxed);
+        }
+        // The calling thread owns the other limits and the progress reports
+        if (index != 0) {
+            continue;
+        }
+        if (limitReached()) {
+            finished_.store(true, std::memory_order_relaxed);
+        } else if (onInfo_ && time_.elapsedMs() >= nextInfoMs) {
+            Move pv[MAX_DEPTH];
+            (*onInfo_)(makeInfo(pv));
+            nextInfoMs = time_.elapsedMs() + INFO_INTERVAL_MS;
+        }
+    }
+}
+
+Move Mcts::mostVisited(const Node& node) const {
+    if (node.state.load(std::memory_order_acquire) != EXPANDED) {
+        return Move();
+    }
+    std::uint32_t first = node.firstChild.load(std::memory_order_relaxed);
+    int count = node.childCount.load(std::memory_order_relaxed);
+    Move best;
+    std::uint32_t bestVisits = 0;
+    for (int i = 0; i < count; ++i) {
+        const Node& child = nodes_[first + i];
+        if (child.state.load(std::memory_order_acquire) == TERMINAL) {
+            return child.move;
+        }
+        std::uint32_t visits = child.visits.load(std::memory_order_relaxed);
+        if (best.isNull() || visits > bestVisits) {
+            best = child.move;
+            bestVisits = visits;
+        }
+    }
+    return best;
+}
+
+Move Mcts::chooseMove(std::uint64_t random) const {
+    const Node& root = nodes_[0];
+    if (settings_.temperature <= 0.0) {
+        return mostVisited(root);
+    }
+    // Visits^(1/T): low temperatures stay close to the most visited move
+    std::uint32_t first = root.firstChild.load(std::memory_order_relaxed);
+    int count = root.childCount.load(std::memory_order_relaxed);
+    double weights[MoveGenerator::MAX_MOVES];
+    double total = 0.0;
+    for (int i = 0; i < count; ++i) {
+        weights[i] = std::pow(static_cast<double>(nodes_[first + i].visits.load(std::memory_order_relaxed)),
+                              1.0 / settings_.temperature);
+        total += weights[i];
+    }
+    double pick = static_cast<double>(random >> 11) / static_cast<double>(1ULL << 53) * total;
+    for (int i = 0; i < count; ++i) {
+        pick -= weights[i];
+        if (pick < 0.0) {
+            return nodes_[first + i].move;
+        }
+    }
+    return mostVisited(root);
+}
+
+SearchInfo Mcts::makeInfo(Move* pv) const {
+    SearchInfo info;
+    info.depth = maxDepth_.load(std::memory_order_relaxed);
+    info.nodes = playouts();
+    info.timeMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+    info.pv = pv;
+
+    const Node* node = &nodes_[0];
+    while (info.pvLength < MAX_DEPTH) {
+        Move move = mostVisited(*node);
+        if (move.isNull()) {
+            break;
+        }
+        std::uint32_t first = node->firstChild.load(std::memory_order_relaxed);
+        int count = node->childCount.load(std::memory_order_relaxed);
+        for (int i = 0; i < count; ++i) {
+            if (nodes_[first + i].move == move) {
+                node = &nodes_[first + i];
+                break;
+            }
+        }
+        if (info.pvLength == 0) {
+            std::uint32_t visits = node->visits.load(std::memory_order_relaxed);
+            if (node->state.load(std::memory_order_acquire) == TERMINAL) {
+                info.score = Search::MATE_SCORE - 1;
+            } else if (visits > 0) {
+                info.score = centipawns(static_cast<double>(node->valueSum.load(std::memory_order_relaxed)) /
+                                        (VALUE_SCALE * visits));
+            }
+        }
+        pv[info.pvLength++] = move;
+    }
+    return info;
+}
+
+SearchResult Mcts::run(const BoardState& root, const std::vector<std::uint64_t>& history,
+                       const SearchLimits& limits, const Search::InfoCallback& onInfo) {
+    limits_ = limits;
+    if (limits_.nodes == 0 && limits_.moveTimeMs == 0 && !limits_.clock.isSet() && !limits_.infinite && !limits_.ponder) {
+        limits_.nodes = DEFAULT_PLAYOUTS;
+    }
+    // Ponder searches only get a budget at ponderhit, which the calling thread handles
+    playoutBudget_ = limits_.infinite || limits_.ponder ? 0 : limits_.nodes;
+    start_ = std::chrono::steady_clock::now();
+    time_.start(limits_.moveTimeMs, limits_.clock);
+    root_ = root;
+    history_ = history;
+    playouts_.store(0, std::memory_order_relaxed);
+    maxDepth_.store(0, std::memory_order_relaxed);
+    finished_.store(false, std::memory_order_relaxed);
+
+    Node& rootNode = nodes_[0];
+    rootNode.visits.store(0, std::memory_order_relaxed);
+    rootNode.valueSum.store(0, std::memory_order_relaxed);
+    rootNode.state.store(UNEXPANDED, std::memory_order_relaxed);
+    used_.store(1, std::memory_order_relaxed);
+    BoardState state = root;
+    expand(rootNode, state);
+
+    SearchResult result;
+    if (rootNode.state.load(std::memory_order_relaxed) != EXPANDED) {
+        result.score = -Search::MATE_SCORE;
+        return result;
+    }
+
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < settings_.threads; ++i) {
+        helpers.emplace_back(&Mcts::work, this, i);
+    }
+    onInfo_ = onInfo ? &onInfo : nullptr;
+    work(0);
+    for (std::thread& helper : helpers) {
+        helper.join();
+    }
+
+    Move pv[MAX_DEPTH];
+    SearchInfo info = makeInfo(pv);
+    if (onInfo) {
+        onInfo(info);
+    }
+    Worker chooser;
+    chooser.random = settings_.seed ^ root.key() ^ static_cast<std::uint64_t>(start_.time_since_epoch().count());
+    result.best = chooseMove(chooser.next());
+    result.ponder = result.best == pv[0] && info.pvLength > 1 ? pv[1] : Move();
+    result.score = info.score;
+    result.depth = info.depth;
+    result.nodes = info.nodes;
+    result.timeMs = info.timeMs;
+    return result;
+}
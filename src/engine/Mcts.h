@@ -0,0 +1,95 @@
+#pragma once
+#include "Search.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+struct MctsSettings {
+    int threads = 1;
+    int batchSize = 8;          // leaves each thread selects before evaluating them together, at most EvalBatch::MAX_LANES
+    int playoutPlies = 12;      // random plies played from a leaf before the static evaluation
+    double exploration = 1.2;   // UCT constant
+    double temperature = 0.0;   // 0 plays the most visited move; higher values pick weaker ones more often
+    std::size_t treeMegabytes = 32;
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+};
+
+// Monte Carlo Tree Search over BoardState, an alternative to the alpha-beta
+// Search with the same run()/stop() interface.
+//
+// Nodes come from a fixed arena handed out by a CAS loop on its cursor, so a
+// request that does not fit leaves the cursor where it was; a node's children
+// are one contiguous block, published by the thread that wins the expansion
+// CAS. Threads descend the shared tree without locks, adding a
+// virtual loss to every node on the path so that concurrent descents spread
+// out, then evaluate their batch of leaves with short random playouts scored
+// by the Evaluator. When the arena is full the tree stops growing and the
+// search keeps refining the visit counts it has.
+class Mcts {
+public:
+    static constexpr int MAX_DEPTH = 64;
+    static constexpr std::uint32_t VIRTUAL_LOSS = 3;
+
+    struct Node {
+        std::atomic<std::uint32_t> visits{0};   // includes virtual losses in flight
+        std::atomic<std::int64_t> valueSum{0};  // for the side that moved into the node, in 1/VALUE_SCALE wins
+        std::atomic<std::uint32_t> firstChild{0};
+        std::atomic<std::uint16_t> childCount{0};
+        std::atomic<std::uint8_t> state{0};
+        Move move;
+    };
+
+private:
+    MctsSettings settings_;
+    Evaluator evaluator_;
+    std::unique_ptr<Node[]> nodes_;
+    std::size_t capacity_ = 0;
+    std::atomic<std::uint32_t> used_{0};
+    std::atomic<std::uint64_t> playouts_{0};
+    std::atomic<int> maxDepth_{0};
+
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> ponderHit_{false};
+    std::atomic<bool> finished_{false};
+    SearchLimits limits_;   // calling thread only
+    std::uint64_t playoutBudget_ = 0; // read by every thread
+    TimeManager time_;
+    std::chrono::steady_clock::time_point start_;
+    BoardState root_;
+    std::vector<std::uint64_t> history_;
+    const Search::InfoCallback* onInfo_ = nullptr;
+
+    struct Leaf;
+    struct Worker;
+
+    std::uint32_t allocate(std::uint32_t count);
+    bool expand(Node& node, BoardState& state);
+    void selectLeaf(Leaf& leaf, Worker& worker);
+    void evaluateBatch(Leaf* leaves, int count, Worker& worker) const;
+    void backpropagate(const Leaf& leaf);
+    bool isRepetition(const std::uint64_t* pathKeys, int length) const;
+    void work(int index);
+    bool limitReached();
+    Move mostVisited(const Node& node) const;
+    Move chooseMove(std::uint64_t random) const;
+    SearchInfo makeInfo(Move* pv) const;
+
+public:
+    explicit Mcts(const MctsSettings& settings = MctsSettings());
+
+    void setSettings(const MctsSettings& settings);
+    const MctsSettings& settings() const { return settings_; }
+    void setEvaluator(const Evaluator& evaluator) { evaluator_ = evaluator; }
+
+    // Same contract as Search::run(). limits.nodes counts playouts; limits.depth is ignored.
+    SearchResult run(const BoardState& root, const std::vector<std::uint64_t>& history,
+                     const SearchLimits& limits, const Search::InfoCallback& onInfo = nullptr);
+    void stop() { stopRequested_.store(true, std::memory_order_relaxed); }
+    void ponderHit() { ponderHit_.store(true, std::memory_order_relaxed); }
+    void resetSignals();
+
+    std::uint64_t playouts() const { return playouts_.load(std::memory_order_relaxed); }
+    std::size_t treeNodes() const { return used_.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,303 @@
+#include "MoveGenerator.h"
+
+namespace {
+
+constexpr int ORTHOGONAL[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+constexpr int DIAGONAL[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+// Horse jumps as {rowDelta, colDelta}; the leg is one step along the long axis
+constexpr int HORSE_JUMPS[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+
+int rowOf(int square) { return square / BOARD_COLS + 1; }
+int colOf(int square) { return square % BOARD_COLS + 1; }
+
+bool onBoard(int row, int col) {
+    return row >= 1 && row <= BOARD_ROWS && col >= 1 && col <= BOARD_COLS;
+}
+
+bool inPalace(int row, int col, Color color) {
+    if (col < 4 || col > 6) {
+        return false;
+    }
+    return color == Color::RED ? (row >= 1 && row <= 3) : (row >= 8 && row <= BOARD_ROWS);
+}
+
+bool onOwnSide(int row, Color color) {
+    return color == Color::RED ? row <= 5 : row >= 6;
+}
+
+bool isColor(PieceCode code, Color color) {
+    return code != EMPTY_CODE && pieceCodeColor(code) == color;
+}
+
+bool isPiece(PieceCode code, PieceType type, Color color) {
+    return code == pieceCode(type, color);
+}
+
+// Emits the moves of one piece; capturesOnly skips quiet moves
+int generatePieceMoves(const BoardState& state, int from, bool capturesOnly, Move* moves) {
+    PieceCode code = state.at(from);
+    Color color = pieceCodeColor(code);
+    int row = rowOf(from);
+    int col = colOf(from);
+    int count = 0;
+
+    auto tryAdd = [&](int toRow, int toCol) {
+        int to = squareIndex(toRow, toCol);
+        PieceCode target = state.at(to);
+        if (target == EMPTY_CODE) {
+            if (!capturesOnly) {
+                moves[count++] = Move(from, to);
+            }
+        } else if (pieceCodeColor(target) != color) {
+            moves[count++] = Move(from, to);
+        }
+    };
+
+    switch (pieceCodeType(code)) {
+        case PieceType::GENERAL:
+            for (const auto& d : ORTHOGONAL) {
+                int r = row + d[0], c = col + d[1];
+                if (inPalace(r, c, color)) {
+                    tryAdd(r, c);
+                }
+            }
+            break;
+
+        case PieceType::GUARD:
+            for (const auto& d : DIAGONAL) {
+                int r = row + d[0], c = col + d[1];
+                if (inPalace(r, c, color)) {
+                    tryAdd(r, c);
+                }
+            }
+            break;
+
+        case PieceType::ELEPHANT:
+            for (const auto& d : DIAGONAL) {
+                int r = row + 2 * d[0], c = col + 2 * d[1];
+                if (onBoard(r, c) && onOwnSide(r, color) &&
+                    state.at(squareIndex(row + d[0], col + d[1])) == EMPTY_CODE) {
+                    tryAdd(r, c);
+                }
+            }
+            break;
+
+        case PieceType::HORSE:
+            for (const auto& d : HORSE_JUMPS) {
+                int r = row + d[0], c = col + d[1];
+                if (onBoard(r, c) &&
+                    state.at(squareIndex(row + (d[0] / 2), col + (d[1] / 2))) == EMPTY_CODE) {
+                    tryAdd(r, c);
+                }
+            }
+            break;
+
+        case PieceType::ROOK:
+            for (const auto& d : ORTHOGONAL) {
+                for (int r = row + d[0], c = col + d[1]; onBoard(r, c); r += d[0], c += d[1]) {
+                    tryAdd(r, c);
+                    if (state.at(squareIndex(r, c)) != EMPTY_CODE) {
+                        break;
+                    }
+                }
+            }
+            break;
+
+        case PieceType::CANNON:
+            for (const auto& d : ORTHOGONAL) {
+                int r = row + d[0], c = col + d[1];
+                for (; onBoard(r, c) && state.at(squareIndex(r, c)) == EMPTY_CODE; r += d[0], c += d[1]) {
+                    if (!capturesOnly) {
+                        moves[count++] = Move(from, squareIndex(r, c));
+                    }
+                }
+                // Jump the screen and capture the first piece beyond it
+                for (r += d[0], c += d[1]; onBoard(r, c); r += d[0], c += d[1]) {
+                    PieceCode target = state.at(squareIndex(r, c));
+                    if (target != EMPTY_CODE) {
+                        if (pieceCodeColor(target) != color) {
+                            moves[count++] = Move(from, squareIndex(r, c));
+                        }
+                        break;
+                    }
+                }
+            }
+            break;
+
+        case PieceType::SOLDIER: {
+            int forward = (color == Color::RED) ? 1 : -1;
+            if (onBoard(row + forward, col)) {
+                tryAdd(row + forward, col);
+            }
+            if (!onOwnSide(row, color)) {
+                if (col > 1) {
+                    tryAdd(row, col - 1);
+                }
+                if (col < BOARD_COLS) {
+                    tryAdd(row, col + 1);
+                }
+            }
+            break;
+        }
+    }
+    return count;
+}
+
+int generate(const BoardState& state, bool capturesOnly, Move* moves) {
+    Color side = state.sideToMove();
+    int count = 0;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        if (isColor(state.at(square), side)) {
+            count += generatePieceMoves(state, square, capturesOnly, moves + count);
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+int MoveGenerator::generatePseudoLegal(const BoardState& state, Move* moves) {
+    return generate(state, false, moves);
+}
+
+int MoveGenerator::generateCaptures(const BoardState& state, Move* moves) {
+    return generate(state, true, moves);
+}
+
+int MoveGenerator::generateLegal(BoardState& state, Move* moves) {
+    int pseudo = generatePseudoLegal(state, moves);
+    int count = 0;
+    for (int i = 0; i < pseudo; ++i) {
+        PieceCode captured = state.makeMove(moves[i]);
+        bool legal = !leavesMoverInCheck(state);
+        state.unmakeMove(moves[i], captured);
+        if (legal) {
+            moves[count++] = moves[i];
+        }
+    }
+    return count;
+}
+
+bool MoveGenerator::isPseudoLegal(const BoardState& state, Move move) {
+    if (move.isNull() || move.from() >= BOARD_SQUARES || move.to() >= BOARD_SQUARES ||
+        !isColor(state.at(move.from()), state.sideToMove())) {
+        return false;
+    }
+    Move moves[MAX_MOVES];
+    int count = generatePieceMoves(state, move.from(), false, moves);
+    for (int i = 0; i < count; ++i) {
+        if (moves[i] == move) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MoveGenerator::isLegal(BoardState& state, Move move) {
+    if (!isPseudoLegal(state, move)) {
+        return false;
+    }
+    PieceCode captured = state.makeMove(move);
+    bool legal = !leavesMoverInCheck(state);
+    state.unmakeMove(move, captured);
+    return legal;
+}
+
+bool MoveGenerator::leavesMoverInCheck(const BoardState& state) {
+    return generalsFacing(state) || isInCheck(state, opponent(state.sideToMove()));
+}
+
+bool MoveGenerator::isInCheck(const BoardState& state, Color color) {
+    int general = state.generalSquare(color);
+    return general >= 0 && isAttacked(state, general, opponent(color));
+}
+
+bool MoveGenerator::isAttacked(const BoardState& state, int square, Color attacker) {
+    int row = rowOf(square);
+    int col = colOf(square);
+
+    // Rooks on open lines, cannons behind exactly one screen
+    for (const auto& d : ORTHOGONAL) {
+        int r = row + d[0], c = col + d[1];
+        for (; onBoard(r, c); r += d[0], c += d[1]) {
+            PieceCode code = state.at(squareIndex(r, c));
+            if (code != EMPTY_CODE) {
+                if (isPiece(code, PieceType::ROOK, attacker)) {
+                    return true;
+                }
+                break;
+            }
+        }
+        for (r += d[0], c += d[1]; onBoard(r, c); r += d[0], c += d[1]) {
+            PieceCode code = state.at(squareIndex(r, c));
+            if (code != EMPTY_CODE) {
+                if (isPiece(code, PieceType::CANNON, attacker)) {
+                    return true;
+                }
+                break;
+            }
+        }
+    }
+
+    // Horses: the leg sits next to the horse, one step along its long axis
+    for (const auto& d : HORSE_JUMPS) {
+        int r = row - d[0], c = col - d[1];
+        if (onBoard(r, c) && isPiece(state.at(squareIndex(r, c)), PieceType::HORSE, attacker) &&
+            state.at(squareIndex(r + d[0] / 2, c + d[1] / 2)) == EMPTY_CODE) {
+            return true;
+        }
+    }
+
+    // Soldiers: from behind, or from the side once across the river
+    int forward = (attacker == Color::RED) ? 1 : -1;
+    int behind = row - forward;
+    if (onBoard(behind, col) && isPiece(state.at(squareIndex(behind, col)), PieceType::SOLDIER, attacker)) {
+        return true;
+    }
+    if (!onOwnSide(row, attacker)) {
+        for (int c : {col - 1, col + 1}) {
+            if (onBoard(row, c) && isPiece(state.at(squareIndex(row, c)), PieceType::SOLDIER, attacker)) {
+                return true;
+            }
+        }
+    }
+
+    // Generals and guards only ever reach squares inside their own palace
+    for (const auto& d : ORTHOGONAL) {
+        int r = row + d[0], c = col + d[1];
+        if (onBoard(r, c) && inPalace(row, col, attacker) &&
+            isPiece(state.at(squareIndex(r, c)), PieceType::GENERAL, attacker)) {
+            return true;
+        }
+    }
+    for (const auto& d : DIAGONAL) {
+        int r = row + d[0], c = col + d[1];
+        if (onBoard(r, c) && inPalace(row, col, attacker) &&
+            isPiece(state.at(squareIndex(r, c)), PieceType::GUARD, attacker)) {
+            return true;
+        }
+    }
+    for (const auto& d : DIAGONAL) {
+        int r = row + 2 * d[0], c = col + 2 * d[1];
+        if (onBoard(r, c) && onOwnSide(row, attacker) &&
+            isPiece(state.at(squareIndex(r, c)), PieceType::ELEPHANT, attacker) &&
+            state.at(squareIndex(row + d[0], col + d[1])) == EMPTY_CODE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MoveGenerator::generalsFacing(const BoardState& state) {
+    int red = state.generalSquare(Color::RED);
+    int black = state.generalSquare(Color::BLACK);
+    if (red < 0 || black < 0 || colOf(red) != colOf(black)) {
+        return false;
+    }
+    for (int square = red + BOARD_COLS; square < black; square += BOARD_COLS) {
+        if (state.at(square) != EMPTY_CODE) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "BoardState.h"
+
+// Move generation over BoardState, following the same piece rules as
+// Game::makeMove (palace, river, horse leg, elephant eye, cannon screen).
+// "Legal" additionally rejects moves that leave the mover's General attacked
+// or the two Generals facing each other, so every legal move is accepted by Game.
+class MoveGenerator {
+public:
+    static constexpr int MAX_MOVES = 128;
+
+    static int generatePseudoLegal(const BoardState& state, Move* moves);
+    static int generateCaptures(const BoardState& state, Move* moves);
+    static int generateLegal(BoardState& state, Move* moves);
+
+    static bool isPseudoLegal(const BoardState& state, Move move);
+    static bool isLegal(BoardState& state, Move move);
+    // True if the side that just moved left its General attacked / facing
+    static bool leavesMoverInCheck(const BoardState& state);
+
+    static bool isInCheck(const BoardState& state, Color color);
+    static bool isAttacked(const BoardState& state, int square, Color attacker);
+    static bool generalsFacing(const BoardState& state);
+};
@@ -0,0 +1,453 @@
+#include "Search.h"
+#include "Tablebase.h"
+#include "diagnostics/Stats.h"
+#include "diagnostics/Trace.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr int TT_MOVE_SCORE = 1 << 30;
+constexpr int CAPTURE_SCORE = 1 << 24;
+constexpr int KILLER_SCORE = 1 << 22;
+constexpr int HISTORY_LIMIT = (1 << 22) - 1;
+constexpr int GENERAL_ORDER_VALUE = 10000;
+
+int orderValue(PieceCode code) {
+    PieceType type = pieceCodeType(code);
+    return type == PieceType::GENERAL ? GENERAL_ORDER_VALUE : Evaluator::pieceValue(type);
+}
+
+// Mate scores are stored relative to the node, not the root
+int scoreToTable(int score, int ply) {
+    if (score >= Search::MATE_BOUND) {
+        return score + ply;
+    }
+    return score <= -Search::MATE_BOUND ? score - ply : score;
+}
+
+int scoreFromTable(int score, int ply) {
+    if (score >= Search::MATE_BOUND) {
+        return score - ply;
+    }
+    return score <= -Search::MATE_BOUND ? score + ply : score;
+}
+
+// Null move is unsafe when only the General and Soldiers are left (zugzwang)
+bool hasPieces(const BoardState& state, Color color) {
+    for (PieceCode code : state.squares()) {
+        if (code != EMPTY_CODE && pieceCodeColor(code) == color) {
+            PieceType type = pieceCodeType(code);
+            if (type == PieceType::ROOK || type == PieceType::HORSE || type == PieceType::CANNON) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Selection sort step: brings the best remaining move to 'index'
+void pickMove(Move* moves, int* scores, int count, int index) {
+    int best = index;
+    for (int i = index + 1; i < count; ++i) {
+        if (scores[i] > scores[best]) {
+            best = i;
+        }
+    }
+    std::swap(moves[index], moves[best]);
+    std::swap(scores[index], scores[best]);
+}
+
+} // namespace
+
+Search::Search(std::size_t hashMegabytes) : table_(hashMegabytes) {
+    clear();
+}
+
+void Search::clear() {
+    table_.clear();
+    std::memset(killers_, 0, sizeof(killers_));
+    std::memset(history_, 0, sizeof(history_));
+}
+
+void Search::resetSignals() {
+    stopRequested_.store(false, std::memory_order_relaxed);
+    ponderHit_.store(false, std::memory_order_relaxed);
+}
+
+std::int64_t Search::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+}
+
+SearchResult Search::run(const BoardState& root, const std::vector<std::uint64_t>& history,
+                         const SearchLimits& limits, const InfoCallback& onInfo) {
+    STATS_PHASE(SEARCH);
+    limits_ = limits;
+    start_ = std::chrono::steady_clock::now();
+    time_.start(limits.moveTimeMs, limits.clock);
+    nodes_ = 0;
+    aborted_ = false;
+    // Room for the deepest path up front, so the search itself never grows the vector
+    keys_.reserve(history.size() + MAX_PLY + 1);
+    keys_.assign(history.begin(), history.end());
+    keys_.push_back(root.key());
+    std::memset(killers_, 0, sizeof(killers_));
+    for (auto& row : history_) {
+        for (int& value : row) {
+            value /= 2;
+        }
+    }
+
+    SearchResult result;
+    BoardState state = root;
+    Move rootMoves[MoveGenerator::MAX_MOVES];
+    int rootCount = MoveGenerator::generateLegal(state, rootMoves);
+    if (rootCount == 0) {
+        result.score = -MATE_SCORE;
+        return result;
+    }
+    // Fallback if even the first iteration is interrupted
+    result.best = rootMoves[0];
+    const int lineCount = std::min({std::max(1, limits.multiPv), MAX_MULTI_PV, rootCount});
+    PvLine lines[MAX_MULTI_PV];
+
+    for (int depth = 1; depth < MAX_PLY; ++depth) {
+        TRACE_SPAN_ARG("search iteration", "depth", depth);
+        rootDepth_ = depth;
+        rootExcludedCount_ = 0;
+        for (int index = 0; index < lineCount && !aborted_; ++index) {
+            int score = negamax(state, depth, -INFINITE_SCORE, INFINITE_SCORE, 0, false);
+            if (aborted_) {
+                break;
+            }
+            PvLine& line = lines[index];
+            line.score = score;
+            line.length = pvLength_[0];
+            std::copy(pv_[0], pv_[0] + pvLength_[0], line.moves);
+            rootExcluded_[rootExcludedCount_++] = pv_[0][0];
+            if (onInfo) {
+                SearchInfo info;
+                info.depth = depth;
+                info.score = score;
+                info.nodes = nodes_;
+                info.timeMs = elapsedMs();
+                info.pv = line.moves;
+                info.pvLength = line.length;
+                info.multiPv = index + 1;
+                onInfo(info);
+            }
+        }
+        rootExcludedCount_ = 0;
+        // A partly searched iteration is dropped, like an interrupted single one
+        if (aborted_) {
+            break;
+        }
+        // Each pass excluded the better moves, but a later line can still come out
+        // ahead. Insertion sort: stable, and unlike std::stable_sort it never allocates
+        for (int i = 1; i < lineCount; ++i) {
+            for (int j = i; j > 0 && lines[j].score > lines[j - 1].score; --j) {
+                std::swap(lines[j], lines[j - 1]);
+            }
+        }
+        std::copy(lines, lines + lineCount, result.lines);
+        result.lineCount = lineCount;
+        const int score = lines[0].score;
+        result.best = lines[0].moves[0];
+        result.ponder = lines[0].length > 1 ? lines[0].moves[1] : Move();
+        result.score = score;
+        result.depth = depth;
+
+        if (limits_.infinite || limits_.ponder) {
+            continue;
+        }
+        // A forced mate inside the searched depth will not change
+        if ((limits_.depth > 0 && depth >= limits_.depth) ||
+            (std::abs(score) >= MATE_BOUND && MATE_SCORE - std::abs(score) <= depth) ||
+            time_.shouldStop(depth, result.best, score)) {
+            break;
+        }
+    }
+
+    result.nodes = nodes_;
+    result.timeMs = elapsedMs();
+    return result;
+}
+
+void Search::pollLimits() {
+    if (limits_.ponder && ponderHit_.load(std::memory_order_relaxed)) {
+        // The opponent played the expected move: our clock starts now
+        limits_.ponder = false;
+        time_.restart();
+        if (limits_.depth > 0 && rootDepth_ > limits_.depth) {
+            aborted_ = true;
+            return;
+        }
+    }
+    if (stopRequested_.load(std::memory_order_relaxed) || (limits_.nodes > 0 && nodes_ >= limits_.nodes)) {
+        aborted_ = true;
+    } else if (!limits_.infinite && !limits_.ponder && time_.hardDeadlineReached(nodes_)) {
+        aborted_ = true;
+    }
+}
+
+bool Search::isRepetition() const {
+    std::uint64_t key = keys_.back();
+    for (std::size_t i = keys_.size() - 1; i >= 2;) {
+        i -= 2;
+        if (keys_[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Search::isRootExcluded(Move move) const {
+    return std::find(rootExcluded_, rootExcluded_ + rootExcludedCount_, move) != rootExcluded_ + rootExcludedCount_;
+}
+
+void Search::updatePv(int ply, Move move) {
+    pv_[ply][ply] = move;
+    for (int i = ply + 1; i < pvLength_[ply + 1]; ++i) {
+        pv_[ply][i] = pv_[ply + 1][i];
+    }
+    pvLength_[ply] = std::max(pvLength_[ply + 1], ply + 1);
+}
+
+int Search::evaluate(const BoardState& state) const {
+    STATS_PHASE_SAMPLED(EVALUATION);
+    return evaluator_.evaluate(state);
+}
+
+int Search::generateMoves(const BoardState& state, Move* moves, bool capturesOnly) const {
+    STATS_PHASE_SAMPLED(MOVE_GENERATION);
+    return capturesOnly ? MoveGenerator::generateCaptures(state, moves) : MoveGenerator::generatePseudoLegal(state, moves);
+}
+
+void Search::orderMoves(const BoardState& state, Move* moves, int* scores, int count, Move ttMove, int ply) const {
+    for (int i = 0; i < count; ++i) {
+        Move move = moves[i];
+        PieceCode victim = state.at(move.to());
+        if (move == ttMove) {
+            scores[i] = TT_MOVE_SCORE;
+        } else if (victim != EMPTY_CODE) {
+            // Most valuable victim, least valuable attacker
+            scores[i] = CAPTURE_SCORE + orderValue(victim) * 16 - orderValue(state.at(move.from())) / 16;
+        } else if (move == killers_[ply][0]) {
+            scores[i] = KILLER_SCORE + 1;
+        } else if (move == killers_[ply][1]) {
+            scores[i] = KILLER_SCORE;
+        } else {
+            scores[i] = history_[move.from()][move.to()];
+        }
+    }
+}
+
+int Search::negamax(BoardState& state, int depth, int alpha, int beta, int ply, bool allowNull) {
+    pvLength_[ply] = ply;
+    ++nodes_;
+    STATS_INC(NODES);
+    pollLimits();
+    if (aborted_) {
+        return 0;
+    }
+
+    const bool pvNode = beta - alpha > 1;
+    if (ply > 0) {
+        if (isRepetition()) {
+            return 0;
+        }
+        // Mate distance pruning
+        alpha = std::max(alpha, -MATE_SCORE + ply);
+        beta = std::min(beta, MATE_SCORE - ply - 1);
+        if (alpha >= beta) {
+            return alpha;
+        }
+        if (tablebase_ && state.pieceCount() <= TablebaseMaterial::MAX_PIECES) {
+            STATS_PHASE_SAMPLED(TABLEBASE_PROBE);
+            TablebaseResult result = tablebase_->probeWdl(state);
+            if (result.found) {
+                if (result.wdl == Wdl::DRAW) {
+                    return 0;
+                }
+                return result.wdl == Wdl::WIN ? TABLEBASE_WIN - ply : -TABLEBASE_WIN + ply;
+            }
+        }
+    }
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(state);
+    }
+
+    const Color side = state.sideToMove();
+    const bool inCheck = MoveGenerator::isInCheck(state, side);
+    if (inCheck) {
+        ++depth;
+    }
+    if (depth <= 0) {
+        return quiescence(state, alpha, beta, ply);
+    }
+
+    Move ttMove;
+    TranspositionEntry entry;
+    STATS_INC(TT_PROBES);
+    if (table_.probe(state.key(), entry)) {
+        STATS_INC(TT_HITS);
+        ttMove = Move(entry.move);
+        int score = scoreFromTable(entry.score, ply);
+        if (!pvNode && ply > 0 && entry.depth >= depth &&
+            (entry.bound == Bound::EXACT || (entry.bound == Bound::LOWER && score >= beta) ||
+             (entry.bound == Bound::UPPER && score <= alpha))) {
+            return score;
+        }
+    }
+
+    if (allowNull && !pvNode && !inCheck && depth >= 3 && hasPieces(state, side) &&
+        evaluate(state) >= beta) {
+        STATS_INC(NULL_MOVE_TRIES);
+        state.makeNullMove();
+        keys_.push_back(state.key());
+        int score = -negamax(state, depth - 3, -beta, -beta + 1, ply + 1, false);
+        keys_.pop_back();
+        state.unmakeNullMove();
+        if (aborted_) {
+            return 0;
+        }
+        if (score >= beta) {
+            STATS_INC(NULL_MOVE_CUTOFFS);
+            return score >= MATE_BOUND ? beta : score;
+        }
+    }
+
+    Move moves[MoveGenerator::MAX_MOVES];
+    int scores[MoveGenerator::MAX_MOVES];
+    int count = generateMoves(state, moves, false);
+    orderMoves(state, moves, scores, count, ttMove, ply);
+
+    const int originalAlpha = alpha;
+    int bestScore = -INFINITE_SCORE;
+    Move bestMove;
+    int legal = 0;
+    for (int i = 0; i < count; ++i) {
+        pickMove(moves, scores, count, i);
+        Move move = moves[i];
+        if (ply == 0 && rootExcludedCount_ > 0 && isRootExcluded(move)) {
+            continue;
+        }
+        PieceCode captured = state.makeMove(move);
+        if (MoveGenerator::leavesMoverInCheck(state)) {
+            state.unmakeMove(move, captured);
+            continue;
+        }
+        keys_.push_back(state.key());
+        ++legal;
+        TRACE_SPAN_IF(ply == 0, "root move", "index", legal);
+
+        int score;
+        if (legal == 1) {
+            score = -negamax(state, depth - 1, -beta, -alpha, ply + 1, true);
+        } else {
+            bool quiet = captured == EMPTY_CODE && scores[i] < KILLER_SCORE;
+            int reduction = (depth >= 3 && legal > 4 && quiet && !inCheck) ? 1 : 0;
+            score = -negamax(state, depth - 1 - reduction, -alpha - 1, -alpha, ply + 1, true);
+            if (score > alpha && (reduction > 0 || score < beta)) {
+                score = -negamax(state, depth - 1, -beta, -alpha, ply + 1, true);
+            }
+        }
+        keys_.pop_back();
+        state.unmakeMove(move, captured);
+        if (aborted_) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestMove = move;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) {
+                    STATS_INC(BETA_CUTOFFS);
+                    STATS_CUTOFF(legal - 1);
+                    if (captured == EMPTY_CODE) {
+                        if (killers_[ply][0] != move) {
+                            killers_[ply][1] = killers_[ply][0];
+                            killers_[ply][0] = move;
+                        }
+                        int& value = history_[move.from()][move.to()];
+                        value = std::min(HISTORY_LIMIT, value + depth * depth);
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    if (legal == 0) {
+        // No legal move loses, stalemate included
+        return -MATE_SCORE + ply;
+    }
+
+    // A root searched without its best moves has no score of its own to store
+    if (ply > 0 || rootExcludedCount_ == 0) {
+        Bound bound = bestScore >= beta ? Bound::LOWER : (bestScore > originalAlpha ? Bound::EXACT : Bound::UPPER);
+        table_.store(state.key(), bestMove, scoreToTable(bestScore, ply), depth, bound);
+    }
+    return bestScore;
+}
+
+int Search::quiescence(BoardState& state, int alpha, int beta, int ply) {
+    pvLength_[ply] = ply;
+    ++nodes_;
+    STATS_INC(QNODES);
+    pollLimits();
+    if (aborted_) {
+        return 0;
+    }
+    if (ply >= MAX_PLY - 1) {
+        return evaluate(state);
+    }
+
+    // In check every move is searched, so mates at the horizon are seen
+    const bool inCheck = MoveGenerator::isInCheck(state, state.sideToMove());
+    int bestScore = -MATE_SCORE + ply;
+    Move moves[MoveGenerator::MAX_MOVES];
+    int scores[MoveGenerator::MAX_MOVES];
+    int count;
+    if (inCheck) {
+        count = generateMoves(state, moves, false);
+    } else {
+        bestScore = evaluate(state);
+        if (bestScore >= beta) {
+            return bestScore;
+        }
+        alpha = std::max(alpha, bestScore);
+        count = generateMoves(state, moves, true);
+    }
+    orderMoves(state, moves, scores, count, Move(), ply);
+
+    for (int i = 0; i < count; ++i) {
+        pickMove(moves, scores, count, i);
+        Move move = moves[i];
+        PieceCode captured = state.makeMove(move);
+        if (MoveGenerator::leavesMoverInCheck(state)) {
+            state.unmakeMove(move, captured);
+            continue;
+        }
+        int score = -quiescence(state, -beta, -alpha, ply + 1);
+        state.unmakeMove(move, captured);
+        if (aborted_) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                alpha = score;
+                updatePv(ply, move);
+                if (alpha >= beta) {
+                    break;
+                }
+            }
+        }
+    }
+    return bestScore;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "Evaluator.h"
+#include "MoveGenerator.h"
+#include "TimeManager.h"
+#include "TranspositionTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Tablebase;
+
+constexpr int MAX_MULTI_PV = 8;
+constexpr int MAX_PV_LENGTH = 64; // Search::MAX_PLY
+
+struct SearchLimits {
+    int depth = 0;           // plies; 0 = no limit
+    std::uint64_t nodes = 0; // 0 = no limit
+    int moveTimeMs = 0;      // 0 = no limit
+    ClockState clock;        // used when moveTimeMs is 0
+    bool infinite = false;   // ignore depth and time until stop()
+    bool ponder = false;     // like infinite until ponderHit(), then the limits apply from that moment
+    int multiPv = 1;         // best root moves to search and report, up to MAX_MULTI_PV
+};
+
+struct PvLine {
+    int score = 0;
+    int length = 0;
+    Move moves[MAX_PV_LENGTH];
+};
+
+struct SearchResult {
+    Move best;   // null when the side to move has no legal move
+    Move ponder; // expected reply, if the PV has one
+    int score = 0;
+    int depth = 0;
+    std::uint64_t nodes = 0;
+    std::int64_t timeMs = 0;
+    // Search only: the best root moves of the last completed iteration, best first
+    int lineCount = 0;
+    PvLine lines[MAX_MULTI_PV];
+};
+
+// Reported for every line of every completed iteration
+struct SearchInfo {
+    int depth = 0;
+    int score = 0;
+    std::uint64_t nodes = 0;
+    std::int64_t timeMs = 0;
+    const Move* pv = nullptr;
+    int pvLength = 0;
+    int multiPv = 1; // 1-based line number within the iteration
+};
+
+// Iterative-deepening alpha-beta (PVS, null move, late move reductions,
+// quiescence on captures) over BoardState. One Search is one thread's worth of
+// state; run several for parallel games. stop() may be called from any thread.
+//
+// With limits.multiPv = K each iteration searches the root K times, each time
+// excluding the moves already picked, so the lines share the transposition
+// table, killers and history instead of paying for K separate searches.
+class Search {
+public:
+    static constexpr int MAX_PLY = MAX_PV_LENGTH;
+    static constexpr int INFINITE_SCORE = 32000;
+    static constexpr int MATE_SCORE = 30000;
+    static constexpr int MATE_BOUND = MATE_SCORE - 2 * MAX_PLY;       // |score| >= this is a mate
+    static constexpr int TABLEBASE_WIN = MATE_BOUND - 2 * MAX_PLY;    // known win, no distance
+
+    using InfoCallback = std::function<void(const SearchInfo&)>;
+
+private:
+    TranspositionTable table_;
+    TimeManager time_;
+    Evaluator evaluator_;
+    const Tablebase* tablebase_ = nullptr;
+
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<bool> ponderHit_{false};
+    bool aborted_ = false;
+    SearchLimits limits_;
+    std::chrono::steady_clock::time_point start_;
+    std::uint64_t nodes_ = 0;
+    int rootDepth_ = 0;
+    Move rootExcluded_[MAX_MULTI_PV]; // root moves skipped by the current multi-PV pass
+    int rootExcludedCount_ = 0;
+
+    std::vector<std::uint64_t> keys_; // game history, then the current search path
+    Move killers_[MAX_PLY][2];
+    int history_[BOARD_SQUARES][BOARD_SQUARES];
+    Move pv_[MAX_PLY][MAX_PLY];
+    int pvLength_[MAX_PLY];
+
+    int negamax(BoardState& state, int depth, int alpha, int beta, int ply, bool allowNull);
+    int quiescence(BoardState& state, int alpha, int beta, int ply);
+    int evaluate(const BoardState& state) const;
+    int generateMoves(const BoardState& state, Move* moves, bool capturesOnly) const;
+    void orderMoves(const BoardState& state, Move* moves, int* scores, int count, Move ttMove, int ply) const;
+    bool isRepetition() const;
+    void pollLimits();
+    void updatePv(int ply, Move move);
+    bool isRootExcluded(Move move) const;
+
+public:
+    explicit Search(std::size_t hashMegabytes = 16);
+
+    void setHashSize(std::size_t megabytes) { table_.resize(megabytes); }
+    void setEvaluator(const Evaluator& evaluator) { evaluator_ = evaluator; }
+    // Probed at interior nodes with few enough pieces; not owned
+    void setTablebase(const Tablebase* tablebase) { tablebase_ = tablebase; }
+    // Forget everything learned (new game)
+    void clear();
+
+    // 'history' holds the keys of the positions played before 'root', for repetition draws
+    SearchResult run(const BoardState& root, const std::vector<std::uint64_t>& history,
+                     const SearchLimits& limits, const InfoCallback& onInfo = nullptr);
+    // Signals from other threads. They stick until resetSignals(), so a stop
+    // sent just before run() starts is not lost.
+    void stop() { stopRequested_.store(true, std::memory_order_relaxed); }
+    void ponderHit() { ponderHit_.store(true, std::memory_order_relaxed); }
+    void resetSignals();
+
+    std::int64_t elapsedMs() const;
+    std::uint64_t nodes() const { return nodes_; }
+};
@@ -0,0 +1,142 @@
+#include "SelfPlay.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+SelfPlayRunner::SelfPlayRunner(SelfPlayPlayer test, SelfPlayPlayer base, SelfPlaySettings settings,
+                               std::vector<std::string> openingFens)
+    : test_(std::move(test)), base_(std::move(base)), settings_(settings), openings_(std::move(openingFens)) {
+    if (openings_.empty()) {
+        openings_.emplace_back(Fen::START_POSITION);
+    }
+}
+
+SelfPlayGame SelfPlayRunner::playGame(Game& game, std::string_view openingFen, Search& red, const SearchLimits& redLimits,
+                                      Search& black, const SearchLimits& blackLimits, int maxPlies) {
+    SelfPlayGame record;
+    if (!Fen::parse(openingFen, game)) {
+        record.reason = "bad opening";
+        return record;
+    }
+
+    BoardState state = BoardState::fromGame(game);
+    std::vector<std::uint64_t> history;
+    // Remaining clock per Color when the limits carry one
+    std::int64_t clocks[2] = {redLimits.clock.remainingMs, blackLimits.clock.remainingMs};
+    for (int ply = 0; ply < maxPlies; ++ply) {
+        if (std::count(history.begin(), history.end(), state.key()) >= 2) {
+            record.result = GameResult::DRAW;
+            record.reason = "repetition";
+            return record;
+        }
+
+        Color mover = state.sideToMove();
+        SearchLimits limits = mover == Color::RED ? redLimits : blackLimits;
+        std::int64_t& clock = clocks[static_cast<int>(mover)];
+        limits.clock.remainingMs = clock;
+        SearchResult result = (mover == Color::RED ? red : black).run(state, history, limits);
+
+        Color winner = opponent(mover);
+        if (limits.clock.isSet() && (clock -= result.timeMs) < 0) {
+            record.reason = "time forfeit";
+        } else if (result.best.isNull()) {
+            record.reason = "no legal moves";
+        } else {
+            clock += limits.clock.incrementMs;
+            MoveResult moved = game.makeMove(result.best.fromPosition(), result.best.toPosition());
+            if (moved.isLegal && !moved.gameEnded) {
+                history.push_back(state.key());
+                state.makeMove(result.best);
+                record.plies = ply + 1;
+                continue;
+            }
+            record.reason = moved.isLegal ? "general captured" : "illegal move";
+            winner = moved.isLegal ? moved.winner : winner;
+        }
+        record.result = winner == Color::RED ? GameResult::RED_WIN : GameResult::BLACK_WIN;
+        return record;
+    }
+    record.result = GameResult::DRAW;
+    record.reason = "ply limit";
+    return record;
+}
+
+Sprt SelfPlayRunner::run(const GameCallback& onGame) {
+    Sprt sprt(settings_.elo0, settings_.elo1, settings_.alpha, settings_.beta);
+    std::mutex mutex;
+    std::atomic<int> nextGame{0};
+    std::atomic<bool> finished{false};
+
+    auto worker = [&]() {
+        Game game;
+        Search test(test_.hashMegabytes);
+        Search base(base_.hashMegabytes);
+        while (!finished.load()) {
+            int index = nextGame.fetch_add(1);
+            if (index >= settings_.games) {
+                break;
+            }
+            test.clear();
+            base.clear();
+
+            int opening = (index / 2) % static_cast<int>(openings_.size());
+            bool testIsRed = index % 2 == 0;
+            SelfPlayGame record = testIsRed
+                ? playGame(game, openings_[opening], test, test_.limits, base, base_.limits, settings_.maxPlies)
+                : playGame(game, openings_[opening], base, base_.limits, test, test_.limits, settings_.maxPlies);
+            record.index = index;
+            record.opening = opening;
+            record.testIsRed = testIsRed;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (record.result == GameResult::DRAW) {
+                sprt.addDraw();
+            } else if (record.result != GameResult::UNKNOWN) {
+                bool redWon = record.result == GameResult::RED_WIN;
+                if (redWon == testIsRed) {
+                    sprt.addWin();
+                } else {
+                    sprt.addLoss();
+                }
+            }
+            if (onGame) {
+                onGame(record, sprt);
+            }
+            if (settings_.stopOnSprt && sprt.decision() != Sprt::Decision::CONTINUE) {
+                finished.store(true);
+            }
+        }
+    };
+
+    unsigned threads = std::max(1u, std::min<unsigned>(settings_.threads, static_cast<unsigned>(settings_.games)));
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return sprt;
+}
+
+std::vector<std::string> SelfPlayRunner::loadOpenings(std::string_view text) {
+    std::vector<std::string> fens;
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+
+        while (!line.empty() && (line.back() == '\r' || line.back() == ' ' || line.back() == '\t')) {
+            line.remove_suffix(1);
+        }
+        while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+            line.remove_prefix(1);
+        }
+        if (!line.empty() && line.front() != '#') {
+            fens.emplace_back(line);
+        }
+    }
+    return fens;
+}
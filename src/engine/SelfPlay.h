@@ -0,0 +1,64 @@
+#pragma once
+#include "Search.h"
+#include "Sprt.h"
+#include "io/GameRecord.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+struct SelfPlayPlayer {
+    std::string name;
+    SearchLimits limits;
+    std::size_t hashMegabytes = 8;
+};
+
+struct SelfPlaySettings {
+    int games = 1000;
+    unsigned threads = 1;
+    int maxPlies = 300; // adjudicated as a draw beyond this
+    double elo0 = 0.0;
+    double elo1 = 5.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+    bool stopOnSprt = true;
+};
+
+struct SelfPlayGame {
+    int index = 0;
+    int opening = 0;
+    bool testIsRed = true;
+    GameResult result = GameResult::UNKNOWN;
+    int plies = 0;
+    const char* reason = "";
+};
+
+// Plays "test" against "base" on a pool of threads. Each worker owns a Game
+// (the referee: every engine move goes through Game::makeMove) and one Search
+// per player. Every opening is played twice with colours reversed. Games end
+// when a side has no legal move (its General would be taken next), when a
+// clock runs out, on a third repetition or at the ply limit.
+class SelfPlayRunner {
+public:
+    // Called under a lock after every game, in completion order
+    using GameCallback = std::function<void(const SelfPlayGame&, const Sprt&)>;
+
+private:
+    SelfPlayPlayer test_;
+    SelfPlayPlayer base_;
+    SelfPlaySettings settings_;
+    std::vector<std::string> openings_;
+
+public:
+    SelfPlayRunner(SelfPlayPlayer test, SelfPlayPlayer base, SelfPlaySettings settings,
+                   std::vector<std::string> openingFens);
+
+    // Stops early once the SPRT decides (if enabled); returns the final statistics
+    Sprt run(const GameCallback& onGame = nullptr);
+
+    // One game from 'openingFen'; the Game is left at the final position
+    static SelfPlayGame playGame(Game& game, std::string_view openingFen, Search& red, const SearchLimits& redLimits,
+                                 Search& black, const SearchLimits& blackLimits, int maxPlies);
+
+    // One FEN per line; blank lines and '#' comments are skipped
+    static std::vector<std::string> loadOpenings(std::string_view text);
+};
@@ -0,0 +1,47 @@
+#include "Sprt.h"
+#include <cmath>
+
+Sprt::Sprt(double elo0, double elo1, double alpha, double beta)
+    : elo0_(elo0), elo1_(elo1),
+      lowerBound_(std::log(beta / (1.0 - alpha))),
+      upperBound_(std::log((1.0 - beta) / alpha)) {}
+
+double Sprt::expectedScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double Sprt::llr() const {
+    if (games() == 0) {
+        return 0.0;
+    }
+    // One pseudo-game per outcome keeps the variance positive and stops a
+    // handful of identical early results from ending the test
+    constexpr double PRIOR = 1.0;
+    double wins = wins_ + PRIOR;
+    double draws = draws_ + PRIOR;
+    double losses = losses_ + PRIOR;
+    double n = wins + draws + losses;
+    double score = (wins + 0.5 * draws) / n;
+    double variance = (wins * (1.0 - score) * (1.0 - score) + draws * (0.5 - score) * (0.5 - score) +
+                       losses * score * score) / n;
+    double s0 = expectedScore(elo0_);
+    double s1 = expectedScore(elo1_);
+    return games() * (s1 - s0) * (2.0 * score - s0 - s1) / (2.0 * variance);
+}
+
+Sprt::Decision Sprt::decision() const {
+    double ratio = llr();
+    if (ratio >= upperBound_) {
+        return Decision::ACCEPT_H1;
+    }
+    return ratio <= lowerBound_ ? Decision::ACCEPT_H0 : Decision::CONTINUE;
+}
+
+double Sprt::eloEstimate() const {
+    if (games() == 0) {
+        return 0.0;
+    }
+    double score = (wins_ + 0.5 * draws_) / games();
+    score = std::fmin(std::fmax(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
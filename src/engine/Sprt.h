@@ -0,0 +1,42 @@
+#pragma once
+
+// Sequential probability ratio test on match results: H0 "the test engine is
+// elo0 stronger" against H1 "it is elo1 stronger", using the normal
+// approximation to the win/draw/loss distribution (as fishtest's GSPRT).
+class Sprt {
+public:
+    enum class Decision {
+        CONTINUE, ACCEPT_H0, ACCEPT_H1
+    };
+
+private:
+    double elo0_;
+    double elo1_;
+    double lowerBound_;
+    double upperBound_;
+    int wins_ = 0;
+    int draws_ = 0;
+    int losses_ = 0;
+
+public:
+    Sprt(double elo0, double elo1, double alpha = 0.05, double beta = 0.05);
+
+    // Results are from the test engine's point of view
+    void addWin() { ++wins_; }
+    void addDraw() { ++draws_; }
+    void addLoss() { ++losses_; }
+
+    int wins() const { return wins_; }
+    int draws() const { return draws_; }
+    int losses() const { return losses_; }
+    int games() const { return wins_ + draws_ + losses_; }
+
+    double llr() const;
+    double lowerBound() const { return lowerBound_; }
+    double upperBound() const { return upperBound_; }
+    Decision decision() const;
+
+    // Logistic Elo difference implied by the score so far
+    double eloEstimate() const;
+    static double expectedScore(double elo);
+};
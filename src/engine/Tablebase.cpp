@@ -0,0 +1,602 @@
+#include "Tablebase.h"
+#include "MoveGenerator.h"
+#include "diagnostics/Trace.h"
+#include "game/Fen.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+namespace {
+
+constexpr char TABLE_MAGIC[8] = {'X', 'Q', 'T', 'B', '0', '0', '0', '1'};
+constexpr std::uint16_t UNKNOWN = 0xFFFF;
+
+// WDL section symbols
+constexpr std::uint16_t WDL_DRAW = 0;
+constexpr std::uint16_t WDL_INVALID = 1;
+constexpr std::uint16_t WDL_LOSS = 2;
+constexpr std::uint16_t WDL_WIN = 3;
+
+struct TableFileHeader {
+    char magic[8];
+    char material[16];
+    std::uint64_t positionCount;
+    std::uint32_t blockSize;
+    std::uint32_t blockCount;
+    std::uint64_t wdlOffset;
+    std::uint64_t dtmOffset;
+    std::uint32_t maxPlies;
+    std::uint32_t reserved;
+};
+
+bool isDecisive(std::uint16_t value) {
+    return value >= TablebaseTable::DECISIVE && value != UNKNOWN;
+}
+
+std::uint16_t wdlSymbol(std::uint16_t value) {
+    if (value == TablebaseTable::DRAW) {
+        return WDL_DRAW;
+    }
+    if (value == TablebaseTable::INVALID) {
+        return WDL_INVALID;
+    }
+    return ((value - TablebaseTable::DECISIVE) & 1) ? WDL_WIN : WDL_LOSS;
+}
+
+// Squares a piece can ever occupy, seen from Red's side of the board
+bool isReachable(PieceCode code, int square) {
+    int row = square / BOARD_COLS + 1;
+    int col = square % BOARD_COLS + 1;
+    if (pieceCodeColor(code) == Color::BLACK) {
+        row = BOARD_ROWS + 1 - row;
+    }
+
+    switch (pieceCodeType(code)) {
+        case PieceType::GENERAL:
+            return row <= 3 && col >= 4 && col <= 6;
+        case PieceType::GUARD:
+            return (row == 2 && col == 5) || ((row == 1 || row == 3) && (col == 4 || col == 6));
+        case PieceType::ELEPHANT:
+            return ((row == 1 || row == 5) && (col == 3 || col == 7)) ||
+                   (row == 3 && (col == 1 || col == 5 || col == 9));
+        case PieceType::SOLDIER:
+            return row >= 6 || ((row == 4 || row == 5) && (col % 2 == 1));
+        default:
+            return true;
+    }
+}
+
+BoardState mirrorColors(const BoardState& state) {
+    PieceCodes codes;
+    codes.fill(EMPTY_CODE);
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        PieceCode code = state.at(square);
+        if (code != EMPTY_CODE) {
+            int row = square / BOARD_COLS + 1;
+            int col = square % BOARD_COLS + 1;
+            codes[squareIndex(BOARD_ROWS + 1 - row, col)] = code ^ BLACK_CODE_BIT;
+        }
+    }
+    return BoardState(codes, opponent(state.sideToMove()));
+}
+
+void writeVarint(std::vector<unsigned char>& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// Section layout: uint64 block offsets [blockCount + 1], then per block a
+// sequence of (varint run length, uint16 value) pairs
+template <typename Symbol>
+std::vector<unsigned char> encodeSection(const std::vector<std::uint16_t>& values, std::uint32_t blockCount, Symbol symbol) {
+    std::vector<std::uint64_t> offsets;
+    std::vector<unsigned char> data;
+    for (std::uint32_t block = 0; block < blockCount; ++block) {
+        offsets.push_back(data.size());
+        std::uint64_t begin = std::uint64_t(block) * TablebaseTable::BLOCK_SIZE;
+        std::uint64_t end = std::min<std::uint64_t>(begin + TablebaseTable::BLOCK_SIZE, values.size());
+        for (std::uint64_t i = begin; i < end;) {
+            std::uint16_t value = symbol(values[i]);
+            std::uint64_t run = i + 1;
+            while (run < end && symbol(values[run]) == value) {
+                ++run;
+            }
+            writeVarint(data, static_cast<std::uint32_t>(run - i));
+            data.push_back(static_cast<unsigned char>(value & 0xFF));
+            data.push_back(static_cast<unsigned char>(value >> 8));
+            i = run;
+        }
+    }
+    offsets.push_back(data.size());
+
+    std::vector<unsigned char> section(offsets.size() * sizeof(std::uint64_t));
+    std::memcpy(section.data(), offsets.data(), section.size());
+    section.insert(section.end(), data.begin(), data.end());
+    return section;
+}
+
+} // namespace
+
+bool TablebaseMaterial::parse(std::string_view text, TablebaseMaterial& out) {
+    TablebaseMaterial material;
+    Color color = Color::RED;
+    int generals[2] = {0, 0};
+    for (char c : text) {
+        if (c == 'v') {
+            if (color == Color::BLACK) {
+                return false;
+            }
+            color = Color::BLACK;
+            continue;
+        }
+        PieceType type;
+        Color letterColor;
+        if (!Fen::charToPiece(c, type, letterColor) || material.count_ == MAX_PIECES) {
+            return false;
+        }
+        if (type == PieceType::GENERAL) {
+            ++generals[static_cast<int>(color)];
+        }
+        material.pieces_[material.count_++] = pieceCode(type, color);
+    }
+    if (color != Color::BLACK || generals[0] != 1 || generals[1] != 1) {
+        return false;
+    }
+    material.sort();
+    out = material;
+    return true;
+}
+
+bool TablebaseMaterial::fromState(const BoardState& state, TablebaseMaterial& out) {
+    TablebaseMaterial material;
+    for (PieceCode code : state.squares()) {
+        if (code == EMPTY_CODE) {
+            continue;
+        }
+        if (material.count_ == MAX_PIECES) {
+            return false;
+        }
+        material.pieces_[material.count_++] = code;
+    }
+    if (state.generalSquare(Color::RED) < 0 || state.generalSquare(Color::BLACK) < 0) {
+        return false;
+    }
+    material.sort();
+    out = material;
+    return true;
+}
+
+void TablebaseMaterial::sort() {
+    // Red before Black, then PieceType order: Generals always lead each side
+    std::sort(pieces_.begin(), pieces_.begin() + count_);
+}
+
+TablebaseMaterial TablebaseMaterial::without(int slot) const {
+    TablebaseMaterial material = *this;
+    for (int i = slot; i + 1 < count_; ++i) {
+        material.pieces_[i] = pieces_[i + 1];
+    }
+    material.pieces_[--material.count_] = EMPTY_CODE;
+    return material;
+}
+
+TablebaseMaterial TablebaseMaterial::mirrored() const {
+    TablebaseMaterial material = *this;
+    for (int i = 0; i < count_; ++i) {
+        material.pieces_[i] = pieces_[i] ^ BLACK_CODE_BIT;
+    }
+    material.sort();
+    return material;
+}
+
+std::string TablebaseMaterial::name() const {
+    std::string text;
+    for (int i = 0; i < count_; ++i) {
+        if (i > 0 && pieceCodeColor(pieces_[i]) == Color::BLACK && pieceCodeColor(pieces_[i - 1]) == Color::RED) {
+            text += 'v';
+        }
+        text += Fen::pieceToChar(pieceCodeType(pieces_[i]), Color::RED);
+    }
+    return text;
+}
+
+bool TablebaseMaterial::operator==(const TablebaseMaterial& other) const {
+    return count_ == other.count_ && std::equal(pieces_.begin(), pieces_.begin() + count_, other.pieces_.begin());
+}
+
+TablebaseIndex::TablebaseIndex(const TablebaseMaterial& material) : material_(material) {
+    for (int slot = 0; slot < material.pieceCount(); ++slot) {
+        ordinals_[slot].fill(-1);
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            if (isReachable(material.piece(slot), square)) {
+                ordinals_[slot][square] = static_cast<std::int16_t>(squares_[slot].size());
+                squares_[slot].push_back(square);
+            }
+        }
+        perSide_ *= squares_[slot].size();
+    }
+}
+
+bool TablebaseIndex::encode(const int* slotSquares, Color sideToMove, std::uint64_t& index) const {
+    std::uint64_t value = 0;
+    for (int slot = 0; slot < material_.pieceCount(); ++slot) {
+        int ordinal = ordinals_[slot][slotSquares[slot]];
+        if (ordinal < 0) {
+            return false;
+        }
+        value = value * squares_[slot].size() + static_cast<std::uint64_t>(ordinal);
+    }
+    index = (sideToMove == Color::BLACK ? perSide_ : 0) + value;
+    return true;
+}
+
+void TablebaseIndex::decode(std::uint64_t index, int* slotSquares, Color& sideToMove) const {
+    sideToMove = (index >= perSide_) ? Color::BLACK : Color::RED;
+    index %= perSide_;
+    for (int slot = material_.pieceCount() - 1; slot >= 0; --slot) {
+        std::uint64_t radix = squares_[slot].size();
+        slotSquares[slot] = squares_[slot][index % radix];
+        index /= radix;
+    }
+}
+
+bool TablebaseIndex::slotsOf(const BoardState& state, int* slotSquares) const {
+    for (int slot = 0; slot < material_.pieceCount(); ++slot) {
+        PieceCode code = material_.piece(slot);
+        int square = (slot > 0 && material_.piece(slot - 1) == code) ? slotSquares[slot - 1] + 1 : 0;
+        while (square < BOARD_SQUARES && state.at(square) != code) {
+            ++square;
+        }
+        if (square == BOARD_SQUARES) {
+            return false;
+        }
+        slotSquares[slot] = square;
+    }
+    return true;
+}
+
+void TablebaseTable::setValues(std::vector<std::uint16_t> values) {
+    values_ = std::move(values);
+    maxPlies_ = 0;
+    for (std::uint16_t value : values_) {
+        if (isDecisive(value)) {
+            maxPlies_ = std::max(maxPlies_, value - DECISIVE);
+        }
+    }
+}
+
+std::uint16_t TablebaseTable::lookup(const unsigned char* section, std::uint32_t blockCount, std::uint64_t index) {
+    std::uint64_t block = index / BLOCK_SIZE;
+    std::uint64_t offset;
+    std::memcpy(&offset, section + block * sizeof(std::uint64_t), sizeof(offset));
+    const unsigned char* data = section + (std::uint64_t(blockCount) + 1) * sizeof(std::uint64_t) + offset;
+
+    std::uint64_t remaining = index % BLOCK_SIZE;
+    while (true) {
+        std::uint32_t run = 0;
+        for (int shift = 0;; shift += 7) {
+            unsigned char byte = *data++;
+            run |= std::uint32_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        std::uint16_t value = static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+        data += 2;
+        if (remaining < run) {
+            return value;
+        }
+        remaining -= run;
+    }
+}
+
+std::uint16_t TablebaseTable::value(std::uint64_t index) const {
+    if (!values_.empty()) {
+        return values_[index];
+    }
+    return lookup(dtmSection_, blockCount_, index);
+}
+
+bool TablebaseTable::wdl(std::uint64_t index, Wdl& out) const {
+    std::uint16_t symbol = values_.empty() ? lookup(wdlSection_, blockCount_, index) : wdlSymbol(values_[index]);
+    if (symbol == WDL_INVALID) {
+        return false;
+    }
+    out = symbol == WDL_WIN ? Wdl::WIN : (symbol == WDL_LOSS ? Wdl::LOSS : Wdl::DRAW);
+    return true;
+}
+
+bool TablebaseTable::write(const std::string& path) const {
+    if (values_.empty()) {
+        return false;
+    }
+    std::uint32_t blockCount = static_cast<std::uint32_t>((values_.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    std::vector<unsigned char> wdl = encodeSection(values_, blockCount, wdlSymbol);
+    std::vector<unsigned char> dtm = encodeSection(values_, blockCount, [](std::uint16_t value) { return value; });
+
+    TableFileHeader header = {};
+    std::memcpy(header.magic, TABLE_MAGIC, sizeof(header.magic));
+    std::string name = material().name();
+    std::memcpy(header.material, name.data(), std::min(name.size(), sizeof(header.material) - 1));
+    header.positionCount = values_.size();
+    header.blockSize = BLOCK_SIZE;
+    header.blockCount = blockCount;
+    header.wdlOffset = sizeof(header);
+    header.dtmOffset = sizeof(header) + wdl.size();
+    header.maxPlies = static_cast<std::uint32_t>(maxPlies_);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(wdl.data()), static_cast<std::streamsize>(wdl.size()));
+    out.write(reinterpret_cast<const char*>(dtm.data()), static_cast<std::streamsize>(dtm.size()));
+    return static_cast<bool>(out);
+}
+
+bool TablebaseTable::load(const std::string& path) {
+    if (!file_.open(path) || file_.size() < sizeof(TableFileHeader)) {
+        return false;
+    }
+    TableFileHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    std::uint64_t blocks = (index_.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    if (std::memcmp(header.magic, TABLE_MAGIC, sizeof(header.magic)) != 0 ||
+        std::string(header.material) != material().name() || header.positionCount != index_.size() ||
+        header.blockSize != BLOCK_SIZE || header.blockCount != blocks ||
+        header.wdlOffset >= file_.size() || header.dtmOffset >= file_.size()) {
+        file_.close();
+        return false;
+    }
+
+    values_.clear();
+    blockCount_ = header.blockCount;
+    maxPlies_ = static_cast<int>(header.maxPlies);
+    wdlSection_ = reinterpret_cast<const unsigned char*>(file_.data() + header.wdlOffset);
+    dtmSection_ = reinterpret_cast<const unsigned char*>(file_.data() + header.dtmOffset);
+    return true;
+}
+
+const TablebaseTable* Tablebase::find(const TablebaseMaterial& material) const {
+    for (const auto& table : tables_) {
+        if (table->material() == material) {
+            return table.get();
+        }
+    }
+    return nullptr;
+}
+
+bool Tablebase::generate(const TablebaseMaterial& material, unsigned threads) {
+    if (find(material)) {
+        return true;
+    }
+    // Captures lead into smaller tables, which must exist first
+    for (int slot = 0; slot < material.pieceCount(); ++slot) {
+        if (pieceCodeType(material.piece(slot)) != PieceType::GENERAL &&
+            !generate(material.without(slot), threads)) {
+            return false;
+        }
+    }
+    return generateTable(material, threads);
+}
+
+bool Tablebase::generateTable(const TablebaseMaterial& material, unsigned threads) {
+    auto table = std::make_unique<TablebaseTable>(material);
+    const TablebaseIndex& index = table->index();
+    const int pieces = material.pieceCount();
+    const std::uint64_t size = index.size();
+    threads = std::max(1u, threads);
+
+    std::array<const TablebaseTable*, TablebaseMaterial::MAX_PIECES> subTables{};
+    int longestSubTable = 0;
+    for (int slot = 0; slot < pieces; ++slot) {
+        if (pieceCodeType(material.piece(slot)) != PieceType::GENERAL) {
+            subTables[slot] = find(material.without(slot));
+            longestSubTable = std::max(longestSubTable, subTables[slot]->maxPlies());
+        }
+    }
+
+    std::vector<std::uint16_t> values(size, UNKNOWN);
+
+    // Pass 0 classifies positions (unreachable / mated or stalemated / open).
+    // Pass n > 0 only fills positions decided in exactly n plies: odd passes find
+    // wins (a move into a loss in n-1), even passes find losses (every move leads
+    // into a win in at most n-1). Updates are applied after each pass, so the
+    // threads only read the previous pass and the result is deterministic.
+    auto evaluate = [&](std::uint64_t position, int pass) -> std::uint16_t {
+        int slots[TablebaseMaterial::MAX_PIECES];
+        Color side;
+        index.decode(position, slots, side);
+
+        PieceCodes codes;
+        codes.fill(EMPTY_CODE);
+        for (int slot = 0; slot < pieces; ++slot) {
+            if (codes[slots[slot]] != EMPTY_CODE) {
+                return TablebaseTable::INVALID;
+            }
+            codes[slots[slot]] = material.piece(slot);
+        }
+        BoardState state(codes, side);
+        if (pass == 0 && MoveGenerator::leavesMoverInCheck(state)) {
+            return TablebaseTable::INVALID;
+        }
+
+        Move moves[MoveGenerator::MAX_MOVES];
+        int count = MoveGenerator::generateLegal(state, moves);
+        if (pass == 0) {
+            // No legal move loses in Xiangqi, stalemate included
+            return count == 0 ? TablebaseTable::DECISIVE : UNKNOWN;
+        }
+
+        const bool findWins = (pass & 1) != 0;
+        const Color next = opponent(side);
+        for (int i = 0; i < count; ++i) {
+            int moved = -1, captured = -1;
+            for (int slot = 0; slot < pieces; ++slot) {
+                if (slots[slot] == moves[i].from()) {
+                    moved = slot;
+                } else if (slots[slot] == moves[i].to()) {
+                    captured = slot;
+                }
+            }
+
+            int successor[TablebaseMaterial::MAX_PIECES];
+            std::uint64_t successorIndex = 0;
+            std::uint16_t value;
+            if (captured < 0) {
+                std::copy(slots, slots + pieces, successor);
+                successor[moved] = moves[i].to();
+                index.encode(successor, next, successorIndex);
+                value = values[successorIndex];
+            } else {
+                int out = 0;
+                for (int slot = 0; slot < pieces; ++slot) {
+                    if (slot != captured) {
+                        successor[out++] = (slot == moved) ? moves[i].to() : slots[slot];
+                    }
+                }
+                subTables[captured]->index().encode(successor, next, successorIndex);
+                value = subTables[captured]->value(successorIndex);
+            }
+
+            if (findWins) {
+                if (value == TablebaseTable::DECISIVE + pass - 1) {
+                    return static_cast<std::uint16_t>(TablebaseTable::DECISIVE + pass);
+                }
+            } else if (!isDecisive(value) || !((value - TablebaseTable::DECISIVE) & 1) ||
+                       value - TablebaseTable::DECISIVE > pass - 1) {
+                return UNKNOWN;
+            }
+        }
+        return findWins ? UNKNOWN : static_cast<std::uint16_t>(TablebaseTable::DECISIVE + pass);
+    };
+
+    auto runPass = [&](int pass) {
+        std::vector<std::vector<std::pair<std::uint64_t, std::uint16_t>>> updates(threads);
+        std::vector<std::thread> workers;
+        const std::uint64_t chunk = (size + threads - 1) / threads;
+        for (unsigned worker = 0; worker < threads; ++worker) {
+            workers.emplace_back([&, worker]() {
+                std::uint64_t begin = worker * chunk;
+                std::uint64_t end = std::min(size, begin + chunk);
+                for (std::uint64_t position = begin; position < end; ++position) {
+                    if (values[position] != UNKNOWN) {
+                        continue;
+                    }
+                    std::uint16_t value = evaluate(position, pass);
+                    if (value != UNKNOWN || pass == 0) {
+                        updates[worker].emplace_back(position, value);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : workers) {
+            thread.join();
+        }
+
+        std::size_t decided = 0;
+        for (const auto& list : updates) {
+            for (const auto& [position, value] : list) {
+                values[position] = value;
+                decided += (value != UNKNOWN);
+            }
+        }
+        return decided;
+    };
+
+    runPass(0);
+    int idlePasses = 0;
+    for (int pass = 1; idlePasses < 2 || pass <= longestSubTable + 2; ++pass) {
+        idlePasses = runPass(pass) == 0 ? idlePasses + 1 : 0;
+    }
+    std::replace(values.begin(), values.end(), UNKNOWN, TablebaseTable::DRAW);
+
+    table->setValues(std::move(values));
+    tables_.push_back(std::move(table));
+    return true;
+}
+
+bool Tablebase::write(const std::string& directory) const {
+    for (const auto& table : tables_) {
+        std::filesystem::path path = std::filesystem::path(directory) / fileName(table->material());
+        if (!table->write(path.string())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int Tablebase::loadDirectory(const std::string& directory) {
+    int loaded = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.path().extension() != ".xqtb") {
+            continue;
+        }
+        TablebaseMaterial material;
+        if (!TablebaseMaterial::parse(entry.path().stem().string(), material) || find(material)) {
+            continue;
+        }
+        auto table = std::make_unique<TablebaseTable>(material);
+        if (table->load(entry.path().string())) {
+            tables_.push_back(std::move(table));
+            ++loaded;
+        }
+    }
+    return loaded;
+}
+
+const TablebaseTable* Tablebase::locate(const BoardState& state, std::uint64_t& index) const {
+    TablebaseMaterial material;
+    if (!TablebaseMaterial::fromState(state, material)) {
+        return nullptr;
+    }
+
+    const TablebaseTable* table = find(material);
+    int slots[TablebaseMaterial::MAX_PIECES];
+    if (table) {
+        return table->index().slotsOf(state, slots) && table->index().encode(slots, state.sideToMove(), index)
+                   ? table : nullptr;
+    }
+    table = find(material.mirrored());
+    if (!table) {
+        return nullptr;
+    }
+    BoardState mirrored = mirrorColors(state);
+    return table->index().slotsOf(mirrored, slots) && table->index().encode(slots, mirrored.sideToMove(), index)
+               ? table : nullptr;
+}
+
+TablebaseResult Tablebase::probe(const BoardState& state) const {
+    TRACE_SPAN("tablebase probe");
+    TablebaseResult result;
+    std::uint64_t index;
+    const TablebaseTable* table = locate(state, index);
+    if (!table) {
+        return result;
+    }
+
+    std::uint16_t value = table->value(index);
+    if (value == TablebaseTable::INVALID) {
+        return result;
+    }
+    result.found = true;
+    if (isDecisive(value)) {
+        result.pliesToMate = value - TablebaseTable::DECISIVE;
+        result.wdl = (result.pliesToMate & 1) ? Wdl::WIN : Wdl::LOSS;
+    }
+    return result;
+}
+
+TablebaseResult Tablebase::probeWdl(const BoardState& state) const {
+    TRACE_SPAN("tablebase wdl probe");
+    TablebaseResult result;
+    std::uint64_t index;
+    const TablebaseTable* table = locate(state, index);
+    result.found = table && table->wdl(index, result.wdl);
+    return result;
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "BoardState.h"
+#include "io/MappedFile.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Endgame tablebases for small material sets ("KRvKAA", "KNPvK", ...).
+//
+// Each material gets a perfect index: every piece only ranges over the squares
+// its rules allow (Generals and Guards stay in the palace, Elephants on their
+// seven points, Soldiers on their forward files), which keeps tables a fraction
+// of 90^n. Tables are generated by multithreaded retrograde iteration, stored as
+// block run-length compressed WDL and DTM sections, and probed via MappedFile.
+
+class TablebaseMaterial {
+public:
+    static constexpr int MAX_PIECES = 6;
+
+private:
+    std::array<PieceCode, MAX_PIECES> pieces_{};
+    int count_ = 0;
+
+public:
+    // Red pieces, 'v', Black pieces; both sides need exactly one K
+    static bool parse(std::string_view text, TablebaseMaterial& out);
+    // Material on the board; false if it has too many pieces or lacks a General
+    static bool fromState(const BoardState& state, TablebaseMaterial& out);
+
+    int pieceCount() const { return count_; }
+    PieceCode piece(int slot) const { return pieces_[slot]; }
+    TablebaseMaterial without(int slot) const;
+    TablebaseMaterial mirrored() const; // colours swapped
+    std::string name() const;
+
+    bool operator==(const TablebaseMaterial& other) const;
+    bool operator!=(const TablebaseMaterial& other) const { return !(*this == other); }
+
+private:
+    void sort();
+};
+
+class TablebaseIndex {
+private:
+    TablebaseMaterial material_;
+    std::array<std::vector<int>, TablebaseMaterial::MAX_PIECES> squares_;
+    std::array<std::array<std::int16_t, BOARD_SQUARES>, TablebaseMaterial::MAX_PIECES> ordinals_{};
+    std::uint64_t perSide_ = 1;
+
+public:
+    explicit TablebaseIndex(const TablebaseMaterial& material);
+
+    const TablebaseMaterial& material() const { return material_; }
+    std::uint64_t size() const { return perSide_ * 2; }
+
+    // slotSquares holds one square per material slot
+    bool encode(const int* slotSquares, Color sideToMove, std::uint64_t& index) const;
+    void decode(std::uint64_t index, int* slotSquares, Color& sideToMove) const;
+    // Square of each slot in 'state' (identical pieces in ascending square order)
+    bool slotsOf(const BoardState& state, int* slotSquares) const;
+};
+
+enum class Wdl {
+    LOSS, DRAW, WIN
+};
+
+struct TablebaseResult {
+    bool found = false;
+    Wdl wdl = Wdl::DRAW;
+    int pliesToMate = 0; // for the side to move: plies until it mates (WIN) or is mated (LOSS)
+};
+
+class TablebaseTable {
+public:
+    // Stored values: 0 draw, 1 unreachable, 2 + n decisive in n plies (n odd: side to move wins)
+    static constexpr std::uint16_t DRAW = 0;
+    static constexpr std::uint16_t INVALID = 1;
+    static constexpr std::uint16_t DECISIVE = 2;
+    static constexpr std::uint32_t BLOCK_SIZE = 4096;
+
+private:
+    TablebaseIndex index_;
+    std::vector<std::uint16_t> values_; // generated in memory
+    MappedFile file_;                   // or loaded from disk
+    const unsigned char* wdlSection_ = nullptr;
+    const unsigned char* dtmSection_ = nullptr;
+    std::uint32_t blockCount_ = 0;
+    int maxPlies_ = 0;
+
+    static std::uint16_t lookup(const unsigned char* section, std::uint32_t blockCount, std::uint64_t index);
+
+public:
+    explicit TablebaseTable(const TablebaseMaterial& material) : index_(material) {}
+
+    const TablebaseMaterial& material() const { return index_.material(); }
+    const TablebaseIndex& index() const { return index_; }
+
+    std::uint16_t value(std::uint64_t index) const;
+    // False for unreachable indices
+    bool wdl(std::uint64_t index, Wdl& out) const;
+
+    // Longest decisive distance in the table
+    int maxPlies() const { return maxPlies_; }
+
+    void setValues(std::vector<std::uint16_t> values);
+    bool write(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+class Tablebase {
+private:
+    std::vector<std::unique_ptr<TablebaseTable>> tables_;
+
+    const TablebaseTable* find(const TablebaseMaterial& material) const;
+    bool generateTable(const TablebaseMaterial& material, unsigned threads);
+    // Table and index for 'state', probing the colour-mirrored table if needed
+    const TablebaseTable* locate(const BoardState& state, std::uint64_t& index) const;
+
+public:
+    static std::string fileName(const TablebaseMaterial& material) { return material.name() + ".xqtb"; }
+
+    // Generates the table and, first, every table reachable through captures
+    bool generate(const TablebaseMaterial& material, unsigned threads);
+    bool write(const std::string& directory) const;
+    // Maps every *.xqtb file in the directory; returns the number of tables loaded
+    int loadDirectory(const std::string& directory);
+
+    bool has(const TablebaseMaterial& material) const { return find(material) || find(material.mirrored()); }
+    int tableCount() const { return static_cast<int>(tables_.size()); }
+
+    TablebaseResult probe(const BoardState& state) const;
+    // Reads only the smaller WDL section; pliesToMate is left at 0
+    TablebaseResult probeWdl(const BoardState& state) const;
+};
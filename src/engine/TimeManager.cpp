@@ -0,0 +1,69 @@
+#include "TimeManager.h"
+#include <algorithm>
+
+namespace {
+
+constexpr int MAX_MOVES_TO_GO = 50;
+constexpr int SUDDEN_DEATH_MOVES = 30; // expected remaining moves without a movestogo
+constexpr int SCORE_DROP = 30;         // centipawns
+
+} // namespace
+
+void TimeManager::start(std::int64_t moveTimeMs, const ClockState& clock) {
+    start_ = std::chrono::steady_clock::now();
+    nextCheck_ = CHECK_INTERVAL;
+    scale_ = 1.0;
+    lastBest_ = Move();
+    lastScore_ = 0;
+    stableIterations_ = 0;
+    fixed_ = moveTimeMs > 0;
+
+    if (fixed_) {
+        softMs_ = hardMs_ = moveTimeMs;
+        return;
+    }
+    if (!clock.isSet()) {
+        softMs_ = hardMs_ = 0;
+        return;
+    }
+
+    std::int64_t usable = std::max<std::int64_t>(1, clock.remainingMs - MOVE_OVERHEAD_MS);
+    std::int64_t base;
+    if (clock.movesToGo > 0) {
+        base = usable * 8 / (10 * std::min(clock.movesToGo, MAX_MOVES_TO_GO));
+    } else {
+        base = usable / SUDDEN_DEATH_MOVES + clock.incrementMs * 3 / 4;
+    }
+    // Never plan to spend the last tenth of the clock on one move
+    hardMs_ = std::max<std::int64_t>(1, std::min(base * 4, usable - usable / 10));
+    softMs_ = std::max<std::int64_t>(1, std::min(base, hardMs_));
+}
+
+void TimeManager::restart() {
+    start_ = std::chrono::steady_clock::now();
+}
+
+std::int64_t TimeManager::elapsedMs() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+}
+
+std::int64_t TimeManager::targetMs() const {
+    return std::min(hardMs_, static_cast<std::int64_t>(softMs_ * scale_));
+}
+
+bool TimeManager::shouldStop(int depth, Move best, int score) {
+    if (hardMs_ == 0 || fixed_) {
+        return false;
+    }
+
+    stableIterations_ = (best == lastBest_) ? stableIterations_ + 1 : 0;
+    scale_ = stableIterations_ >= 4 ? 0.5 : (stableIterations_ >= 2 ? 0.8 : (depth > 1 ? 1.4 : 1.0));
+    if (depth > 1 && score < lastScore_ - SCORE_DROP) {
+        scale_ *= 1.5;
+    }
+    lastBest_ = best;
+    lastScore_ = score;
+
+    // The next iteration usually costs more than all previous ones together
+    return elapsedMs() * 2 >= targetMs();
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "game/Move.h"
+#include <chrono>
+#include <cstdint>
+
+// Clock state sent with a move request; 0 remaining means "no clock"
+struct ClockState {
+    std::int64_t remainingMs = 0;
+    std::int64_t incrementMs = 0;
+    int movesToGo = 0; // 0 = sudden death or increment only
+
+    bool isSet() const { return remainingMs > 0; }
+};
+
+// Turns a clock state into a soft deadline (do not start another iteration
+// after it) and a hard one (abort the search). The soft target grows when the
+// best move keeps changing or the score drops, and shrinks when the best move
+// has been stable for a few iterations. The hard deadline is checked from the
+// search loop, so the clock is only read every CHECK_INTERVAL nodes.
+class TimeManager {
+public:
+    static constexpr std::uint64_t CHECK_INTERVAL = 1024;
+    static constexpr std::int64_t MOVE_OVERHEAD_MS = 30; // latency between our clock and the server's
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::int64_t softMs_ = 0; // 0 = untimed
+    std::int64_t hardMs_ = 0;
+    double scale_ = 1.0;
+    bool fixed_ = false;
+    std::uint64_t nextCheck_ = CHECK_INTERVAL;
+    Move lastBest_;
+    int lastScore_ = 0;
+    int stableIterations_ = 0;
+
+public:
+    // moveTimeMs > 0 uses exactly that time; otherwise the clock decides
+    void start(std::int64_t moveTimeMs, const ClockState& clock);
+    // Restarts the clock, keeping the budget (ponderhit)
+    void restart();
+
+    bool isTimed() const { return hardMs_ > 0; }
+    std::int64_t softMs() const { return softMs_; }
+    std::int64_t hardMs() const { return hardMs_; }
+    // Current soft target after stability and score adjustments
+    std::int64_t targetMs() const;
+    std::int64_t elapsedMs() const;
+
+    bool hardDeadlineReached(std::uint64_t nodes) {
+        if (hardMs_ == 0 || nodes < nextCheck_) {
+            return false;
+        }
+        nextCheck_ = nodes + CHECK_INTERVAL;
+        return elapsedMs() >= hardMs_;
+    }
+
+    // Called after each completed iteration; true when another one is not worth starting
+    bool shouldStop(int depth, Move best, int score);
+};
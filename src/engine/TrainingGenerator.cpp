@@ -0,0 +1,133 @@
+#include "TrainingGenerator.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace {
+
+std::uint64_t nextRandom(std::uint64_t& state) {
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+} // namespace
+
+TrainingGenerator::TrainingGenerator(const TrainingSettings& settings, std::vector<std::string> openingFens)
+    : settings_(settings), openings_(std::move(openingFens)) {
+    if (openings_.empty()) {
+        openings_.emplace_back(Fen::START_POSITION);
+    }
+}
+
+TrainingGame TrainingGenerator::playGame(Game& game, std::string_view openingFen, Search& search,
+                                         const TrainingSettings& settings, std::uint64_t& random,
+                                         std::vector<TrainingRecord>& out) {
+    TrainingGame record;
+    if (!Fen::parse(openingFen, game)) {
+        return record;
+    }
+    BoardState state = BoardState::fromGame(game);
+    for (int ply = 0; ply < settings.randomPlies; ++ply) {
+        Move moves[MoveGenerator::MAX_MOVES];
+        int count = MoveGenerator::generateLegal(state, moves);
+        if (count == 0) {
+            return record;
+        }
+        Move move = moves[nextRandom(random) % static_cast<std::uint64_t>(count)];
+        if (game.makeMove(move.fromPosition(), move.toPosition()).gameEnded) {
+            return record;
+        }
+        state.makeMove(move);
+    }
+
+    const std::size_t first = out.size();
+    std::vector<std::uint64_t> history;
+    SearchLimits limits;
+    limits.nodes = settings.nodes;
+    Color winner = Color::RED;
+    bool decided = false;
+    for (int ply = 0; ply < settings.maxPlies; ++ply) {
+        if (std::count(history.begin(), history.end(), state.key()) >= 2) {
+            break;
+        }
+        SearchResult result = search.run(state, history, limits);
+        if (result.best.isNull()) {
+            winner = opponent(state.sideToMove());
+            decided = true;
+            break;
+        }
+
+        TrainingRecord entry = {};
+        if (PackedPosition::encode(game.getBoard(), game.getCurrentPlayer(), entry.position)) {
+            entry.score = static_cast<std::int16_t>(result.score);
+            entry.move = result.best.bits;
+            out.push_back(entry);
+        }
+
+        MoveResult moved = game.makeMove(result.best.fromPosition(), result.best.toPosition());
+        record.plies = ply + 1;
+        if (!moved.isLegal || moved.gameEnded) {
+            winner = moved.isLegal ? moved.winner : opponent(state.sideToMove());
+            decided = true;
+            break;
+        }
+        history.push_back(state.key());
+        state.makeMove(result.best);
+    }
+
+    record.result = !decided ? GameResult::DRAW : (winner == Color::RED ? GameResult::RED_WIN : GameResult::BLACK_WIN);
+    for (std::size_t i = first; i < out.size(); ++i) {
+        TrainingRecord& entry = out[i];
+        entry.result = !decided ? 0 : (entry.position.sideToMove() == winner ? 1 : -1);
+    }
+    record.positions = static_cast<int>(out.size() - first);
+    return record;
+}
+
+std::uint64_t TrainingGenerator::run(TrainingDataWriter& writer, const GameCallback& onGame) {
+    std::mutex mutex;
+    std::atomic<int> nextGame{0};
+    std::atomic<std::uint64_t> positions{0};
+
+    auto worker = [&](unsigned index) {
+        Game game;
+        Search search(settings_.hashMegabytes);
+        TrainingDataWriter::Buffer buffer(writer);
+        std::vector<TrainingRecord> records;
+        std::uint64_t random = settings_.seed ^ (0x9E3779B97F4A7C15ULL * (index + 1));
+        while (true) {
+            int gameIndex = nextGame.fetch_add(1);
+            if (gameIndex >= settings_.games) {
+                break;
+            }
+            search.clear();
+            records.clear();
+            const std::string& opening = openings_[static_cast<std::size_t>(gameIndex) % openings_.size()];
+            TrainingGame played = playGame(game, opening, search, settings_, random, records);
+            played.index = gameIndex;
+            for (const TrainingRecord& record : records) {
+                buffer.add(record);
+            }
+            positions.fetch_add(records.size());
+
+            if (onGame) {
+                std::lock_guard<std::mutex> lock(mutex);
+                onGame(played);
+            }
+        }
+    };
+
+    unsigned threads = std::max(1u, std::min<unsigned>(settings_.threads, static_cast<unsigned>(std::max(1, settings_.games))));
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back(worker, i);
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+    return positions.load();
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Search.h"
+#include "io/GameRecord.h"
+#include "io/TrainingData.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+struct TrainingSettings {
+    int games = 1000;
+    unsigned threads = 1;
+    std::uint64_t nodes = 5000; // per move
+    int maxPlies = 300;         // adjudicated as a draw beyond this
+    int randomPlies = 8;        // random moves after the opening, not recorded, for variety
+    std::size_t hashMegabytes = 8;
+    std::uint64_t seed = 0x9E3779B97F4A7C15ULL;
+};
+
+struct TrainingGame {
+    int index = 0;
+    GameResult result = GameResult::UNKNOWN; // UNKNOWN when the random moves already ended it
+    int plies = 0;
+    int positions = 0;
+};
+
+// Fixed-node self-play that writes one TrainingRecord per searched position:
+// the position packed straight from the referee Game's Board, the search score
+// and best move, and the final result from the mover's side. Each worker owns
+// a Game, a Search and a TrainingDataWriter::Buffer, so records only meet on
+// the writer's chunk append.
+class TrainingGenerator {
+public:
+    // Called under a lock after every game, in completion order
+    using GameCallback = std::function<void(const TrainingGame&)>;
+
+private:
+    TrainingSettings settings_;
+    std::vector<std::string> openings_;
+
+public:
+    TrainingGenerator(const TrainingSettings& settings, std::vector<std::string> openingFens);
+
+    // Returns the number of records handed to the writer
+    std::uint64_t run(TrainingDataWriter& writer, const GameCallback& onGame = nullptr);
+
+    // One game; appends its records to 'out'. 'random' is the worker's xorshift state.
+    static TrainingGame playGame(Game& game, std::string_view openingFen, Search& search, const TrainingSettings& settings,
+                                 std::uint64_t& random, std::vector<TrainingRecord>& out);
+};
@@ -0,0 +1,42 @@
+#include "TranspositionTable.h"
+#include "diagnostics/Trace.h"
+#include <algorithm>
+
+void TranspositionTable::resize(std::size_t megabytes) {
+    TRACE_SPAN_ARG("tt resize", "megabytes", static_cast<std::int64_t>(megabytes));
+    std::size_t count = std::max<std::size_t>(1, megabytes * 1024 * 1024 / sizeof(TranspositionEntry));
+    std::size_t power = 1;
+    while (power * 2 <= count) {
+        power *= 2;
+    }
+    entries_.assign(power, TranspositionEntry());
+    mask_ = power - 1;
+}
+
+void TranspositionTable::clear() {
+    std::fill(entries_.begin(), entries_.end(), TranspositionEntry());
+}
+
+bool TranspositionTable::probe(std::uint64_t key, TranspositionEntry& out) const {
+    const TranspositionEntry& entry = entries_[key & mask_];
+    if (entry.bound == Bound::NONE || entry.key != key) {
+        return false;
+    }
+    out = entry;
+    return true;
+}
+
+void TranspositionTable::store(std::uint64_t key, Move move, int score, int depth, Bound bound) {
+    TranspositionEntry& entry = entries_[key & mask_];
+    if (entry.key == key && entry.depth > depth && bound != Bound::EXACT) {
+        return;
+    }
+    if (move.isNull() && entry.key == key) {
+        move = Move(entry.move);
+    }
+    entry.key = key;
+    entry.move = move.bits;
+    entry.score = static_cast<std::int16_t>(score);
+    entry.depth = static_cast<std::int8_t>(depth);
+    entry.bound = bound;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "game/Move.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class Bound : std::uint8_t {
+    NONE, UPPER, LOWER, EXACT
+};
+
+struct TranspositionEntry {
+    std::uint64_t key = 0;
+    std::uint16_t move = 0;
+    std::int16_t score = 0;
+    std::int8_t depth = 0;
+    Bound bound = Bound::NONE;
+};
+
+// Single-entry buckets indexed by the low key bits; deeper results are kept
+// unless the position differs. Scores are stored as the search passes them
+// in (mate distances already made relative to the node).
+class TranspositionTable {
+private:
+    std::vector<TranspositionEntry> entries_;
+    std::uint64_t mask_ = 0;
+
+public:
+    explicit TranspositionTable(std::size_t megabytes = 16) { resize(megabytes); }
+
+    // Rounds down to a power-of-two entry count; clears the table
+    void resize(std::size_t megabytes);
+    void clear();
+
+    bool probe(std::uint64_t key, TranspositionEntry& out) const;
+    void store(std::uint64_t key, Move move, int score, int depth, Bound bound);
+};
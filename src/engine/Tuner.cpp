@@ -0,0 +1,246 @@
+#include "Tuner.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace {
+
+constexpr double LOG10_OVER_400 = 2.302585092994046 / 400.0;
+constexpr double ADAM_BETA1 = 0.9;
+constexpr double ADAM_BETA2 = 0.999;
+constexpr double ADAM_EPSILON = 1e-8;
+
+int mirroredSquare(int square) {
+    Position pos = squarePosition(square);
+    return squareIndex(BOARD_ROWS + 1 - pos.row, pos.col);
+}
+
+} // namespace
+
+std::vector<double> TuningSet::parameters(const EvalWeights& weights) {
+    std::vector<double> values(PARAMETER_COUNT);
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        values[materialParameter(static_cast<PieceType>(type))] = weights.material[type];
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            values[squareParameter(static_cast<PieceType>(type), square)] = weights.squares[type][square];
+        }
+    }
+    return values;
+}
+
+EvalWeights TuningSet::weights(const std::vector<double>& parameters) {
+    EvalWeights weights;
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        weights.material[type] = static_cast<int>(std::lround(parameters[materialParameter(static_cast<PieceType>(type))]));
+        for (int square = 0; square < BOARD_SQUARES; ++square) {
+            weights.squares[type][square] =
+                static_cast<int>(std::lround(parameters[squareParameter(static_cast<PieceType>(type), square)]));
+        }
+    }
+    return weights;
+}
+
+void TuningSet::add(const PieceCodes& codes, double redResult) {
+    // Net coefficient per parameter; a square term can cancel (a Red and a
+    // Black piece of one type on mirrored squares) and is then left out
+    int material[PIECE_TYPE_COUNT] = {};
+    int squares[BOARD_SQUARES * 2][2];
+    int squareCount = 0;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        PieceCode code = codes[square];
+        if (code == EMPTY_CODE) {
+            continue;
+        }
+        PieceType type = pieceCodeType(code);
+        bool red = pieceCodeColor(code) == Color::RED;
+        material[static_cast<int>(type)] += red ? 1 : -1;
+        int parameter = squareParameter(type, red ? square : mirroredSquare(square));
+        int sign = red ? 1 : -1;
+        bool merged = false;
+        for (int i = 0; i < squareCount && !merged; ++i) {
+            if (squares[i][0] == parameter) {
+                squares[i][1] += sign;
+                merged = true;
+            }
+        }
+        if (!merged) {
+            squares[squareCount][0] = parameter;
+            squares[squareCount][1] = sign;
+            ++squareCount;
+        }
+    }
+
+    for (int type = 0; type < PIECE_TYPE_COUNT; ++type) {
+        if (material[type] != 0) {
+            parameter_.push_back(static_cast<std::uint16_t>(type));
+            coefficient_.push_back(static_cast<std::int8_t>(material[type]));
+        }
+    }
+    for (int i = 0; i < squareCount; ++i) {
+        if (squares[i][1] != 0) {
+            parameter_.push_back(static_cast<std::uint16_t>(squares[i][0]));
+            coefficient_.push_back(static_cast<std::int8_t>(squares[i][1]));
+        }
+    }
+    begin_.push_back(static_cast<std::uint32_t>(parameter_.size()));
+    target_.push_back(static_cast<float>(redResult));
+}
+
+bool TuningSet::add(const TrainingRecord& record) {
+    PieceCodes codes;
+    Color sideToMove;
+    if (!record.position.decode(codes, sideToMove)) {
+        return false;
+    }
+    int redResult = sideToMove == Color::RED ? record.result : -record.result;
+    add(codes, (redResult + 1) * 0.5);
+    return true;
+}
+
+bool TuningSet::addFile(const std::string& path) {
+    TrainingDataReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    TrainingRecord record;
+    while (reader.next(record)) {
+        add(record);
+    }
+    return !reader.corrupt();
+}
+
+void TuningSet::clear() {
+    begin_.assign(1, 0);
+    parameter_.clear();
+    coefficient_.clear();
+    target_.clear();
+}
+
+double Tuner::pass(const std::vector<double>& parameters, double scale, std::vector<double>* gradient) const {
+    const std::size_t count = set_.size();
+    if (count == 0) {
+        if (gradient) {
+            gradient->assign(TuningSet::PARAMETER_COUNT, 0.0);
+        }
+        return 0.0;
+    }
+    const unsigned threads = static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(std::max(1u, settings_.threads), count)));
+    const double k = scale * LOG10_OVER_400;
+    std::vector<double> losses(threads, 0.0);
+    std::vector<std::vector<double>> gradients(gradient ? threads : 0, std::vector<double>(TuningSet::PARAMETER_COUNT, 0.0));
+
+    auto work = [&](unsigned slot) {
+        std::size_t begin = count * slot / threads;
+        std::size_t end = count * (slot + 1) / threads;
+        double* grad = gradient ? gradients[slot].data() : nullptr;
+        double sum = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            double predicted = 1.0 / (1.0 + std::exp(-k * set_.score(i, parameters.data())));
+            double error = predicted - set_.target(i);
+            sum += error * error;
+            if (grad) {
+                set_.accumulate(i, 2.0 * error * predicted * (1.0 - predicted) * k, grad);
+            }
+        }
+        losses[slot] = sum;
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned slot = 1; slot < threads; ++slot) {
+        workers.emplace_back(work, slot);
+    }
+    work(0);
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    double loss = 0.0;
+    for (double value : losses) {
+        loss += value;
+    }
+    if (gradient) {
+        gradient->assign(TuningSet::PARAMETER_COUNT, 0.0);
+        for (const std::vector<double>& partial : gradients) {
+            for (int p = 0; p < TuningSet::PARAMETER_COUNT; ++p) {
+                (*gradient)[p] += partial[p] / static_cast<double>(count);
+            }
+        }
+    }
+    return loss / static_cast<double>(count);
+}
+
+double Tuner::loss(const EvalWeights& weights, double scale) const {
+    return pass(TuningSet::parameters(weights), scale, nullptr);
+}
+
+double Tuner::fitScale(const EvalWeights& weights) const {
+    // Golden-section search; the loss is unimodal in K for any sensible weights
+    const std::vector<double> parameters = TuningSet::parameters(weights);
+    const double ratio = (std::sqrt(5.0) - 1.0) / 2.0;
+    double low = 0.01;
+    double high = 10.0;
+    double a = high - ratio * (high - low);
+    double b = low + ratio * (high - low);
+    double lossA = loss(parameters, a);
+    double lossB = loss(parameters, b);
+    for (int i = 0; i < 40; ++i) {
+        if (lossA < lossB) {
+            high = b;
+            b = a;
+            lossB = lossA;
+            a = high - ratio * (high - low);
+            lossA = loss(parameters, a);
+        } else {
+            low = a;
+            a = b;
+            lossA = lossB;
+            b = low + ratio * (high - low);
+            lossB = loss(parameters, b);
+        }
+    }
+    return (low + high) / 2.0;
+}
+
+TunerResult Tuner::run(const EvalWeights& start, const ProgressCallback& onProgress) const {
+    TunerResult result;
+    result.scale = settings_.scale > 0.0 ? settings_.scale : fitScale(start);
+
+    std::vector<double> parameters = TuningSet::parameters(start);
+    std::vector<double> gradient;
+    std::vector<double> firstMoment(TuningSet::PARAMETER_COUNT, 0.0);
+    std::vector<double> secondMoment(TuningSet::PARAMETER_COUNT, 0.0);
+    const int fixed = TuningSet::materialParameter(PieceType::GENERAL);
+    double beta1Power = 1.0;
+    double beta2Power = 1.0;
+
+    for (int iteration = 0; iteration < settings_.iterations; ++iteration) {
+        double loss = pass(parameters, result.scale, &gradient);
+        if (iteration == 0) {
+            result.initialLoss = loss;
+        }
+        if (onProgress) {
+            onProgress(TunerProgress{iteration, loss});
+        }
+
+        beta1Power *= ADAM_BETA1;
+        beta2Power *= ADAM_BETA2;
+        for (int p = 0; p < TuningSet::PARAMETER_COUNT; ++p) {
+            if (p == fixed) {
+                continue;
+            }
+            firstMoment[p] = ADAM_BETA1 * firstMoment[p] + (1.0 - ADAM_BETA1) * gradient[p];
+            secondMoment[p] = ADAM_BETA2 * secondMoment[p] + (1.0 - ADAM_BETA2) * gradient[p] * gradient[p];
+            double m = firstMoment[p] / (1.0 - beta1Power);
+            double v = secondMoment[p] / (1.0 - beta2Power);
+            parameters[p] -= settings_.learningRate * m / (std::sqrt(v) + ADAM_EPSILON);
+        }
+        result.iterations = iteration + 1;
+    }
+
+    result.weights = TuningSet::weights(parameters);
+    result.finalLoss = loss(result.weights, result.scale);
+    if (settings_.iterations <= 0) {
+        result.initialLoss = result.finalLoss;
+    }
+    return result;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include "Evaluator.h"
+#include "io/TrainingData.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Positions for evaluation tuning, structure-of-arrays. The Evaluator is
+// linear in its weights, so each position is stored as the sparse list of
+// (parameter, coefficient) pairs whose dot product with the parameter vector
+// is its Red score: net piece counts for the material terms and +1/-1 for the
+// square terms (Black's mirrored). A tuning pass never builds a board.
+class TuningSet {
+public:
+    // material[type], then squares[type][square]
+    static constexpr int PARAMETER_COUNT = PIECE_TYPE_COUNT + PIECE_TYPE_COUNT * BOARD_SQUARES;
+
+    static constexpr int materialParameter(PieceType type) { return static_cast<int>(type); }
+    static constexpr int squareParameter(PieceType type, int square) {
+        return PIECE_TYPE_COUNT + static_cast<int>(type) * BOARD_SQUARES + square;
+    }
+    static std::vector<double> parameters(const EvalWeights& weights);
+    // Rounds to whole centipawns
+    static EvalWeights weights(const std::vector<double>& parameters);
+
+private:
+    std::vector<std::uint32_t> begin_{0}; // position i owns features [begin_[i], begin_[i + 1])
+    std::vector<std::uint16_t> parameter_;
+    std::vector<std::int8_t> coefficient_;
+    std::vector<float> target_; // Red's result: 1 win, 0.5 draw, 0 loss
+
+public:
+    void add(const PieceCodes& codes, double redResult);
+    // Skips records whose position does not decode
+    bool add(const TrainingRecord& record);
+    // Appends every record of a TrainingDataWriter file; false if it cannot be
+    // opened or is corrupt (the records before the damage are kept)
+    bool addFile(const std::string& path);
+    void clear();
+
+    std::size_t size() const { return target_.size(); }
+    std::size_t featureCount() const { return parameter_.size(); }
+    float target(std::size_t position) const { return target_[position]; }
+
+    // Red's score in centipawns under 'parameters' (PARAMETER_COUNT values)
+    double score(std::size_t position, const double* parameters) const {
+        double sum = 0.0;
+        for (std::uint32_t i = begin_[position]; i < begin_[position + 1]; ++i) {
+            sum += coefficient_[i] * parameters[parameter_[i]];
+        }
+        return sum;
+    }
+
+    // Adds d(error)/d(score) * coefficient to each touched parameter's gradient
+    void accumulate(std::size_t position, double scale, double* gradient) const {
+        for (std::uint32_t i = begin_[position]; i < begin_[position + 1]; ++i) {
+            gradient[parameter_[i]] += scale * coefficient_[i];
+        }
+    }
+};
+
+struct TunerSettings {
+    int iterations = 500;
+    unsigned threads = 1;
+    double learningRate = 1.0; // Adam step size in centipawns
+    double scale = 0.0;        // sigmoid scale K; 0 fits it to the starting weights first
+};
+
+struct TunerProgress {
+    int iteration = 0;
+    double loss = 0.0;
+};
+
+struct TunerResult {
+    EvalWeights weights;
+    double scale = 0.0;
+    double initialLoss = 0.0;
+    double finalLoss = 0.0;
+    int iterations = 0;
+};
+
+// Texel tuning: minimises the mean squared error between each position's
+// result and sigmoid(K * score / 400) in base 10, by full-batch gradient
+// descent (Adam) on the EvalWeights. Every pass splits the positions into one
+// contiguous slice per thread, each with its own gradient array, summed at the
+// end. The General's material never changes the score and stays as it is.
+class Tuner {
+public:
+    using ProgressCallback = std::function<void(const TunerProgress&)>;
+
+private:
+    TunerSettings settings_;
+    const TuningSet& set_;
+
+    // Returns the loss; fills 'gradient' (PARAMETER_COUNT) unless it is null
+    double pass(const std::vector<double>& parameters, double scale, std::vector<double>* gradient) const;
+
+public:
+    Tuner(const TunerSettings& settings, const TuningSet& set) : settings_(settings), set_(set) {}
+
+    double loss(const EvalWeights& weights, double scale) const;
+    double loss(const std::vector<double>& parameters, double scale) const { return pass(parameters, scale, nullptr); }
+    // The K that minimises the loss of 'weights'
+    double fitScale(const EvalWeights& weights) const;
+
+    // Calls onProgress after every iteration with the loss before its step
+    TunerResult run(const EvalWeights& start, const ProgressCallback& onProgress = nullptr) const;
+};
@@ -0,0 +1,341 @@
+#include "UcciEngine.h"
+#include "diagnostics/Stats.h"
+#include "diagnostics/Trace.h"
+#include "game/Notation.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r' || text.back() == '\n')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Splits off the first whitespace-separated word
+std::string_view nextWord(std::string_view& text) {
+    text = trim(text);
+    std::size_t end = text.find_first_of(" \t");
+    std::string_view word = text.substr(0, end);
+    text = end == std::string_view::npos ? std::string_view() : trim(text.substr(end));
+    return word;
+}
+
+long long toNumber(std::string_view word) {
+    long long value = 0;
+    for (char c : word) {
+        if (c < '0' || c > '9') {
+            break;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+std::string moveText(Move move) {
+    char iccs[Notation::ICCS_LENGTH];
+    Notation::writeIccs(move.fromPosition(), move.toPosition(), iccs);
+    return std::string(iccs, Notation::ICCS_LENGTH);
+}
+
+} // namespace
+
+UcciEngine::UcciEngine(Output output) : output_(std::move(output)) {
+    Fen::parse(Fen::START_POSITION, game_);
+    state_ = BoardState::fromGame(game_);
+}
+
+UcciEngine::~UcciEngine() {
+    stopSearch();
+}
+
+void UcciEngine::send(std::string_view line) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    output_(line);
+}
+
+void UcciEngine::run(std::istream& in) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!handleCommand(line)) {
+            break;
+        }
+    }
+    stopSearch();
+}
+
+bool UcciEngine::handleCommand(std::string_view line) {
+    TRACE_SPAN("ucci command");
+    std::string_view args = line;
+    std::string_view command = nextWord(args);
+
+    if (command == "ucci") {
+        send("id name ChineseChess");
+        send("id author ChineseChess developers");
+        send("option usemillisec type check default false");
+        send("option hashsize type spin min 1 max 4096 default 16");
+        send("option bookfiles type string default <empty>");
+        send("option usebook type check default true");
+        send("option egtbpaths type string default <empty>");
+        send("option newgame type button");
+        send("option searchmode type combo default alphabeta var alphabeta var mcts");
+        send("option threads type spin min 1 max 256 default 1");
+        send("option mctstemperature type spin min 0 max 200 default 0");
+        send("option multipv type spin min 1 max " + std::to_string(MAX_MULTI_PV) + " default 1");
+        send("ucciok");
+    } else if (command == "isready") {
+        send("readyok");
+    } else if (command == "setoption") {
+        stopSearch();
+        handleSetOption(args);
+    } else if (command == "position") {
+        stopSearch();
+        if (!handlePosition(args)) {
+            send("info string invalid position");
+        }
+    } else if (command == "go") {
+        stopSearch();
+        handleGo(args);
+    } else if (command == "stop") {
+        stopSearch();
+    } else if (command == "ponderhit") {
+        search_.ponderHit();
+        if (mcts_) {
+            mcts_->ponderHit();
+        }
+        release();
+    } else if (command == "stats") {
+        sendStats();
+    } else if (command == "quit") {
+        stopSearch();
+        send("bye");
+        return false;
+    }
+    // Unknown commands (probe, banmoves, ...) are ignored, as UCCI allows
+    return true;
+}
+
+void UcciEngine::sendStats() {
+    if (!Stats::ENABLED) {
+        send("info string stats disabled (build with CHINESE_CHESS_STATS=ON)");
+        return;
+    }
+    // Counters keep running; this is a live view
+    StatsSnapshot stats = Stats::snapshot();
+    std::string line = "info string stats";
+    for (int i = 0; i < StatsSnapshot::COUNTERS; ++i) {
+        line += std::string(" ") + statCounterName(static_cast<StatCounter>(i)) + " " + std::to_string(stats.counters[i]);
+    }
+    send(line);
+
+    line = "info string stats cutoffs_by_move";
+    for (std::uint64_t count : stats.cutoffsByMoveIndex) {
+        line += " " + std::to_string(count);
+    }
+    send(line);
+
+    line = "info string stats rejections";
+    for (int i = 1; i < StatsSnapshot::REJECTIONS; ++i) {
+        line += std::string(" [") + moveRejectionName(static_cast<MoveRejection>(i)) + "] " + std::to_string(stats.rejections[i]);
+    }
+    send(line);
+
+    line = "info string stats phase_ms";
+    for (int i = 0; i < StatsSnapshot::PHASES; ++i) {
+        line += std::string(" ") + statPhaseName(static_cast<StatPhase>(i)) + " " + std::to_string(stats.phaseNanos[i] / 1000000);
+    }
+    send(line);
+}
+
+Mcts& UcciEngine::mcts() {
+    if (!mcts_) {
+        mcts_ = std::make_unique<Mcts>(mctsSettings_);
+    }
+    return *mcts_;
+}
+
+void UcciEngine::handleSetOption(std::string_view args) {
+    // UCCI: "setoption <name> <value>"; the UCI form "name <n> value <v>" is accepted too
+    std::string_view name = nextWord(args);
+    if (name == "name") {
+        name = nextWord(args);
+        std::string_view rest = args;
+        if (nextWord(rest) == "value") {
+            args = rest;
+        }
+    }
+    std::string_view value = trim(args);
+
+    if (name == "usemillisec") {
+        millisec_ = value == "true";
+    } else if (name == "hashsize") {
+        search_.setHashSize(static_cast<std::size_t>(std::max(1LL, toNumber(value))));
+    } else if (name == "bookfiles") {
+        if (!book_.open(std::string(value))) {
+            send("info string cannot open book " + std::string(value));
+        }
+    } else if (name == "usebook") {
+        useBook_ = value == "true";
+    } else if (name == "egtbpaths") {
+        int loaded = tablebase_.loadDirectory(std::string(value));
+        search_.setTablebase(loaded > 0 ? &tablebase_ : nullptr);
+        send("info string " + std::to_string(loaded) + " tablebases loaded");
+    } else if (name == "newgame") {
+        search_.clear();
+    } else if (name == "searchmode") {
+        useMcts_ = value == "mcts";
+    } else if (name == "threads") {
+        mctsSettings_.threads = static_cast<int>(std::max(1LL, toNumber(value)));
+    } else if (name == "mctstemperature") {
+        // In hundredths, as UCCI spin options are integers
+        mctsSettings_.temperature = static_cast<double>(std::max(0LL, toNumber(value))) / 100.0;
+    } else if (name == "multipv") {
+        multiPv_ = static_cast<int>(std::min<long long>(std::max(1LL, toNumber(value)), MAX_MULTI_PV));
+    }
+}
+
+bool UcciEngine::handlePosition(std::string_view args) {
+    std::string_view fen = Fen::START_POSITION;
+    std::string_view moves;
+    std::size_t movesAt = args.find("moves");
+    if (movesAt != std::string_view::npos) {
+        moves = args.substr(movesAt + 5);
+        args = args.substr(0, movesAt);
+    }
+    std::string_view kind = nextWord(args);
+    if (kind == "fen") {
+        fen = trim(args);
+    } else if (kind != "startpos") {
+        return false;
+    }
+
+    if (!Fen::parse(fen, game_)) {
+        Fen::parse(Fen::START_POSITION, game_);
+        state_ = BoardState::fromGame(game_);
+        history_.clear();
+        return false;
+    }
+    state_ = BoardState::fromGame(game_);
+    history_.clear();
+
+    for (std::string_view word = nextWord(moves); !word.empty(); word = nextWord(moves)) {
+        Position from, to;
+        if (!Notation::parseIccs(word, from, to) || !game_.makeMove(from, to).isLegal) {
+            // Back to the position before the move list rather than partway through it
+            Fen::parse(fen, game_);
+            state_ = BoardState::fromGame(game_);
+            history_.clear();
+            return false;
+        }
+        history_.push_back(state_.key());
+        state_.makeMove(Move(from, to));
+    }
+    return true;
+}
+
+void UcciEngine::handleGo(std::string_view args) {
+    SearchLimits limits;
+    bool ponder = false;
+    long long time = 0, increment = 0, movesToGo = 0;
+    const long long unit = millisec_ ? 1 : 1000;
+
+    for (std::string_view word = nextWord(args); !word.empty(); word = nextWord(args)) {
+        if (word == "ponder") {
+            ponder = true;
+        } else if (word == "infinite") {
+            limits.infinite = true;
+        } else if (word == "depth") {
+            limits.depth = static_cast<int>(toNumber(nextWord(args)));
+        } else if (word == "nodes") {
+            limits.nodes = static_cast<std::uint64_t>(toNumber(nextWord(args)));
+        } else if (word == "time") {
+            time = toNumber(nextWord(args)) * unit;
+        } else if (word == "increment") {
+            increment = toNumber(nextWord(args)) * unit;
+        } else if (word == "movestogo") {
+            movesToGo = toNumber(nextWord(args));
+        }
+    }
+    limits.clock.remainingMs = time;
+    limits.clock.incrementMs = increment;
+    limits.clock.movesToGo = static_cast<int>(movesToGo);
+    limits.ponder = ponder;
+    limits.multiPv = multiPv_;
+
+    if (useBook_ && !ponder && !limits.infinite) {
+        random_ ^= random_ << 13;
+        random_ ^= random_ >> 7;
+        random_ ^= random_ << 17;
+        Move move = book_.pick(game_, random_);
+        if (!move.isNull()) {
+            send("bestmove " + moveText(move));
+            return;
+        }
+    }
+
+    released_ = !(ponder || limits.infinite);
+    search_.resetSignals();
+    if (useMcts_) {
+        // The MCTS options are applied here, so alpha-beta play never allocates the tree
+        mcts().setSettings(mctsSettings_);
+        mcts().resetSignals();
+    }
+    searchThread_ = std::thread(&UcciEngine::searchAndReport, this, limits, !released_);
+}
+
+void UcciEngine::release() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        released_ = true;
+    }
+    waitCondition_.notify_all();
+}
+
+void UcciEngine::stopSearch() {
+    if (!searchThread_.joinable()) {
+        return;
+    }
+    search_.stop();
+    if (mcts_) {
+        mcts_->stop();
+    }
+    release();
+    searchThread_.join();
+}
+
+void UcciEngine::searchAndReport(SearchLimits limits, bool holdResult) {
+    Search::InfoCallback report = [this](const SearchInfo& info) {
+        std::string line = "info depth " + std::to_string(info.depth);
+        if (multiPv_ > 1) {
+            line += " multipv " + std::to_string(info.multiPv);
+        }
+        line += " score " + std::to_string(info.score) + " time " + std::to_string(info.timeMs) + " nodes " +
+                std::to_string(info.nodes) + " pv";
+        for (int i = 0; i < info.pvLength; ++i) {
+            line += ' ';
+            line += moveText(info.pv[i]);
+        }
+        send(line);
+    };
+    SearchResult result = useMcts_ ? mcts().run(state_, history_, limits, report)
+                                   : search_.run(state_, history_, limits, report);
+
+    if (holdResult) {
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        waitCondition_.wait(lock, [this]() { return released_; });
+    }
+
+    if (result.best.isNull()) {
+        send("nobestmove");
+    } else if (result.ponder.isNull()) {
+        send("bestmove " + moveText(result.best));
+    } else {
+        send("bestmove " + moveText(result.best) + " ponder " + moveText(result.ponder));
+    }
+}
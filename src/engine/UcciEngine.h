@@ -0,0 +1,75 @@
+#pragma once
+#include "Mcts.h"
+#include "Search.h"
+#include "Tablebase.h"
+#include "io/OpeningBook.h"
+#include <condition_variable>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// UCCI front end. Commands are handled on the caller's thread; "go" starts
+// the search on a background thread, so isready, stop and ponderhit are
+// answered while it runs. "position" replays its moves through a Game, which
+// rejects illegal input the same way it does for human players.
+class UcciEngine {
+public:
+    // Receives each output line without the newline; called from both threads
+    using Output = std::function<void(std::string_view line)>;
+
+private:
+    Output output_;
+    std::mutex outputMutex_;
+
+    Game game_;
+    BoardState state_;
+    std::vector<std::uint64_t> history_;
+
+    Search search_;
+    // Created on first use; the tree arena is large
+    std::unique_ptr<Mcts> mcts_;
+    MctsSettings mctsSettings_;
+    bool useMcts_ = false;
+    int multiPv_ = 1;
+    OpeningBook book_;
+    bool useBook_ = true;
+    Tablebase tablebase_;
+    bool millisec_ = false;
+    std::uint64_t random_ = 0x2545F4914F6CDD1DULL;
+
+    std::thread searchThread_;
+    std::mutex waitMutex_;
+    std::condition_variable waitCondition_;
+    bool released_ = false; // infinite / ponder searches hold bestmove until stop or ponderhit
+
+    void send(std::string_view line);
+    Mcts& mcts();
+    void handleSetOption(std::string_view args);
+    // Non-standard "stats" command: live instrumentation counters as info strings
+    void sendStats();
+    bool handlePosition(std::string_view args);
+    void handleGo(std::string_view args);
+    void release();
+    void searchAndReport(SearchLimits limits, bool holdResult);
+
+public:
+    explicit UcciEngine(Output output);
+    ~UcciEngine();
+
+    UcciEngine(const UcciEngine&) = delete;
+    UcciEngine& operator=(const UcciEngine&) = delete;
+
+    // Reads commands until "quit" or end of input
+    void run(std::istream& in);
+    // Returns false on "quit"
+    bool handleCommand(std::string_view line);
+    // Stops any running search and waits for its bestmove
+    void stopSearch();
+    bool isSearching() const { return searchThread_.joinable(); }
+
+    const Game& game() const { return game_; }
+};
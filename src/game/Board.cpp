@@ -1,10 +1,12 @@
 #include "Board.h"
+#include "PieceFactory.h"
 
 Board::Board() {
     clear();
 }
 
 void Board::clear() {
+    ++version_;
     for (auto& row : grid_) {
         for (auto& cell : row) {
             cell.reset();
@@ -14,10 +16,19 @@ void Board::clear() {
 
 void Board::setPiece(const Position& pos, std::unique_ptr<Piece> piece) {
     if (isValidPosition(pos)) {
+        ++version_;
         grid_[pos.row - 1][pos.col - 1] = std::move(piece);
     }
 }
 
+std::unique_ptr<Piece> Board::takePiece(const Position& pos) {
+    if (isValidPosition(pos)) {
+        ++version_;
+        return std::move(grid_[pos.row - 1][pos.col - 1]);
+    }
+    return nullptr;
+}
+
 Piece* Board::getPiece(const Position& pos) const {
     if (isValidPosition(pos)) {
         return grid_[pos.row - 1][pos.col - 1].get();
@@ -58,3 +69,51 @@ bool Board::isPathClear(const Position& from, const Position& to) const {
 bool Board::isValidPosition(const Position& pos) const {
     return pos.row >= 1 && pos.row <= 10 && pos.col >= 1 && pos.col <= 9;
 }
+
+PieceCodes Board::toCodes() const {
+    PieceCodes codes;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        const Piece* piece = grid_[square / BOARD_COLS][square % BOARD_COLS].get();
+        codes[square] = piece ? pieceCode(piece->getType(), piece->getColor()) : EMPTY_CODE;
+    }
+    return codes;
+}
+
+void Board::loadCodes(const PieceCodes& codes) {
+    // Pieces are immutable (type + color), so the ones already on the board are
+    // reused instead of being freed and reallocated on every load
+    constexpr int MAX_SPARE_PIECES = 32;
+    std::array<std::unique_ptr<Piece>, MAX_SPARE_PIECES> spare;
+    int spareCount = 0;
+    ++version_;
+
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        auto& cell = grid_[square / BOARD_COLS][square % BOARD_COLS];
+        if (cell && pieceCode(cell->getType(), cell->getColor()) != codes[square]) {
+            if (spareCount < MAX_SPARE_PIECES) {
+                spare[spareCount++] = std::move(cell);
+            } else {
+                cell.reset();
+            }
+        }
+    }
+
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        auto& cell = grid_[square / BOARD_COLS][square % BOARD_COLS];
+        PieceCode code = codes[square];
+        if (code == EMPTY_CODE || cell) {
+            continue;
+        }
+
+        for (int i = 0; i < spareCount; ++i) {
+            if (pieceCode(spare[i]->getType(), spare[i]->getColor()) == code) {
+                cell = std::move(spare[i]);
+                spare[i] = std::move(spare[--spareCount]);
+                break;
+            }
+        }
+        if (!cell) {
+            cell = PieceFactory::create(pieceCodeType(code), pieceCodeColor(code));
+        }
+    }
+}
@@ -1,11 +1,14 @@
 #pragma once
 #include "Piece.h"
+#include "PieceCode.h"
 #include <array>
+#include <cstdint>
 #include <memory>
 
 class Board {
 private:
     std::array<std::array<std::unique_ptr<Piece>, 9>, 10> grid_;
+    std::uint32_t version_ = 0;
     
 public:
     Board();
@@ -13,9 +16,17 @@ public:
     
     void clear();
     void setPiece(const Position& pos, std::unique_ptr<Piece> piece);
+    std::unique_ptr<Piece> takePiece(const Position& pos);
     Piece* getPiece(const Position& pos) const;
     bool isEmpty(const Position& pos) const;
     bool isPathClear(const Position& from, const Position& to) const;
     
+    // Value-type view of the board; loadCodes() recycles the pieces already placed
+    PieceCodes toCodes() const;
+    void loadCodes(const PieceCodes& codes);
+    
     bool isValidPosition(const Position& pos) const;
+
+    // Bumped by every edit, so caches of the position can tell it changed
+    std::uint32_t version() const { return version_; }
 };
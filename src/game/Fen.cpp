@@ -0,0 +1,151 @@
+#include "Fen.h"
+#include <cstring>
+
+namespace {
+
+bool parseBoard(std::string_view fen, std::size_t& pos, PieceCodes& cells) {
+    cells.fill(EMPTY_CODE);
+    int rank = 0; // 0 = row 10 (Black's back rank)
+    int file = 0;
+
+    for (; pos < fen.size() && fen[pos] != ' '; ++pos) {
+        char c = fen[pos];
+        if (c == '/') {
+            if (file != BOARD_COLS || ++rank >= BOARD_ROWS) {
+                return false;
+            }
+            file = 0;
+        } else if (c >= '1' && c <= '9') {
+            file += c - '0';
+            if (file > BOARD_COLS) {
+                return false;
+            }
+        } else {
+            PieceType type;
+            Color color;
+            if (!Fen::charToPiece(c, type, color) || file >= BOARD_COLS) {
+                return false;
+            }
+            cells[squareIndex(BOARD_ROWS - rank, file + 1)] = pieceCode(type, color);
+            ++file;
+        }
+    }
+
+    return rank == BOARD_ROWS - 1 && file == BOARD_COLS;
+}
+
+bool parseSideToMove(std::string_view fen, std::size_t pos, Color& sideToMove) {
+    while (pos < fen.size() && fen[pos] == ' ') {
+        ++pos;
+    }
+    if (pos == fen.size()) {
+        // Side to move is optional; default to Red like Game::reset()
+        sideToMove = Color::RED;
+        return true;
+    }
+
+    char c = fen[pos];
+    if (c == 'w' || c == 'r') {
+        sideToMove = Color::RED;
+    } else if (c == 'b') {
+        sideToMove = Color::BLACK;
+    } else {
+        return false;
+    }
+    // Castling/en passant/move counters are meaningless in Xiangqi and are ignored
+    return pos + 1 == fen.size() || fen[pos + 1] == ' ';
+}
+
+} // namespace
+
+bool Fen::parse(std::string_view fen, Game& game) {
+    Color sideToMove;
+    if (!parse(fen, game.getBoard(), sideToMove)) {
+        return false;
+    }
+    game.startFromBoard(sideToMove);
+    return true;
+}
+
+bool Fen::parse(std::string_view fen, Board& board, Color& sideToMove) {
+    std::size_t pos = 0;
+    while (pos < fen.size() && fen[pos] == ' ') {
+        ++pos;
+    }
+
+    // Validate everything before touching the board so a bad string leaves it intact
+    PieceCodes cells;
+    Color side;
+    if (!parseBoard(fen, pos, cells) || !parseSideToMove(fen, pos, side)) {
+        return false;
+    }
+
+    board.loadCodes(cells);
+    sideToMove = side;
+    return true;
+}
+
+std::size_t Fen::write(const Game& game, char* buffer, std::size_t capacity) {
+    return write(game.getBoard(), game.getCurrentPlayer(), buffer, capacity);
+}
+
+std::size_t Fen::write(const Board& board, Color sideToMove, char* buffer, std::size_t capacity) {
+    char out[MAX_LENGTH];
+    std::size_t length = 0;
+
+    for (int row = BOARD_ROWS; row >= 1; --row) {
+        int emptyRun = 0;
+        for (int col = 1; col <= BOARD_COLS; ++col) {
+            const Piece* piece = board.getPiece(Position(row, col));
+            if (!piece) {
+                ++emptyRun;
+                continue;
+            }
+            if (emptyRun > 0) {
+                out[length++] = static_cast<char>('0' + emptyRun);
+                emptyRun = 0;
+            }
+            out[length++] = pieceToChar(piece->getType(), piece->getColor());
+        }
+        if (emptyRun > 0) {
+            out[length++] = static_cast<char>('0' + emptyRun);
+        }
+        if (row > 1) {
+            out[length++] = '/';
+        }
+    }
+
+    static constexpr char RED_SUFFIX[] = " w - - 0 1";
+    static constexpr char BLACK_SUFFIX[] = " b - - 0 1";
+    const char* suffix = (sideToMove == Color::RED) ? RED_SUFFIX : BLACK_SUFFIX;
+    std::memcpy(out + length, suffix, sizeof(RED_SUFFIX) - 1);
+    length += sizeof(RED_SUFFIX) - 1;
+
+    if (!buffer || capacity < length + 1) {
+        return 0;
+    }
+    std::memcpy(buffer, out, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+char Fen::pieceToChar(PieceType type, Color color) {
+    static constexpr char LETTERS[] = "KARNCBP";
+    char c = LETTERS[static_cast<int>(type)];
+    return (color == Color::RED) ? c : static_cast<char>(c - 'A' + 'a');
+}
+
+bool Fen::charToPiece(char c, PieceType& type, Color& color) {
+    color = (c >= 'A' && c <= 'Z') ? Color::RED : Color::BLACK;
+    switch (c) {
+        case 'K': case 'k': type = PieceType::GENERAL; return true;
+        case 'A': case 'a': type = PieceType::GUARD; return true;
+        case 'R': case 'r': type = PieceType::ROOK; return true;
+        // 'H'/'E' are the WXF-style aliases some datasets use
+        case 'N': case 'n': case 'H': case 'h': type = PieceType::HORSE; return true;
+        case 'C': case 'c': type = PieceType::CANNON; return true;
+        case 'B': case 'b': case 'E': case 'e': type = PieceType::ELEPHANT; return true;
+        case 'P': case 'p': type = PieceType::SOLDIER; return true;
+        default: return false;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "Game.h"
+#include <cstddef>
+#include <string_view>
+
+// Reader/writer for the standard Xiangqi FEN dialect, e.g.
+//   rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1
+// The first rank in the string is Black's back rank (row 10), files run a..i (col 1..9).
+// Neither direction allocates: parsing works on a string_view and a stack copy of the
+// board, and Board::loadCodes() recycles the pieces already placed.
+class Fen {
+public:
+    static constexpr std::string_view START_POSITION =
+        "rnbakabnr/9/1c5c1/p1p1p1p1p/9/9/P1P1P1P1P/1C5C1/9/RNBAKABNR w - - 0 1";
+    // Longest FEN write() can produce, including the terminating NUL
+    static constexpr std::size_t MAX_LENGTH = 128;
+
+    // Returns false (leaving the target untouched) if the string is malformed
+    static bool parse(std::string_view fen, Game& game);
+    static bool parse(std::string_view fen, Board& board, Color& sideToMove);
+
+    // Writes a NUL-terminated FEN into buffer and returns its length,
+    // or 0 if capacity is too small
+    static std::size_t write(const Game& game, char* buffer, std::size_t capacity);
+    static std::size_t write(const Board& board, Color sideToMove, char* buffer, std::size_t capacity);
+
+    static char pieceToChar(PieceType type, Color color);
+    static bool charToPiece(char c, PieceType& type, Color& color);
+};
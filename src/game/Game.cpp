@@ -1,56 +1,295 @@
 #include "Game.h"
+#include "HibernatedGame.h"
 #include "Horse.h"
 #include "Cannon.h"
 #include "Elephant.h"
+#include "PieceFactory.h"
+#include "diagnostics/Stats.h"
 #include <algorithm>
+#include <cstdlib>
 
-Game::Game() : currentPlayer_(Color::RED) {
+namespace {
+
+// Room for a typical game, so recording history does not allocate mid-game
+constexpr std::size_t RESERVED_PLIES = 256;
+
+// Restoring a checkpoint rewrites the whole board; worth about this many plies
+constexpr int CHECKPOINT_RESTORE_COST = 4;
+
+Color opposite(Color color) {
+    return color == Color::RED ? Color::BLACK : Color::RED;
+}
+
+} // namespace
+
+Game::Game() : currentPlayer_(Color::RED), gameOver_(false), winner_(Color::RED) {
+    history_.reserve(RESERVED_PLIES);
+    checkpoints_.reserve(RESERVED_PLIES / CHECKPOINT_INTERVAL + 1);
     reset();
 }
 
 void Game::reset() {
     board_.clear();
-    currentPlayer_ = Color::RED;
+    startFromBoard(Color::RED);
+}
+
+void Game::startFromBoard(Color sideToMove) {
+    currentPlayer_ = sideToMove;
+    gameOver_ = false;
+    winner_ = Color::RED;
+    history_.clear();
+    checkpoints_.clear();
+    ply_ = 0;
 }
 
 MoveResult Game::makeMove(const Position& from, const Position& to) {
+    STATS_INC(MAKE_MOVE_CALLS);
+    MoveRejection rejection = checkMove(from, to);
+    if (rejection != MoveRejection::NONE) {
+        STATS_REJECT(rejection);
+        return MoveResult(false, false, Color::RED, rejection);
+    }
+    
+    // The start position is captured lazily, after any direct board setup
+    if (checkpoints_.empty()) {
+        checkpoints_.push_back(Checkpoint{board_.toCodes(), currentPlayer_});
+    }
+    
+    Piece* target = board_.getPiece(to);
+    PieceCode captured = target ? pieceCode(target->getType(), target->getColor()) : EMPTY_CODE;
+    HistoryEntry entry(Move(from, to), captured, target && target->getType() == PieceType::GENERAL);
+    
+    // A new move replaces the taken-back line unless it repeats it
+    if (ply_ < historyLength() && history_[ply_].bits != entry.bits) {
+        history_.resize(ply_);
+        checkpoints_.resize(ply_ / CHECKPOINT_INTERVAL + 1);
+    }
+    if (ply_ == historyLength()) {
+        history_.push_back(entry);
+    }
+    
+    Color mover = currentPlayer_;
+    applyEntry(entry);
+    if (ply_ % CHECKPOINT_INTERVAL == 0 && static_cast<int>(checkpoints_.size()) == ply_ / CHECKPOINT_INTERVAL) {
+        checkpoints_.push_back(Checkpoint{board_.toCodes(), currentPlayer_});
+    }
+    
+    if (entry.endedGame()) {
+        return MoveResult(true, true, mover);
+    }
+    return MoveResult(true);
+}
+
+void Game::applyEntry(HistoryEntry entry) {
+    // Capturing the opponent's General ends the game
+    Move move = entry.move();
+    board_.takePiece(move.toPosition());
+    board_.setPiece(move.toPosition(), board_.takePiece(move.fromPosition()));
+    
+    if (entry.endedGame()) {
+        gameOver_ = true;
+        winner_ = currentPlayer_;
+    }
+    currentPlayer_ = opposite(currentPlayer_);
+    ++ply_;
+}
+
+bool Game::takeback() {
+    if (ply_ == 0) {
+        return false;
+    }
+    HistoryEntry entry = history_[--ply_];
+    Move move = entry.move();
+    board_.setPiece(move.fromPosition(), board_.takePiece(move.toPosition()));
+    if (entry.captured() != EMPTY_CODE) {
+        board_.setPiece(move.toPosition(), PieceFactory::create(pieceCodeType(entry.captured()),
+                                                                pieceCodeColor(entry.captured())));
+    }
+    currentPlayer_ = opposite(currentPlayer_);
+    gameOver_ = false;
+    winner_ = Color::RED;
+    return true;
+}
+
+bool Game::redo() {
+    if (ply_ >= historyLength()) {
+        return false;
+    }
+    applyEntry(history_[ply_]);
+    return true;
+}
+
+bool Game::seek(int ply) {
+    if (ply < 0 || ply > historyLength()) {
+        return false;
+    }
+    int checkpoint = std::min(ply / CHECKPOINT_INTERVAL, static_cast<int>(checkpoints_.size()) - 1);
+    int checkpointPly = checkpoint * CHECKPOINT_INTERVAL;
+    bool useCheckpoint = checkpoint >= 0 &&
+                         ply - checkpointPly + CHECKPOINT_RESTORE_COST < std::abs(ply - ply_);
+    if (useCheckpoint) {
+        const Checkpoint& saved = checkpoints_[checkpoint];
+        board_.loadCodes(saved.codes);
+        currentPlayer_ = saved.sideToMove;
+        // A checkpoint can be the position right after the General was taken
+        gameOver_ = checkpointPly > 0 && history_[checkpointPly - 1].endedGame();
+        winner_ = gameOver_ ? opposite(saved.sideToMove) : Color::RED;
+        ply_ = checkpointPly;
+    }
+    while (ply_ > ply) {
+        takeback();
+    }
+    while (ply_ < ply) {
+        redo();
+    }
+    return true;
+}
+
+const Game::LegalMoveCache& Game::legalMoveCache() const {
+    LegalMoveCache& cache = legalMoves_;
+    if (cache.valid && cache.boardVersion == board_.version() && cache.sideToMove == currentPlayer_ &&
+        cache.gameOver == gameOver_) {
+        return cache;
+    }
+    STATS_INC(LEGAL_MOVE_CACHE_BUILDS);
+
+    // Only squares some piece's geometry can reach go through checkMove():
+    // the same row or column, a horse jump, or one or two steps diagonally
+    int count = 0;
+    for (int from = 0; from < BOARD_SQUARES; ++from) {
+        cache.begin[from] = static_cast<std::uint8_t>(count);
+        cache.destinations[from].reset();
+        Position fromPos = squarePosition(from);
+        Piece* piece = gameOver_ ? nullptr : board_.getPiece(fromPos);
+        if (!piece || piece->getColor() != currentPlayer_) {
+            continue;
+        }
+        for (int to = 0; to < BOARD_SQUARES && count < MAX_LEGAL_MOVES; ++to) {
+            Position toPos = squarePosition(to);
+            int rows = std::abs(toPos.row - fromPos.row);
+            int cols = std::abs(toPos.col - fromPos.col);
+            bool reachable = (rows == 0) != (cols == 0) || (rows == 1 && cols == 2) || (rows == 2 && cols == 1) ||
+                             (rows == cols && rows <= 2 && rows > 0);
+            if (reachable && checkMove(fromPos, toPos) == MoveRejection::NONE) {
+                cache.moves[count++] = Move(from, to);
+                cache.destinations[from].set(to);
+            }
+        }
+    }
+    cache.begin[BOARD_SQUARES] = static_cast<std::uint8_t>(count);
+    cache.boardVersion = board_.version();
+    cache.sideToMove = currentPlayer_;
+    cache.gameOver = gameOver_;
+    cache.valid = true;
+    return cache;
+}
+
+MoveSpan Game::allLegalMoves() const {
+    const LegalMoveCache& cache = legalMoveCache();
+    return MoveSpan{cache.moves, cache.begin[BOARD_SQUARES]};
+}
+
+MoveSpan Game::legalMovesFrom(const Position& from) const {
+    if (!board_.isValidPosition(from)) {
+        return MoveSpan();
+    }
+    const LegalMoveCache& cache = legalMoveCache();
+    int square = squareIndex(from);
+    return MoveSpan{cache.moves + cache.begin[square], cache.begin[square + 1] - cache.begin[square]};
+}
+
+SquareSet Game::legalDestinations(const Position& from) const {
+    if (!board_.isValidPosition(from)) {
+        return SquareSet();
+    }
+    return legalMoveCache().destinations[squareIndex(from)];
+}
+
+bool Game::hibernate(HibernatedGame& out) const {
+    // The start position is checkpoint 0 once a move has been made
+    bool encoded = checkpoints_.empty()
+                       ? PackedPosition::encode(board_.toCodes(), currentPlayer_, out.start_)
+                       : PackedPosition::encode(checkpoints_[0].codes, checkpoints_[0].sideToMove, out.start_);
+    if (!encoded) {
+        return false;
+    }
+    out.ply_ = static_cast<std::uint32_t>(ply_);
+    out.length_ = static_cast<std::uint32_t>(history_.size());
+    out.history_.reset();
+    if (!history_.empty()) {
+        out.history_ = std::make_unique<HistoryEntry[]>(history_.size());
+        std::copy(history_.begin(), history_.end(), out.history_.get());
+    }
+    return true;
+}
+
+bool Game::resume(const HibernatedGame& saved) {
+    PieceCodes codes;
+    Color sideToMove;
+    if (!saved.start_.decode(codes, sideToMove)) {
+        reset();
+        return false;
+    }
+    board_.loadCodes(codes);
+    startFromBoard(sideToMove);
+    // Through makeMove(), so stored data is checked and checkpoints are rebuilt
+    for (std::uint32_t i = 0; i < saved.length_; ++i) {
+        Move move = saved.history_[i].move();
+        if (!makeMove(move.fromPosition(), move.toPosition()).isLegal) {
+            reset();
+            return false;
+        }
+    }
+    return seek(static_cast<int>(saved.ply_));
+}
+
+bool Game::isMoveLegal(const Position& from, const Position& to) const {
+    return checkMove(from, to) == MoveRejection::NONE;
+}
+
+MoveRejection Game::checkMove(const Position& from, const Position& to) const {
+    // No moves once a General has been captured
+    if (gameOver_) {
+        return MoveRejection::GAME_OVER;
+    }
+    
     // Check if there's a piece at the from position
     Piece* piece = board_.getPiece(from);
     if (!piece) {
-        return MoveResult(false);
+        return MoveRejection::NO_PIECE;
     }
     
     // Check if it's the correct player's piece
     if (piece->getColor() != currentPlayer_) {
-        return MoveResult(false);
+        return MoveRejection::WRONG_COLOR;
     }
     
     // Check if the move is valid for this piece type
     if (!piece->isValidMove(from, to)) {
-        return MoveResult(false);
+        return MoveRejection::GEOMETRY;
     }
     
     // Check if destination is within board bounds
     if (!board_.isValidPosition(to)) {
-        return MoveResult(false);
+        return MoveRejection::OFF_BOARD;
     }
     
     // Check if destination has own piece (can't capture own piece)
     Piece* targetPiece = board_.getPiece(to);
     if (targetPiece && targetPiece->getColor() == currentPlayer_) {
-        return MoveResult(false);
+        return MoveRejection::OWN_PIECE;
     }
     
     // Check path clearance for pieces that can't jump (Rook, Cannon)
     if (piece->getType() == PieceType::ROOK && !board_.isPathClear(from, to)) {
-        return MoveResult(false);
+        return MoveRejection::BLOCKED_PATH;
     }
     
     // Check cannon jumping rules
     if (piece->getType() == PieceType::CANNON) {
         Cannon* cannon = static_cast<Cannon*>(piece);
         if (!cannon->isValidMoveWithBoard(from, to, board_)) {
-            return MoveResult(false);
+            return MoveRejection::CANNON_SCREEN;
         }
     }
     
@@ -58,7 +297,7 @@ MoveResult Game::makeMove(const Position& from, const Position& to) {
     if (piece->getType() == PieceType::HORSE) {
         Horse* horse = static_cast<Horse*>(piece);
         if (!horse->isValidMoveWithBoard(from, to, board_)) {
-            return MoveResult(false);
+            return MoveRejection::HORSE_LEG;
         }
     }
     
@@ -66,23 +305,29 @@ MoveResult Game::makeMove(const Position& from, const Position& to) {
     if (piece->getType() == PieceType::ELEPHANT) {
         Elephant* elephant = static_cast<Elephant*>(piece);
         if (!elephant->isValidMoveWithBoard(from, to, board_)) {
-            return MoveResult(false);
+            return MoveRejection::ELEPHANT_EYE;
         }
     }
     
     // Special rule for General: check if move would cause generals to face each other
     if (piece->getType() == PieceType::GENERAL && wouldGeneralsFaceEachOther(from, to)) {
-        return MoveResult(false);
+        return MoveRejection::FACING_GENERALS;
     }
     
-    // Move is legal - for now just return true without actually moving
-    // (We'll implement the actual move execution later)
-    return MoveResult(true);
+    return MoveRejection::NONE;
+}
+
+const char* moveRejectionName(MoveRejection reason) {
+    static const char* const NAMES[] = {
+        "none", "game over", "no piece", "wrong color", "geometry", "off board", "own piece",
+        "blocked path", "cannon screen", "horse leg", "elephant eye", "facing generals",
+    };
+    int index = static_cast<int>(reason);
+    return index >= 0 && index < static_cast<int>(MoveRejection::COUNT) ? NAMES[index] : "unknown";
 }
 
 bool Game::isGameOver() const {
-    // Placeholder implementation - will be filled during BDD cycle
-    return false;
+    return gameOver_;
 }
 
 bool Game::wouldGeneralsFaceEachOther(const Position& from, const Position& to) const {
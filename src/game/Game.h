@@ -1,21 +1,101 @@
 #pragma once
 #include "Board.h"
+#include "Move.h"
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+// Why Game rejected a move, in the order the checks run
+enum class MoveRejection {
+    NONE, GAME_OVER, NO_PIECE, WRONG_COLOR, GEOMETRY, OFF_BOARD, OWN_PIECE,
+    BLOCKED_PATH, CANNON_SCREEN, HORSE_LEG, ELEPHANT_EYE, FACING_GENERALS,
+    COUNT
+};
+
+const char* moveRejectionName(MoveRejection reason);
 
 struct MoveResult {
     bool isLegal;
     bool gameEnded;
     Color winner;
+    MoveRejection rejection;
     
-    MoveResult(bool legal = false, bool ended = false, Color w = Color::RED) 
-        : isLegal(legal), gameEnded(ended), winner(w) {}
+    MoveResult(bool legal = false, bool ended = false, Color w = Color::RED,
+               MoveRejection reason = MoveRejection::NONE) 
+        : isLegal(legal), gameEnded(ended), winner(w), rejection(reason) {}
+};
+
+// One ply of game history in 32 bits: Move bits (0-15), the captured
+// PieceCode (16-19) and whether the move captured a General (bit 20)
+struct HistoryEntry {
+    std::uint32_t bits = 0;
+
+    HistoryEntry() = default;
+    HistoryEntry(Move move, PieceCode captured, bool endedGame)
+        : bits(move.bits | (static_cast<std::uint32_t>(captured) << 16) | (endedGame ? 1u << 20 : 0u)) {}
+
+    Move move() const { return Move(static_cast<std::uint16_t>(bits & 0xFFFF)); }
+    PieceCode captured() const { return static_cast<PieceCode>((bits >> 16) & 0xF); }
+    bool endedGame() const { return (bits >> 20) & 1; }
+};
+static_assert(sizeof(HistoryEntry) == 4, "HistoryEntry is a 32-bit record");
+
+// A set of board squares, bit squareIndex(pos)
+using SquareSet = std::bitset<BOARD_SQUARES>;
+
+// Moves owned by a Game's legal-move cache; valid until the position changes
+struct MoveSpan {
+    const Move* first = nullptr;
+    int count = 0;
+
+    const Move* begin() const { return first; }
+    const Move* end() const { return first + count; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
 };
 
+class HibernatedGame;
+
 class Game {
+public:
+    // Plies between stored board checkpoints used by seek()
+    static constexpr int CHECKPOINT_INTERVAL = 16;
+    // Above the most moves any Xiangqi position allows
+    static constexpr int MAX_LEGAL_MOVES = 128;
+
 private:
+    struct Checkpoint {
+        PieceCodes codes;
+        Color sideToMove;
+    };
+
     Board board_;
     Color currentPlayer_;
+    bool gameOver_;
+    Color winner_;
+    // Moves from the start position; entries past ply_ were taken back and can be redone
+    std::vector<HistoryEntry> history_;
+    std::vector<Checkpoint> checkpoints_; // board at ply k * CHECKPOINT_INTERVAL
+    int ply_ = 0;
+
+    // Every move isMoveLegal() accepts, grouped by from-square. Built on the
+    // first query and rebuilt once the board (by its version), the side to
+    // move or the game-over state differs from when it was built. The const
+    // queries write it without a lock, so they belong to the owning thread.
+    struct LegalMoveCache {
+        Move moves[MAX_LEGAL_MOVES];
+        std::uint8_t begin[BOARD_SQUARES + 1]; // moves from square s are [begin[s], begin[s + 1])
+        SquareSet destinations[BOARD_SQUARES];
+        std::uint32_t boardVersion = 0;
+        Color sideToMove = Color::RED;
+        bool gameOver = false;
+        bool valid = false;
+    };
+    mutable LegalMoveCache legalMoves_;
+    
+    void applyEntry(HistoryEntry entry);
+    const LegalMoveCache& legalMoveCache() const;
     
-    bool wouldGeneralsFaceEachOther(const Position& from, const Position& to) const;
     bool areGeneralsDirectlyFacing(const Position& redPos, const Position& blackPos,
                                   const Position& moveFrom, const Position& moveTo) const;
     
@@ -25,7 +105,46 @@ public:
     void reset();
     Board& getBoard() { return board_; }
     const Board& getBoard() const { return board_; }
+    Color getCurrentPlayer() const { return currentPlayer_; }
+    void setCurrentPlayer(Color color) { currentPlayer_ = color; }
+    // Restarts play from whatever is on the board now (after FEN loads, decodes, etc.)
+    void startFromBoard(Color sideToMove);
     
+    bool isMoveLegal(const Position& from, const Position& to) const;
+    // Same checks as isMoveLegal(), reporting the first one that fails
+    MoveRejection checkMove(const Position& from, const Position& to) const;
+    // True if moving a General from 'from' to 'to' would leave the two Generals facing
+    bool wouldGeneralsFaceEachOther(const Position& from, const Position& to) const;
     MoveResult makeMove(const Position& from, const Position& to);
     bool isGameOver() const;
+
+    // Cached legal-move queries for move hints: the first call in a position
+    // costs one pass over the pieces, later ones are lookups. Nothing allocates.
+    // Empty for squares without a piece of the side to move. Despite being
+    // const they fill the cache without synchronisation: call them only from
+    // the thread that owns the Game, never concurrently on a shared one.
+    MoveSpan allLegalMoves() const;
+    MoveSpan legalMovesFrom(const Position& from) const;
+    SquareSet legalDestinations(const Position& from) const;
+    Color getWinner() const { return winner_; }
+    
+    // History. Editing the board directly after moves needs a startFromBoard()
+    // call, which also clears the history.
+    int ply() const { return ply_; }
+    int historyLength() const { return static_cast<int>(history_.size()); }
+    HistoryEntry historyEntry(int ply) const { return history_[ply]; }
+    // Undoes the last move in O(1); it stays in the history for redo()
+    bool takeback();
+    // Replays the move that was taken back at the current ply
+    bool redo();
+    // Jumps to any ply in [0, historyLength()], from the nearer of the current
+    // ply and the closest checkpoint at or before it
+    bool seek(int ply);
+
+    // Folds the game into its start position and history; false for boards a
+    // PackedPosition cannot hold (more than 32 pieces)
+    bool hibernate(HibernatedGame& out) const;
+    // Replays a hibernated game, redo line included, and seeks to its ply.
+    // On false (a move that is not legal) the game is left reset.
+    bool resume(const HibernatedGame& saved);
 };
@@ -0,0 +1,170 @@
+#include "GameDelta.h"
+#include "Zobrist.h"
+#include <cstring>
+
+namespace {
+
+void putU16(std::string& out, std::uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void putU32(std::string& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+std::uint16_t getU16(const std::uint8_t* data) {
+    return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+}
+
+std::uint32_t getU32(const std::uint8_t* data) {
+    return static_cast<std::uint32_t>(data[0]) | (static_cast<std::uint32_t>(data[1]) << 8) |
+           (static_cast<std::uint32_t>(data[2]) << 16) | (static_cast<std::uint32_t>(data[3]) << 24);
+}
+
+Color opposite(Color color) {
+    return color == Color::RED ? Color::BLACK : Color::RED;
+}
+
+} // namespace
+
+GameDeltaEncoder::GameDeltaEncoder(int keyframeInterval) : keyframeInterval_(keyframeInterval < 1 ? 1 : keyframeInterval) {}
+
+std::size_t GameDeltaEncoder::writeKeyframe(const Game& game, std::string& out) {
+    PackedPosition packed;
+    if (!PackedPosition::encode(game.getBoard(), game.getCurrentPlayer(), packed)) {
+        return 0;
+    }
+    std::uint8_t tag = GameDelta::KEYFRAME_TAG;
+    if (game.isGameOver()) {
+        tag |= GameDelta::GAME_OVER_FLAG | (game.getWinner() == Color::BLACK ? GameDelta::BLACK_WON_FLAG : 0);
+    }
+    out.push_back(static_cast<char>(tag));
+    putU32(out, static_cast<std::uint32_t>(game.ply()));
+    out.append(reinterpret_cast<const char*>(&packed), sizeof(packed));
+    return GameDelta::KEYFRAME_BYTES;
+}
+
+std::size_t GameDeltaEncoder::keyframe(const Game& game, std::string& out) {
+    std::size_t written = writeKeyframe(game, out);
+    if (written == 0) {
+        return 0;
+    }
+    ply_ = game.ply();
+    key_ = Zobrist::hash(game.getBoard(), game.getCurrentPlayer());
+    lastEntry_ = ply_ > 0 ? game.historyEntry(ply_ - 1).bits : 0;
+    deltasSinceKeyframe_ = 0;
+    return written;
+}
+
+std::size_t GameDeltaEncoder::update(const Game& game, std::string& out) {
+    const int ply = game.ply();
+    // A takeback followed by a different move leaves a different entry behind ply_
+    bool sameLine = ply_ >= 0 && (ply_ == 0 || (ply_ <= game.historyLength() && game.historyEntry(ply_ - 1).bits == lastEntry_));
+    if (sameLine && ply == ply_) {
+        if (Zobrist::hash(game.getBoard(), game.getCurrentPlayer()) == key_) {
+            return 0;
+        }
+        return keyframe(game, out);
+    }
+    if (!sameLine || ply != ply_ + 1 || deltasSinceKeyframe_ + 1 >= keyframeInterval_) {
+        return keyframe(game, out);
+    }
+
+    HistoryEntry entry = game.historyEntry(ply_);
+    Move move = entry.move();
+    const Piece* piece = game.getBoard().getPiece(move.toPosition());
+    if (!piece) {
+        return keyframe(game, out);
+    }
+    PieceCode moved = pieceCode(piece->getType(), piece->getColor());
+    key_ = Zobrist::afterMove(key_, moved, entry.captured(), move.from(), move.to());
+
+    std::uint8_t tag = entry.captured() | (entry.endedGame() ? GameDelta::GAME_OVER_FLAG : 0);
+    out.push_back(static_cast<char>(tag));
+    putU16(out, move.bits);
+    putU32(out, static_cast<std::uint32_t>(key_));
+    ply_ = ply;
+    lastEntry_ = entry.bits;
+    ++deltasSinceKeyframe_;
+    return GameDelta::DELTA_BYTES;
+}
+
+GameDeltaDecoder::Status GameDeltaDecoder::read(std::string_view data, std::size_t& consumed) {
+    if (data.empty()) {
+        return Status::INCOMPLETE;
+    }
+    const auto* frame = reinterpret_cast<const std::uint8_t*>(data.data());
+    bool isKeyframe = (frame[0] & GameDelta::KEYFRAME_TAG) != 0;
+    std::size_t length = isKeyframe ? GameDelta::KEYFRAME_BYTES : GameDelta::DELTA_BYTES;
+    if (data.size() < length) {
+        return Status::INCOMPLETE;
+    }
+    consumed = length;
+    Status status = isKeyframe ? applyKeyframe(frame) : applyDelta(frame);
+    if (status == Status::CORRUPT) {
+        synced_ = false;
+    }
+    return status;
+}
+
+GameDeltaDecoder::Status GameDeltaDecoder::applyDelta(const std::uint8_t* frame) {
+    if (!synced_) {
+        return Status::NEEDS_KEYFRAME;
+    }
+    std::uint8_t tag = frame[0];
+    if ((tag & ~(GameDelta::CAPTURED_MASK | GameDelta::GAME_OVER_FLAG)) != 0 || gameOver_) {
+        return Status::CORRUPT;
+    }
+    PieceCode captured = tag & GameDelta::CAPTURED_MASK;
+    bool ended = (tag & GameDelta::GAME_OVER_FLAG) != 0;
+    Move move(getU16(frame + 1));
+    if (move.from() >= BOARD_SQUARES || move.to() >= BOARD_SQUARES) {
+        return Status::CORRUPT;
+    }
+    PieceCode moved = codes_[move.from()];
+    bool capturesGeneral = captured != EMPTY_CODE && pieceCodeType(captured) == PieceType::GENERAL;
+    if (moved == EMPTY_CODE || pieceCodeColor(moved) != sideToMove_ || codes_[move.to()] != captured ||
+        ended != capturesGeneral) {
+        return Status::CORRUPT;
+    }
+    std::uint64_t key = Zobrist::afterMove(key_, moved, captured, move.from(), move.to());
+    if (static_cast<std::uint32_t>(key) != getU32(frame + 3)) {
+        return Status::CORRUPT;
+    }
+
+    codes_[move.to()] = moved;
+    codes_[move.from()] = EMPTY_CODE;
+    key_ = key;
+    if (ended) {
+        gameOver_ = true;
+        winner_ = sideToMove_;
+    }
+    sideToMove_ = opposite(sideToMove_);
+    ++ply_;
+    return Status::APPLIED;
+}
+
+GameDeltaDecoder::Status GameDeltaDecoder::applyKeyframe(const std::uint8_t* frame) {
+    std::uint8_t tag = frame[0];
+    if ((tag & ~(GameDelta::KEYFRAME_TAG | GameDelta::GAME_OVER_FLAG | GameDelta::BLACK_WON_FLAG)) != 0) {
+        return Status::CORRUPT;
+    }
+    PackedPosition packed;
+    std::memcpy(&packed, frame + 5, sizeof(packed));
+    PieceCodes codes;
+    Color sideToMove;
+    if (!packed.decode(codes, sideToMove)) {
+        return Status::CORRUPT;
+    }
+    codes_ = codes;
+    sideToMove_ = sideToMove;
+    key_ = Zobrist::hash(codes_, sideToMove_);
+    ply_ = static_cast<int>(getU32(frame + 1));
+    gameOver_ = (tag & GameDelta::GAME_OVER_FLAG) != 0;
+    winner_ = (tag & GameDelta::BLACK_WON_FLAG) ? Color::BLACK : Color::RED;
+    synced_ = true;
+    return Status::APPLIED;
+}
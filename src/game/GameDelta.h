@@ -0,0 +1,90 @@
+#pragma once
+#include "Game.h"
+#include "PackedPosition.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// Spectator update stream: one small frame per move, with periodic keyframes
+// holding the whole position. Frames are self-delimiting and concatenate into
+// a stream.
+//   delta    (7 bytes):  tag, Move bits (u16), low 32 bits of the new Zobrist key
+//            tag: bits 0-3 the captured PieceCode, bit 4 the move ended the game
+//   keyframe (37 bytes): tag, ply (u32), PackedPosition
+//            tag: bit 7 set, bit 4 game over, bit 5 Black won
+// The key lets a spectator detect a missed or damaged delta and wait for the
+// next keyframe. Integers are little-endian.
+namespace GameDelta {
+
+constexpr std::size_t DELTA_BYTES = 7;
+constexpr std::size_t KEYFRAME_BYTES = 5 + sizeof(PackedPosition);
+
+constexpr std::uint8_t KEYFRAME_TAG = 0x80;
+constexpr std::uint8_t GAME_OVER_FLAG = 0x10;
+constexpr std::uint8_t BLACK_WON_FLAG = 0x20;
+constexpr std::uint8_t CAPTURED_MASK = 0x0F;
+
+} // namespace GameDelta
+
+// Follows one Game and writes the frames that take spectators to its
+// current position. Call update() after every makeMove(), takeback(), seek()
+// or new position.
+class GameDeltaEncoder {
+public:
+    static constexpr int DEFAULT_KEYFRAME_INTERVAL = 32;
+
+private:
+    int keyframeInterval_;
+    int ply_ = -1;              // where the spectators are; -1 before the first keyframe
+    int deltasSinceKeyframe_ = 0;
+    std::uint64_t key_ = 0;
+    std::uint32_t lastEntry_ = 0; // history entry that led to ply_, to spot a changed line
+
+    std::size_t keyframe(const Game& game, std::string& out);
+
+public:
+    explicit GameDeltaEncoder(int keyframeInterval = DEFAULT_KEYFRAME_INTERVAL);
+
+    // Appends nothing when the spectators are already up to date, a delta when
+    // the game advanced by one move, and a keyframe otherwise or when the
+    // interval is up. Returns the bytes appended.
+    std::size_t update(const Game& game, std::string& out);
+
+    // A keyframe of 'game' for a spectator joining mid-stream; the encoder's
+    // own stream is unaffected. 0 if the board cannot be packed.
+    static std::size_t writeKeyframe(const Game& game, std::string& out);
+};
+
+// A spectator's copy of the position, advanced frame by frame
+class GameDeltaDecoder {
+public:
+    enum class Status { APPLIED, INCOMPLETE, NEEDS_KEYFRAME, CORRUPT };
+
+private:
+    PieceCodes codes_{};
+    Color sideToMove_ = Color::RED;
+    std::uint64_t key_ = 0;
+    int ply_ = 0;
+    bool gameOver_ = false;
+    Color winner_ = Color::RED;
+    bool synced_ = false;
+
+    Status applyDelta(const std::uint8_t* frame);
+    Status applyKeyframe(const std::uint8_t* frame);
+
+public:
+    // Reads the frame at the front of 'data'. 'consumed' is its length for any
+    // status but INCOMPLETE, so the caller can move past frames it cannot use.
+    // A delta that does not fit the position, or whose key disagrees, leaves
+    // the position as it was and returns CORRUPT; later deltas return
+    // NEEDS_KEYFRAME until a keyframe arrives.
+    Status read(std::string_view data, std::size_t& consumed);
+
+    bool synced() const { return synced_; }
+    const PieceCodes& codes() const { return codes_; }
+    Color sideToMove() const { return sideToMove_; }
+    std::uint64_t key() const { return key_; }
+    int ply() const { return ply_; }
+    bool isGameOver() const { return gameOver_; }
+    Color winner() const { return winner_; }
+};
@@ -0,0 +1,38 @@
+#include "HibernatedGame.h"
+#include <cstring>
+
+namespace {
+
+constexpr std::size_t FIXED_BYTES = sizeof(PackedPosition) + 2 * sizeof(std::uint32_t);
+
+} // namespace
+
+void HibernatedGame::serialize(std::string& out) const {
+    out.resize(FIXED_BYTES + length_ * sizeof(HistoryEntry));
+    char* data = &out[0];
+    std::memcpy(data, &start_, sizeof(start_));
+    std::memcpy(data + sizeof(start_), &ply_, sizeof(ply_));
+    std::memcpy(data + sizeof(start_) + sizeof(ply_), &length_, sizeof(length_));
+    if (length_ > 0) {
+        std::memcpy(data + FIXED_BYTES, history_.get(), length_ * sizeof(HistoryEntry));
+    }
+}
+
+bool HibernatedGame::deserialize(std::string_view data, HibernatedGame& out) {
+    if (data.size() < FIXED_BYTES) {
+        return false;
+    }
+    HibernatedGame loaded;
+    std::memcpy(&loaded.start_, data.data(), sizeof(loaded.start_));
+    std::memcpy(&loaded.ply_, data.data() + sizeof(loaded.start_), sizeof(loaded.ply_));
+    std::memcpy(&loaded.length_, data.data() + sizeof(loaded.start_) + sizeof(loaded.ply_), sizeof(loaded.length_));
+    if (loaded.ply_ > loaded.length_ || data.size() - FIXED_BYTES != loaded.length_ * std::size_t{sizeof(HistoryEntry)}) {
+        return false;
+    }
+    if (loaded.length_ > 0) {
+        loaded.history_ = std::make_unique<HistoryEntry[]>(loaded.length_);
+        std::memcpy(loaded.history_.get(), data.data() + FIXED_BYTES, loaded.length_ * sizeof(HistoryEntry));
+    }
+    out = std::move(loaded);
+    return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "Game.h"
+#include "PackedPosition.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// An idle Game folded into its start position and move history: 48 bytes
+// inline plus one 4-byte HistoryEntry per ply in a single block, instead of a
+// Game's piece allocations, checkpoints and caches. Game::hibernate() fills
+// one and Game::resume() replays it, so the Game itself can be destroyed (or
+// reused for another session) while the player thinks.
+class HibernatedGame {
+private:
+    PackedPosition start_{};
+    std::uint32_t ply_ = 0;    // current ply; entries past it can be redone
+    std::uint32_t length_ = 0;
+    std::unique_ptr<HistoryEntry[]> history_;
+
+    friend class Game;
+
+public:
+    HibernatedGame() = default;
+    HibernatedGame(HibernatedGame&&) = default;
+    HibernatedGame& operator=(HibernatedGame&&) = default;
+
+    const PackedPosition& start() const { return start_; }
+    int ply() const { return static_cast<int>(ply_); }
+    int historyLength() const { return static_cast<int>(length_); }
+    HistoryEntry historyEntry(int ply) const { return history_[ply]; }
+    // Memory held, inline and on the heap
+    std::size_t bytes() const { return sizeof(*this) + length_ * sizeof(HistoryEntry); }
+
+    // Stored form for session stores and files: the PackedPosition, ply and
+    // length as u32, then the entries, in host (little-endian) order
+    void serialize(std::string& out) const;
+    // False if 'data' is truncated or inconsistent; resume() checks the moves
+    static bool deserialize(std::string_view data, HibernatedGame& out);
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include "PieceCode.h"
+#include <cstdint>
+
+// 16-bit move: from-square in bits 7-13, to-square in bits 0-6 (see squareIndex()).
+// The all-zero value is never a real move and doubles as "no move".
+struct Move {
+    std::uint16_t bits = 0;
+
+    constexpr Move() = default;
+    constexpr explicit Move(std::uint16_t raw) : bits(raw) {}
+    constexpr Move(int fromSquare, int toSquare)
+        : bits(static_cast<std::uint16_t>((fromSquare << 7) | toSquare)) {}
+    constexpr Move(const Position& from, const Position& to)
+        : Move(squareIndex(from), squareIndex(to)) {}
+
+    constexpr int from() const { return bits >> 7; }
+    constexpr int to() const { return bits & 0x7F; }
+    constexpr Position fromPosition() const { return squarePosition(from()); }
+    constexpr Position toPosition() const { return squarePosition(to()); }
+    constexpr bool isNull() const { return bits == 0; }
+
+    constexpr bool operator==(const Move& other) const { return bits == other.bits; }
+    constexpr bool operator!=(const Move& other) const { return bits != other.bits; }
+};
@@ -0,0 +1,180 @@
+#include "Notation.h"
+
+namespace {
+
+bool isFileLetter(char c) {
+    return (c >= 'a' && c <= 'i') || (c >= 'A' && c <= 'I');
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int fileLetterToCol(char c) {
+    return (c >= 'a') ? c - 'a' + 1 : c - 'A' + 1;
+}
+
+bool wxfPieceType(char c, PieceType& type) {
+    switch (c) {
+        case 'K': case 'k': type = PieceType::GENERAL; return true;
+        case 'A': case 'a': type = PieceType::GUARD; return true;
+        case 'E': case 'e': case 'B': case 'b': type = PieceType::ELEPHANT; return true;
+        case 'H': case 'h': case 'N': case 'n': type = PieceType::HORSE; return true;
+        case 'R': case 'r': type = PieceType::ROOK; return true;
+        case 'C': case 'c': type = PieceType::CANNON; return true;
+        case 'P': case 'p': type = PieceType::SOLDIER; return true;
+        default: return false;
+    }
+}
+
+// WXF files are numbered 1..9 from the mover's right-hand side
+int wxfFileToCol(int file, Color mover) {
+    return (mover == Color::RED) ? BOARD_COLS + 1 - file : file;
+}
+
+int forwardStep(Color mover) {
+    return (mover == Color::RED) ? 1 : -1;
+}
+
+bool isLinePiece(PieceType type) {
+    return type == PieceType::GENERAL || type == PieceType::ROOK ||
+           type == PieceType::CANNON || type == PieceType::SOLDIER;
+}
+
+bool wxfTarget(PieceType type, Color mover, const Position& from, char op, int arg, Position& to) {
+    int direction = (op == '+') ? forwardStep(mover) : -forwardStep(mover);
+
+    if (isLinePiece(type)) {
+        if (op == '.' || op == '=') {
+            to = Position(from.row, wxfFileToCol(arg, mover));
+        } else {
+            to = Position(from.row + direction * arg, from.col);
+        }
+        return true;
+    }
+
+    if (op == '.' || op == '=') {
+        return false; // diagonal movers never stay on their rank
+    }
+
+    int targetCol = wxfFileToCol(arg, mover);
+    int colDiff = targetCol > from.col ? targetCol - from.col : from.col - targetCol;
+    int rowDiff = 0;
+    if (type == PieceType::HORSE) {
+        rowDiff = (colDiff == 1) ? 2 : 1;
+    } else if (type == PieceType::GUARD) {
+        rowDiff = 1;
+    } else if (type == PieceType::ELEPHANT) {
+        rowDiff = 2;
+    }
+    to = Position(from.row + direction * rowDiff, targetCol);
+    return true;
+}
+
+} // namespace
+
+bool Notation::looksLikeIccs(std::string_view text) {
+    if (text.size() == 5 && text[2] == '-') {
+        return isFileLetter(text[0]) && isDigit(text[1]) && isFileLetter(text[3]) && isDigit(text[4]);
+    }
+    return text.size() == 4 && isFileLetter(text[0]) && isDigit(text[1]) &&
+           isFileLetter(text[2]) && isDigit(text[3]);
+}
+
+bool Notation::parseIccs(std::string_view text, Position& from, Position& to) {
+    if (!looksLikeIccs(text)) {
+        return false;
+    }
+    std::size_t second = (text.size() == 5) ? 3 : 2;
+    from = Position(text[1] - '0' + 1, fileLetterToCol(text[0]));
+    to = Position(text[second + 1] - '0' + 1, fileLetterToCol(text[second]));
+    return true;
+}
+
+bool Notation::parseWxf(std::string_view text, const Board& board, Color mover,
+                        Position& from, Position& to) {
+    // Accepted shapes: "C2.5", "C+.5" / "+C.5" (front/rear of two on a file)
+    if (text.size() != 4) {
+        return false;
+    }
+
+    PieceType type;
+    char selector;
+    if (wxfPieceType(text[0], type)) {
+        selector = text[1];
+    } else if (wxfPieceType(text[1], type)) {
+        selector = text[0];
+    } else {
+        return false;
+    }
+
+    char op = text[2];
+    if ((op != '+' && op != '-' && op != '.' && op != '=') || !isDigit(text[3]) || text[3] == '0') {
+        return false;
+    }
+    int arg = text[3] - '0';
+
+    bool byFile = isDigit(selector) && selector != '0';
+    if (!byFile && selector != '+' && selector != '-') {
+        return false;
+    }
+
+    // Candidates of the right type; for front/rear pick the most/least advanced
+    // piece on a file holding two or more of them
+    int step = forwardStep(mover);
+    bool found = false;
+    for (int col = 1; col <= BOARD_COLS && !found; ++col) {
+        if (byFile && col != wxfFileToCol(selector - '0', mover)) {
+            continue;
+        }
+
+        int rows[BOARD_ROWS];
+        int count = 0;
+        for (int row = 1; row <= BOARD_ROWS; ++row) {
+            const Piece* piece = board.getPiece(Position(row, col));
+            if (piece && piece->getType() == type && piece->getColor() == mover) {
+                rows[count++] = row;
+            }
+        }
+        if (count == 0 || (!byFile && count < 2)) {
+            continue;
+        }
+
+        if (!byFile) {
+            // rows[] is ascending; Red's front piece is the highest row, Black's the lowest
+            bool front = (selector == '+');
+            rows[0] = rows[((step > 0) == front) ? count - 1 : 0];
+            count = 1;
+        }
+
+        for (int i = 0; i < count && !found; ++i) {
+            Position candidate(rows[i], col);
+            Position target;
+            if (!wxfTarget(type, mover, candidate, op, arg, target) || !board.isValidPosition(target)) {
+                continue;
+            }
+            // With several pieces on one file (e.g. advisors), keep the one whose move fits the geometry
+            if (count == 1 || board.getPiece(candidate)->isValidMove(candidate, target)) {
+                from = candidate;
+                to = target;
+                found = true;
+            }
+        }
+    }
+    return found;
+}
+
+bool Notation::parseMove(std::string_view text, const Board& board, Color mover,
+                         Position& from, Position& to) {
+    if (looksLikeIccs(text)) {
+        return parseIccs(text, from, to);
+    }
+    return parseWxf(text, board, mover, from, to);
+}
+
+void Notation::writeIccs(const Position& from, const Position& to, char* out) {
+    out[0] = static_cast<char>('a' + from.col - 1);
+    out[1] = static_cast<char>('0' + from.row - 1);
+    out[2] = static_cast<char>('a' + to.col - 1);
+    out[3] = static_cast<char>('0' + to.row - 1);
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Board.h"
+#include <cstddef>
+#include <string_view>
+
+// Move notations used by Xiangqi game records.
+//   ICCS: coordinate moves such as "h2e2" (or "h2-e2"); files a..i = col 1..9,
+//         ranks 0..9 = row 1..10 from Red's side.
+//   WXF:  piece-relative moves such as "C2.5", "H8+7", "+R-1"; files are counted
+//         right to left from the mover's side, '+' advances, '-' retreats and
+//         '.' traverses. Resolving a WXF move needs the current board.
+class Notation {
+public:
+    static constexpr std::size_t ICCS_LENGTH = 4;
+
+    static bool parseIccs(std::string_view text, Position& from, Position& to);
+    static bool parseWxf(std::string_view text, const Board& board, Color mover,
+                         Position& from, Position& to);
+    // Picks ICCS or WXF by the shape of the token
+    static bool parseMove(std::string_view text, const Board& board, Color mover,
+                          Position& from, Position& to);
+
+    // Writes exactly ICCS_LENGTH characters (no terminator)
+    static void writeIccs(const Position& from, const Position& to, char* out);
+
+    static bool looksLikeIccs(std::string_view text);
+};
@@ -0,0 +1,114 @@
+#include "PackedPosition.h"
+#include "Zobrist.h"
+#include <cstring>
+
+namespace {
+
+int popCount(std::uint8_t byte) {
+    int count = 0;
+    for (; byte; byte &= byte - 1) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+bool PackedPosition::encode(const PieceCodes& codes, Color sideToMove, PackedPosition& out) {
+    PackedPosition packed;
+    std::memset(&packed, 0, sizeof(packed));
+
+    int count = 0;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        PieceCode code = codes[square];
+        if (code == EMPTY_CODE) {
+            continue;
+        }
+        if (count == MAX_PIECES) {
+            return false;
+        }
+        packed.occupancy[square >> 3] |= static_cast<std::uint8_t>(1u << (square & 7));
+        packed.pieces[count >> 1] |= static_cast<std::uint8_t>(code << ((count & 1) * 4));
+        ++count;
+    }
+    packed.flags = (sideToMove == Color::BLACK) ? BLACK_TO_MOVE : 0;
+
+    out = packed;
+    return true;
+}
+
+bool PackedPosition::encode(const Board& board, Color sideToMove, PackedPosition& out) {
+    return encode(board.toCodes(), sideToMove, out);
+}
+
+bool PackedPosition::encode(const Game& game, PackedPosition& out) {
+    return encode(game.getBoard(), game.getCurrentPlayer(), out);
+}
+
+bool PackedPosition::decode(PieceCodes& codes, Color& side) const {
+    PieceCodes decoded;
+    decoded.fill(EMPTY_CODE);
+
+    int count = 0;
+    for (int byte = 0; byte < 12; ++byte) {
+        for (std::uint8_t bits = occupancy[byte]; bits; bits &= bits - 1) {
+            int bit = 0;
+            while (!(bits & (1u << bit))) {
+                ++bit;
+            }
+            int square = byte * 8 + bit;
+            if (square >= BOARD_SQUARES || count == MAX_PIECES) {
+                return false;
+            }
+            PieceCode code = (pieces[count >> 1] >> ((count & 1) * 4)) & 0x0F;
+            if ((code & 7) == 0) {
+                return false;
+            }
+            decoded[square] = code;
+            ++count;
+        }
+    }
+
+    codes = decoded;
+    side = sideToMove();
+    return true;
+}
+
+bool PackedPosition::decode(Board& board, Color& side) const {
+    PieceCodes codes;
+    if (!decode(codes, side)) {
+        return false;
+    }
+    board.loadCodes(codes);
+    return true;
+}
+
+bool PackedPosition::decode(Game& game) const {
+    Color side;
+    if (!decode(game.getBoard(), side)) {
+        return false;
+    }
+    game.startFromBoard(side);
+    return true;
+}
+
+int PackedPosition::pieceCount() const {
+    int count = 0;
+    for (std::uint8_t byte : occupancy) {
+        count += popCount(byte);
+    }
+    return count;
+}
+
+std::uint64_t PackedPosition::hash() const {
+    PieceCodes codes;
+    Color side;
+    if (!decode(codes, side)) {
+        return 0;
+    }
+    return Zobrist::hash(codes, side);
+}
+
+bool PackedPosition::operator==(const PackedPosition& other) const {
+    return std::memcmp(this, &other, sizeof(PackedPosition)) == 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Game.h"
+#include "PieceCode.h"
+#include <cstdint>
+
+// Canonical 32-byte position record for caches, files and the wire:
+// a 90-bit occupancy bitmap followed by one 4-bit PieceCode per occupied square
+// (in square order, low nibble first) and the side to move. Positions with more
+// than 32 pieces cannot occur in play and are rejected by encode().
+struct PackedPosition {
+    static constexpr int MAX_PIECES = 32;
+
+    std::uint8_t occupancy[12];
+    std::uint8_t pieces[MAX_PIECES / 2];
+    std::uint8_t flags;
+    std::uint8_t reserved[3];
+
+    static constexpr std::uint8_t BLACK_TO_MOVE = 0x01;
+
+    static bool encode(const PieceCodes& codes, Color sideToMove, PackedPosition& out);
+    static bool encode(const Board& board, Color sideToMove, PackedPosition& out);
+    static bool encode(const Game& game, PackedPosition& out);
+
+    // Returns false if the record is corrupt (bad piece codes or too many pieces)
+    bool decode(PieceCodes& codes, Color& sideToMove) const;
+    bool decode(Board& board, Color& sideToMove) const;
+    bool decode(Game& game) const;
+
+    Color sideToMove() const { return (flags & BLACK_TO_MOVE) ? Color::BLACK : Color::RED; }
+    int pieceCount() const;
+
+    // Same value as Zobrist::hash() of the decoded position
+    std::uint64_t hash() const;
+
+    bool operator==(const PackedPosition& other) const;
+    bool operator!=(const PackedPosition& other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition is a fixed 32-byte record");
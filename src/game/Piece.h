@@ -12,9 +12,9 @@ struct Position {
     int row;
     int col;
     
-    Position(int r = 0, int c = 0) : row(r), col(c) {}
+    constexpr Position(int r = 0, int c = 0) : row(r), col(c) {}
     
-    bool operator==(const Position& other) const {
+    constexpr bool operator==(const Position& other) const {
         return row == other.row && col == other.col;
     }
 };
@@ -0,0 +1,43 @@
+#pragma once
+#include "Piece.h"
+#include <array>
+#include <cstdint>
+
+// Compact 4-bit piece code shared by the value-type board formats:
+// 0 = empty, bits 0-2 = PieceType + 1, bit 3 = Black
+using PieceCode = std::uint8_t;
+
+constexpr int BOARD_ROWS = 10;
+constexpr int BOARD_COLS = 9;
+constexpr int BOARD_SQUARES = BOARD_ROWS * BOARD_COLS;
+
+// One code per square, indexed by squareIndex()
+using PieceCodes = std::array<PieceCode, BOARD_SQUARES>;
+
+constexpr PieceCode EMPTY_CODE = 0;
+constexpr PieceCode BLACK_CODE_BIT = 8;
+
+constexpr PieceCode pieceCode(PieceType type, Color color) {
+    return static_cast<PieceCode>((color == Color::BLACK ? BLACK_CODE_BIT : 0) |
+                                  (static_cast<int>(type) + 1));
+}
+
+constexpr PieceType pieceCodeType(PieceCode code) {
+    return static_cast<PieceType>((code & 7) - 1);
+}
+
+constexpr Color pieceCodeColor(PieceCode code) {
+    return (code & BLACK_CODE_BIT) ? Color::BLACK : Color::RED;
+}
+
+constexpr int squareIndex(int row, int col) {
+    return (row - 1) * BOARD_COLS + (col - 1);
+}
+
+constexpr int squareIndex(const Position& pos) {
+    return squareIndex(pos.row, pos.col);
+}
+
+constexpr Position squarePosition(int square) {
+    return Position(square / BOARD_COLS + 1, square % BOARD_COLS + 1);
+}
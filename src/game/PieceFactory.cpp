@@ -0,0 +1,21 @@
+#include "PieceFactory.h"
+#include "General.h"
+#include "Guard.h"
+#include "Rook.h"
+#include "Horse.h"
+#include "Cannon.h"
+#include "Elephant.h"
+#include "Soldier.h"
+
+std::unique_ptr<Piece> PieceFactory::create(PieceType type, Color color) {
+    switch (type) {
+        case PieceType::GENERAL:  return std::make_unique<General>(color);
+        case PieceType::GUARD:    return std::make_unique<Guard>(color);
+        case PieceType::ROOK:     return std::make_unique<Rook>(color);
+        case PieceType::HORSE:    return std::make_unique<Horse>(color);
+        case PieceType::CANNON:   return std::make_unique<Cannon>(color);
+        case PieceType::ELEPHANT: return std::make_unique<Elephant>(color);
+        case PieceType::SOLDIER:  return std::make_unique<Soldier>(color);
+    }
+    return nullptr;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "Piece.h"
+#include <memory>
+
+class PieceFactory {
+public:
+    static std::unique_ptr<Piece> create(PieceType type, Color color);
+};
@@ -0,0 +1,15 @@
+#include "Zobrist.h"
+
+std::uint64_t Zobrist::hash(const PieceCodes& codes, Color sideToMove) {
+    std::uint64_t key = (sideToMove == Color::BLACK) ? sideKey() : 0;
+    for (int square = 0; square < BOARD_SQUARES; ++square) {
+        if (codes[square] != EMPTY_CODE) {
+            key ^= pieceKey(codes[square], square);
+        }
+    }
+    return key;
+}
+
+std::uint64_t Zobrist::hash(const Board& board, Color sideToMove) {
+    return hash(board.toCodes(), sideToMove);
+}
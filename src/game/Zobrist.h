@@ -0,0 +1,49 @@
+#pragma once
+#include "Board.h"
+#include <array>
+#include <cstdint>
+
+struct ZobristKeys {
+    std::array<std::array<std::uint64_t, BOARD_SQUARES>, 16> pieces{};
+    std::uint64_t blackToMove = 0;
+};
+
+// The key table is generated at compile time from a fixed seed (splitmix64), so
+// hashes are identical across builds and platforms and may be persisted.
+constexpr ZobristKeys generateZobristKeys(std::uint64_t seed) {
+    ZobristKeys keys;
+    auto next = [&seed]() {
+        std::uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    };
+    for (auto& codeKeys : keys.pieces) {
+        for (auto& key : codeKeys) {
+            key = next();
+        }
+    }
+    keys.blackToMove = next();
+    return keys;
+}
+
+inline constexpr ZobristKeys ZOBRIST_KEYS = generateZobristKeys(0x5851F42D4C957F2DULL);
+
+// 64-bit Zobrist position keys
+class Zobrist {
+public:
+    static constexpr std::uint64_t pieceKey(PieceCode code, int square) {
+        return ZOBRIST_KEYS.pieces[code][square];
+    }
+    static constexpr std::uint64_t sideKey() { return ZOBRIST_KEYS.blackToMove; }
+
+    // Key after moving 'moved' from one square to another, capturing 'captured' (or EMPTY_CODE)
+    static constexpr std::uint64_t afterMove(std::uint64_t key, PieceCode moved, PieceCode captured,
+                                             int fromSquare, int toSquare) {
+        key ^= pieceKey(moved, fromSquare) ^ pieceKey(moved, toSquare) ^ sideKey();
+        return (captured != EMPTY_CODE) ? key ^ pieceKey(captured, toSquare) : key;
+    }
+
+    static std::uint64_t hash(const PieceCodes& codes, Color sideToMove);
+    static std::uint64_t hash(const Board& board, Color sideToMove);
+};
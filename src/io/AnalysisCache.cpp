@@ -0,0 +1,118 @@
+#include "AnalysisCache.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+constexpr char CACHE_MAGIC[8] = {'X', 'Q', 'C', 'A', 'C', 'H', 'E', '1'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint64_t reserved;
+};
+
+} // namespace
+
+bool AnalysisCache::open(const std::string& path) {
+    close();
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool exists = false;
+    {
+        MappedFile file(path);
+        if (file.isOpen() && file.size() > 0) {
+            FileHeader header;
+            if (file.size() < sizeof(header)) {
+                return false;
+            }
+            std::memcpy(&header, file.data(), sizeof(header));
+            if (std::memcmp(header.magic, CACHE_MAGIC, 8) != 0) {
+                return false;
+            }
+            exists = true;
+            std::size_t count = (file.size() - sizeof(header)) / sizeof(CachedAnalysis);
+            entries_.reserve(entries_.size() + count);
+            for (std::size_t i = 0; i < count; ++i) {
+                CachedAnalysis entry;
+                std::memcpy(&entry, file.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+                auto [it, inserted] = entries_.emplace(entry.key, entry);
+                if (!inserted && entry.depth >= it->second.depth) {
+                    it->second = entry;
+                }
+            }
+            loaded_ = count;
+            if (sizeof(header) + count * sizeof(CachedAnalysis) != file.size()) {
+                // Drop the torn record so that appends stay aligned
+                file.close();
+                std::error_code error;
+                std::filesystem::resize_file(path, sizeof(header) + count * sizeof(CachedAnalysis), error);
+                if (error) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    log_.open(path, std::ios::binary | std::ios::app);
+    if (!log_) {
+        return false;
+    }
+    if (!exists) {
+        FileHeader header = {};
+        std::memcpy(header.magic, CACHE_MAGIC, 8);
+        log_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    return static_cast<bool>(log_);
+}
+
+void AnalysisCache::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (log_.is_open()) {
+        log_.close();
+    }
+}
+
+bool AnalysisCache::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!log_.is_open()) {
+        return true;
+    }
+    log_.flush();
+    return static_cast<bool>(log_);
+}
+
+bool AnalysisCache::lookup(std::uint64_t key, int minDepth, CachedAnalysis& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.depth < minDepth) {
+        return false;
+    }
+    out = it->second;
+    return true;
+}
+
+void AnalysisCache::store(std::uint64_t key, Move move, int score, int depth) {
+    CachedAnalysis entry = {};
+    entry.key = key;
+    entry.move = move.bits;
+    entry.score = static_cast<std::int16_t>(score);
+    entry.depth = static_cast<std::uint8_t>(std::min(std::max(depth, 0), 255));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [it, inserted] = entries_.emplace(key, entry);
+    if (!inserted) {
+        if (entry.depth <= it->second.depth) {
+            return;
+        }
+        it->second = entry;
+    }
+    if (log_.is_open()) {
+        log_.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+}
+
+std::size_t AnalysisCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "game/Move.h"
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Persistent store of search results keyed by position (Zobrist) key, so that
+// re-runs and overlapping games skip positions already searched deeply enough.
+// The file is an append-only log: a header, then one CachedAnalysis per
+// store(). open() replays it keeping the deepest result per key and ignores a
+// truncated last record, so an interrupted run loses at most its unflushed tail.
+// Scores are from the side to move; repetition history is not part of the key.
+struct CachedAnalysis {
+    std::uint64_t key;
+    std::uint16_t move;   // Move::bits
+    std::int16_t score;
+    std::uint8_t depth;
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(CachedAnalysis) == 16, "CachedAnalysis layout is part of the file format");
+
+class AnalysisCache {
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::uint64_t, CachedAnalysis> entries_;
+    std::ofstream log_;
+    std::uint64_t loaded_ = 0;
+
+public:
+    AnalysisCache() = default;
+    ~AnalysisCache() { close(); }
+
+    AnalysisCache(const AnalysisCache&) = delete;
+    AnalysisCache& operator=(const AnalysisCache&) = delete;
+
+    // Loads an existing log (or starts one); new results are appended to it.
+    // Without open() the cache lives in memory only.
+    bool open(const std::string& path);
+    void close();
+    bool flush();
+
+    // True if 'key' was searched to at least minDepth
+    bool lookup(std::uint64_t key, int minDepth, CachedAnalysis& out) const;
+    // Keeps the deeper of the new and the existing result; thread-safe
+    void store(std::uint64_t key, Move move, int score, int depth);
+
+    std::size_t size() const;
+    // Records read from the log by open(), duplicates included
+    std::uint64_t loaded() const { return loaded_; }
+};
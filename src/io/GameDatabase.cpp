@@ -0,0 +1,332 @@
+#include "GameDatabase.h"
+#include "game/Zobrist.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+constexpr char GAMES_MAGIC[8] = {'X', 'Q', 'G', 'A', 'M', 'E', 'S', '1'};
+constexpr char INDEX_MAGIC[8] = {'X', 'Q', 'I', 'N', 'D', 'E', 'X', '1'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint64_t reserved;
+};
+
+struct IndexHeader {
+    char magic[8];
+    std::uint64_t gameCount;
+    std::uint64_t entryCount;
+    std::uint64_t reserved;
+};
+
+bool keyLess(const PositionIndexEntry& a, const PositionIndexEntry& b) {
+    return a.key < b.key || (a.key == b.key && a.game < b.game);
+}
+
+// Walks the game log; onGame(offset, header, movesBytes) for each record
+template <typename OnGame>
+bool forEachStoredGame(std::string_view data, OnGame onGame) {
+    if (data.size() < sizeof(FileHeader) || std::memcmp(data.data(), GAMES_MAGIC, 8) != 0) {
+        return false;
+    }
+    std::size_t pos = sizeof(FileHeader);
+    while (pos + sizeof(StoredGameHeader) <= data.size()) {
+        StoredGameHeader header;
+        std::memcpy(&header, data.data() + pos, sizeof(header));
+        std::size_t movesBytes = header.plyCount * sizeof(std::uint16_t);
+        if (pos + sizeof(header) + movesBytes > data.size()) {
+            return false; // truncated append
+        }
+        onGame(pos, header, reinterpret_cast<const unsigned char*>(data.data() + pos + sizeof(header)));
+        pos += sizeof(header) + movesBytes;
+    }
+    return pos == data.size();
+}
+
+// Both squares on the board and a piece on the first: enough to replay the
+// move on a value board without reading or writing out of bounds
+bool isReplayable(const PieceCodes& codes, Move move) {
+    return move.from() < BOARD_SQUARES && move.to() < BOARD_SQUARES && codes[move.from()] != EMPTY_CODE;
+}
+
+void applyMove(PieceCodes& codes, Move move) {
+    codes[move.to()] = codes[move.from()];
+    codes[move.from()] = EMPTY_CODE;
+}
+
+// Length of the log up to the end of its last complete game
+std::size_t completeLength(std::string_view data) {
+    std::size_t end = sizeof(FileHeader);
+    forEachStoredGame(data, [&end](std::size_t offset, const StoredGameHeader& header, const unsigned char*) {
+        end = offset + sizeof(header) + header.plyCount * sizeof(std::uint16_t);
+    });
+    return end;
+}
+
+} // namespace
+
+Move StoredGame::move(int ply) const {
+    std::uint16_t bits;
+    std::memcpy(&bits, moves_ + ply * sizeof(bits), sizeof(bits));
+    return Move(bits);
+}
+
+bool GameDatabaseWriter::open(const std::string& basePath) {
+    std::string path = GameDatabase::gamesPath(basePath);
+    bool exists = false;
+    {
+        MappedFile existing(path);
+        if (existing.isOpen() && existing.size() > 0) {
+            // A partial header is damage, not a new file
+            if (existing.size() < sizeof(FileHeader) || std::memcmp(existing.data(), GAMES_MAGIC, 8) != 0) {
+                return false;
+            }
+            exists = true;
+            std::size_t length = completeLength(existing.view());
+            if (length != existing.size()) {
+                // Drop the torn game left by an interrupted append so new games follow a complete one
+                existing.close();
+                std::error_code error;
+                std::filesystem::resize_file(path, length, error);
+                if (error) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    games_.open(path, std::ios::binary | std::ios::app);
+    if (!games_) {
+        return false;
+    }
+    if (!exists) {
+        FileHeader header = {};
+        std::memcpy(header.magic, GAMES_MAGIC, 8);
+        games_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    return static_cast<bool>(games_);
+}
+
+bool GameDatabaseWriter::appendGame(const PackedPosition& start, const Move* moves, int plyCount, GameResult result) {
+    if (!games_ || plyCount < 0 || plyCount > UINT16_MAX) {
+        return false;
+    }
+    PieceCodes codes;
+    Color side;
+    if (!start.decode(codes, side)) {
+        return false;
+    }
+    for (int ply = 0; ply < plyCount; ++ply) {
+        if (!isReplayable(codes, moves[ply])) {
+            return false;
+        }
+        applyMove(codes, moves[ply]);
+    }
+    StoredGameHeader header = {};
+    header.plyCount = static_cast<std::uint32_t>(plyCount);
+    header.result = static_cast<std::uint8_t>(result);
+    header.start = start;
+
+    games_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    games_.write(reinterpret_cast<const char*>(moves), static_cast<std::streamsize>(plyCount * sizeof(Move)));
+    return static_cast<bool>(games_);
+}
+
+bool GameDatabaseWriter::appendRecord(const GameRecord& record, Game& scratch) {
+    PackedPosition start;
+    if (!Fen::parse(record.startFen(), scratch) || !PackedPosition::encode(scratch, start)) {
+        return false;
+    }
+
+    moves_.clear();
+    ReplayResult replay = record.replay(scratch, [this](int, const Position& from, const Position& to, const MoveResult&) {
+        moves_.push_back(Move(from, to));
+    });
+    if (!replay.ok) {
+        return false;
+    }
+    return appendGame(start, moves_.data(), static_cast<int>(moves_.size()), record.result());
+}
+
+bool GameDatabase::buildIndex(const std::string& basePath) {
+    MappedFile games(gamesPath(basePath));
+    if (!games.isOpen()) {
+        return false;
+    }
+
+    std::vector<std::uint64_t> offsets;
+    std::vector<PositionIndexEntry> entries;
+    bool damaged = false;
+    bool valid = forEachStoredGame(games.view(), [&](std::size_t offset, const StoredGameHeader& header,
+                                                     const unsigned char* moveBytes) {
+        std::uint32_t gameNumber = static_cast<std::uint32_t>(offsets.size());
+        offsets.push_back(offset);
+
+        PieceCodes codes;
+        Color side;
+        if (!header.start.decode(codes, side)) {
+            return;
+        }
+
+        // Replay on the value board with incremental keys
+        std::uint64_t key = Zobrist::hash(codes, side);
+        PositionIndexEntry entry = {};
+        entry.game = gameNumber;
+        entry.result = header.result;
+        for (std::uint32_t ply = 0;; ++ply) {
+            entry.key = key;
+            entry.ply = static_cast<std::uint16_t>(ply);
+            entries.push_back(entry);
+            if (ply == header.plyCount) {
+                break;
+            }
+
+            std::uint16_t bits;
+            std::memcpy(&bits, moveBytes + ply * sizeof(bits), sizeof(bits));
+            Move move(bits);
+            if (!isReplayable(codes, move)) {
+                damaged = true;
+                return;
+            }
+            key = Zobrist::afterMove(key, codes[move.from()], codes[move.to()], move.from(), move.to());
+            applyMove(codes, move);
+        }
+    });
+    if (!valid || damaged) {
+        return false;
+    }
+
+    // One entry per (position, game): keep the earliest ply a game reached it
+    std::sort(entries.begin(), entries.end(), [](const PositionIndexEntry& a, const PositionIndexEntry& b) {
+        return keyLess(a, b) || (a.key == b.key && a.game == b.game && a.ply < b.ply);
+    });
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const PositionIndexEntry& a, const PositionIndexEntry& b) {
+        return a.key == b.key && a.game == b.game;
+    }), entries.end());
+
+    std::string path = indexPath(basePath);
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        IndexHeader header = {};
+        std::memcpy(header.magic, INDEX_MAGIC, 8);
+        header.gameCount = offsets.size();
+        header.entryCount = entries.size();
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()), static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+        out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PositionIndexEntry)));
+        if (!out) {
+            return false;
+        }
+    }
+    // Readers keep mapping the old index until the rename lands
+#ifdef _WIN32
+    std::remove(path.c_str());
+#endif
+    return std::rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool GameDatabase::open(const std::string& basePath) {
+    close();
+    if (!games_.open(gamesPath(basePath)) || !index_.open(indexPath(basePath))) {
+        close();
+        return false;
+    }
+
+    IndexHeader header;
+    if (index_.size() < sizeof(header)) {
+        close();
+        return false;
+    }
+    std::memcpy(&header, index_.data(), sizeof(header));
+    std::uint64_t expected = sizeof(header) + header.gameCount * sizeof(std::uint64_t) +
+                             header.entryCount * sizeof(PositionIndexEntry);
+    if (std::memcmp(header.magic, INDEX_MAGIC, 8) != 0 || index_.size() != expected) {
+        close();
+        return false;
+    }
+
+    gameCount_ = header.gameCount;
+    entryCount_ = header.entryCount;
+    gameOffsets_ = reinterpret_cast<const std::uint64_t*>(index_.data() + sizeof(header));
+    entries_ = reinterpret_cast<const PositionIndexEntry*>(gameOffsets_ + gameCount_);
+    return true;
+}
+
+void GameDatabase::close() {
+    games_.close();
+    index_.close();
+    gameOffsets_ = nullptr;
+    entries_ = nullptr;
+    gameCount_ = 0;
+    entryCount_ = 0;
+}
+
+PositionMatches GameDatabase::find(std::uint64_t key) const {
+    PositionMatches matches;
+    const PositionIndexEntry* end = entries_ + entryCount_;
+    matches.first = std::lower_bound(entries_, end, key, [](const PositionIndexEntry& entry, std::uint64_t value) {
+        return entry.key < value;
+    });
+    matches.last = std::upper_bound(matches.first, end, key, [](std::uint64_t value, const PositionIndexEntry& entry) {
+        return value < entry.key;
+    });
+    return matches;
+}
+
+PositionMatches GameDatabase::find(const Board& board, Color sideToMove) const {
+    return find(Zobrist::hash(board, sideToMove));
+}
+
+PositionStats GameDatabase::stats(std::uint64_t key) const {
+    PositionStats stats;
+    for (const PositionIndexEntry& entry : find(key)) {
+        ++stats.games;
+        switch (static_cast<GameResult>(entry.result)) {
+            case GameResult::RED_WIN: ++stats.redWins; break;
+            case GameResult::BLACK_WIN: ++stats.blackWins; break;
+            case GameResult::DRAW: ++stats.draws; break;
+            default: break;
+        }
+    }
+    return stats;
+}
+
+bool GameDatabase::game(std::uint32_t index, StoredGame& out) const {
+    if (index >= gameCount_) {
+        return false;
+    }
+    std::uint64_t offset = gameOffsets_[index];
+    StoredGameHeader header;
+    if (offset + sizeof(header) > games_.size()) {
+        return false;
+    }
+    std::memcpy(&header, games_.data() + offset, sizeof(header));
+    if (offset + sizeof(header) + header.plyCount * sizeof(std::uint16_t) > games_.size()) {
+        return false;
+    }
+
+    out.start = header.start;
+    out.result = static_cast<GameResult>(header.result);
+    out.plyCount = static_cast<int>(header.plyCount);
+    out.moves_ = reinterpret_cast<const unsigned char*>(games_.data() + offset + sizeof(header));
+    return true;
+}
+
+bool GameDatabase::replay(std::uint32_t index, Game& game, int plies) const {
+    StoredGame stored;
+    if (!this->game(index, stored) || !stored.start.decode(game)) {
+        return false;
+    }
+    int count = (plies < 0 || plies > stored.plyCount) ? stored.plyCount : plies;
+    for (int ply = 0; ply < count; ++ply) {
+        Move move = stored.move(ply);
+        if (!game.makeMove(move.fromPosition(), move.toPosition()).isLegal) {
+            return false;
+        }
+    }
+    return true;
+}
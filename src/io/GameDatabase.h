@@ -0,0 +1,112 @@
+#pragma once
+#include "GameRecord.h"
+#include "MappedFile.h"
+#include "game/Move.h"
+#include "game/PackedPosition.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// On-disk game database made of two files next to each other:
+//   <base>.games  append-only log of games: start position + 16-bit moves
+//   <base>.index  game offsets plus every (position key, game, ply) sorted by key
+// Both are read through MappedFile, so a query is one binary search over the
+// mapped index with no parsing. Integers are stored in host (little-endian) order.
+
+struct StoredGameHeader {
+    std::uint32_t plyCount;
+    std::uint8_t result; // GameResult
+    std::uint8_t reserved[3];
+    PackedPosition start;
+};
+static_assert(sizeof(StoredGameHeader) == 40, "StoredGameHeader layout is part of the file format");
+
+struct PositionIndexEntry {
+    std::uint64_t key;
+    std::uint32_t game;
+    std::uint16_t ply;
+    std::uint8_t result; // GameResult
+    std::uint8_t reserved;
+};
+static_assert(sizeof(PositionIndexEntry) == 16, "PositionIndexEntry layout is part of the file format");
+
+struct PositionStats {
+    std::uint32_t games = 0;
+    std::uint32_t redWins = 0;
+    std::uint32_t blackWins = 0;
+    std::uint32_t draws = 0;
+};
+
+// Range of index entries for one position key, ordered by game number
+struct PositionMatches {
+    const PositionIndexEntry* first = nullptr;
+    const PositionIndexEntry* last = nullptr;
+
+    const PositionIndexEntry* begin() const { return first; }
+    const PositionIndexEntry* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+class StoredGame {
+private:
+    const unsigned char* moves_ = nullptr;
+
+    friend class GameDatabase;
+
+public:
+    PackedPosition start;
+    GameResult result = GameResult::UNKNOWN;
+    int plyCount = 0;
+
+    Move move(int ply) const;
+};
+
+class GameDatabaseWriter {
+private:
+    std::ofstream games_;
+    std::vector<Move> moves_;
+
+public:
+    bool open(const std::string& basePath);
+    void close() { games_.close(); }
+
+    // Refuses a start that does not decode and moves that are off the board
+    // or move no piece; legality is the caller's business
+    bool appendGame(const PackedPosition& start, const Move* moves, int plyCount, GameResult result);
+    // Replays the record through Game::makeMove; illegal games are rejected
+    bool appendRecord(const GameRecord& record, Game& scratch);
+};
+
+class GameDatabase {
+private:
+    MappedFile games_;
+    MappedFile index_;
+    const std::uint64_t* gameOffsets_ = nullptr;
+    const PositionIndexEntry* entries_ = nullptr;
+    std::uint64_t gameCount_ = 0;
+    std::uint64_t entryCount_ = 0;
+
+public:
+    static std::string gamesPath(const std::string& basePath) { return basePath + ".games"; }
+    static std::string indexPath(const std::string& basePath) { return basePath + ".index"; }
+
+    // Rewrites <base>.index from <base>.games; false if a stored move is off
+    // the board or moves no piece
+    static bool buildIndex(const std::string& basePath);
+
+    bool open(const std::string& basePath);
+    void close();
+
+    std::uint64_t gameCount() const { return gameCount_; }
+    std::uint64_t entryCount() const { return entryCount_; }
+
+    PositionMatches find(std::uint64_t key) const;
+    PositionMatches find(const Board& board, Color sideToMove) const;
+    PositionStats stats(std::uint64_t key) const;
+
+    bool game(std::uint32_t index, StoredGame& out) const;
+    // Replays game 'index' up to 'plies' moves (all when negative)
+    bool replay(std::uint32_t index, Game& game, int plies = -1) const;
+};
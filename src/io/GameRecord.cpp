@@ -0,0 +1,124 @@
+#include "GameRecord.h"
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isTokenEnd(char c) {
+    return isSpace(c) || c == '{' || c == '(' || c == ';';
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+void MoveTokens::Iterator::advance() {
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (isSpace(c)) {
+            ++pos_;
+        } else if (c == '{') {
+            std::size_t close = text_.find('}', pos_);
+            pos_ = (close == std::string_view::npos) ? text_.size() : close + 1;
+        } else if (c == ';') {
+            std::size_t eol = text_.find('\n', pos_);
+            pos_ = (eol == std::string_view::npos) ? text_.size() : eol + 1;
+        } else if (c == '(') {
+            int depth = 0;
+            for (; pos_ < text_.size(); ++pos_) {
+                if (text_[pos_] == '(') {
+                    ++depth;
+                } else if (text_[pos_] == ')' && --depth == 0) {
+                    ++pos_;
+                    break;
+                }
+            }
+        } else {
+            std::size_t start = pos_;
+            while (pos_ < text_.size() && !isTokenEnd(text_[pos_])) {
+                ++pos_;
+            }
+            std::string_view token = text_.substr(start, pos_ - start);
+
+            if (token[0] == '$') {
+                continue; // numeric annotation glyph
+            }
+            if (parseResult(token) != GameResult::UNKNOWN || token == "*") {
+                break; // result terminator ends the move text
+            }
+
+            // Strip a leading move number ("12." / "12..." / "12.h2e2")
+            std::size_t digits = 0;
+            while (digits < token.size() && isDigit(token[digits])) {
+                ++digits;
+            }
+            if (digits > 0 && digits < token.size() && token[digits] == '.') {
+                while (digits < token.size() && token[digits] == '.') {
+                    ++digits;
+                }
+                token.remove_prefix(digits);
+                if (token.empty()) {
+                    continue;
+                }
+            }
+
+            token_ = token;
+            return;
+        }
+    }
+    done_ = true;
+    pos_ = text_.size();
+}
+
+GameResult MoveTokens::parseResult(std::string_view token) {
+    if (token == "1-0") {
+        return GameResult::RED_WIN;
+    }
+    if (token == "0-1") {
+        return GameResult::BLACK_WIN;
+    }
+    if (token == "1/2-1/2") {
+        return GameResult::DRAW;
+    }
+    return GameResult::UNKNOWN;
+}
+
+std::string_view GameRecord::header(std::string_view tag) const {
+    for (int i = 0; i < headerCount_; ++i) {
+        if (headers_[i].tag == tag) {
+            return headers_[i].value;
+        }
+    }
+    return {};
+}
+
+GameResult GameRecord::result() const {
+    GameResult fromHeader = MoveTokens::parseResult(header("Result"));
+    if (fromHeader != GameResult::UNKNOWN) {
+        return fromHeader;
+    }
+
+    // Last whitespace-separated token of the move text
+    std::string_view text = moveText_;
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    std::size_t start = text.size();
+    while (start > 0 && !isSpace(text[start - 1])) {
+        --start;
+    }
+    return MoveTokens::parseResult(text.substr(start));
+}
+
+std::string_view GameRecord::startFen() const {
+    std::string_view fen = header("FEN");
+    return fen.empty() ? Fen::START_POSITION : fen;
+}
+
+ReplayResult GameRecord::replay(Game& game) const {
+    return replay(game, [](int, const Position&, const Position&, const MoveResult&) {});
+}
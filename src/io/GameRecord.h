@@ -0,0 +1,131 @@
+#pragma once
+#include "game/Fen.h"
+#include "game/Game.h"
+#include "game/Notation.h"
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+
+enum class GameResult {
+    UNKNOWN, RED_WIN, BLACK_WIN, DRAW
+};
+
+struct GameHeader {
+    std::string_view tag;
+    std::string_view value;
+};
+
+struct ReplayResult {
+    bool ok = true;
+    int plies = 0;
+    std::string_view failedToken; // first token that did not parse or was illegal
+};
+
+// Tokenizer over PGN-style move text. Skips move numbers, {comments}, ;comments,
+// (variations) and $NAGs, and stops at the result terminator. Tokens are views
+// into the record, so iterating never allocates.
+class MoveTokens {
+private:
+    std::string_view text_;
+
+public:
+    class Iterator {
+    private:
+        std::string_view text_;
+        std::size_t pos_ = 0;
+        std::string_view token_;
+        bool done_ = true;
+
+        void advance();
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        Iterator() = default;
+        explicit Iterator(std::string_view text) : text_(text), done_(false) { advance(); }
+
+        reference operator*() const { return token_; }
+        Iterator& operator++() { advance(); return *this; }
+        bool operator==(const Iterator& other) const { return done_ == other.done_ && (done_ || pos_ == other.pos_); }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+    };
+
+    explicit MoveTokens(std::string_view text) : text_(text) {}
+    Iterator begin() const { return Iterator(text_); }
+    Iterator end() const { return Iterator(); }
+
+    static GameResult parseResult(std::string_view token);
+};
+
+// One game from a record file. All fields are views into the source buffer and
+// stay valid as long as that buffer does.
+class GameRecord {
+public:
+    static constexpr int MAX_HEADERS = 32;
+
+private:
+    GameHeader headers_[MAX_HEADERS];
+    int headerCount_ = 0;
+    std::string_view moveText_;
+    std::string_view raw_;
+
+    friend class GameRecordReader;
+
+public:
+    void clear() { headerCount_ = 0; moveText_ = {}; raw_ = {}; }
+
+    int headerCount() const { return headerCount_; }
+    const GameHeader& headerAt(int index) const { return headers_[index]; }
+    std::string_view header(std::string_view tag) const;
+
+    std::string_view moveText() const { return moveText_; }
+    std::string_view raw() const { return raw_; }
+    MoveTokens moves() const { return MoveTokens(moveText_); }
+
+    // From the Result header, falling back to the move text terminator
+    GameResult result() const;
+    // From the FEN header, falling back to the initial position
+    std::string_view startFen() const;
+
+    // Replays the game through Game::makeMove from its start position, calling
+    // onMove(ply, from, to, moveResult) after every executed move
+    template <typename OnMove>
+    ReplayResult replay(Game& game, OnMove&& onMove) const;
+    ReplayResult replay(Game& game) const;
+};
+
+template <typename OnMove>
+ReplayResult GameRecord::replay(Game& game, OnMove&& onMove) const {
+    ReplayResult result;
+    if (!Fen::parse(startFen(), game)) {
+        result.ok = false;
+        return result;
+    }
+
+    for (std::string_view token : moves()) {
+        Position from, to;
+        if (!Notation::parseMove(token, game.getBoard(), game.getCurrentPlayer(), from, to)) {
+            result.ok = false;
+            result.failedToken = token;
+            return result;
+        }
+
+        MoveResult move = game.makeMove(from, to);
+        if (!move.isLegal) {
+            result.ok = false;
+            result.failedToken = token;
+            return result;
+        }
+
+        onMove(result.plies, from, to, move);
+        ++result.plies;
+        if (move.gameEnded) {
+            break;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,171 @@
+#include "GameRecordReader.h"
+#include <cstring>
+
+namespace {
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+std::size_t lineEnd(std::string_view data, std::size_t pos) {
+    const void* eol = std::memchr(data.data() + pos, '\n', data.size() - pos);
+    return eol ? static_cast<const char*>(eol) - data.data() : data.size();
+}
+
+bool isHeaderLine(std::string_view data, std::size_t lineStart) {
+    return lineStart < data.size() && data[lineStart] == '[';
+}
+
+std::size_t skipWhitespace(std::string_view data, std::size_t pos) {
+    // Also skips a UTF-8 byte order mark at the very start
+    if (pos == 0 && data.size() >= 3 && data.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        pos = 3;
+    }
+    while (pos < data.size() && isSpace(data[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+} // namespace
+
+std::size_t GameRecordReader::findGameEnd(std::string_view data, std::size_t start) {
+    // Skip this game's own header block
+    std::size_t pos = start;
+    while (isHeaderLine(data, pos)) {
+        pos = lineEnd(data, pos);
+        pos = skipWhitespace(data, pos);
+    }
+
+    // The game ends at the first header line after its move text
+    while (pos < data.size()) {
+        std::size_t eol = lineEnd(data, pos);
+        if (eol >= data.size()) {
+            return data.size();
+        }
+        pos = eol + 1;
+        if (isHeaderLine(data, pos)) {
+            return pos;
+        }
+    }
+    return data.size();
+}
+
+void GameRecordReader::parseRecord(std::string_view text, GameRecord& record) {
+    record.clear();
+    record.raw_ = text;
+
+    std::size_t pos = 0;
+    while (isHeaderLine(text, pos)) {
+        std::size_t eol = lineEnd(text, pos);
+        std::string_view line = trim(text.substr(pos + 1, eol - pos - 1));
+        if (!line.empty() && line.back() == ']') {
+            line.remove_suffix(1);
+        }
+
+        std::size_t space = line.find(' ');
+        std::size_t openQuote = line.find('"');
+        std::size_t closeQuote = line.rfind('"');
+        if (space != std::string_view::npos && openQuote != std::string_view::npos &&
+            closeQuote > openQuote && record.headerCount_ < GameRecord::MAX_HEADERS) {
+            GameHeader& header = record.headers_[record.headerCount_++];
+            header.tag = line.substr(0, space);
+            header.value = line.substr(openQuote + 1, closeQuote - openQuote - 1);
+        }
+        pos = skipWhitespace(text, eol);
+    }
+
+    record.moveText_ = trim(text.substr(pos < text.size() ? pos : text.size()));
+}
+
+bool GameRecordReader::next(GameRecord& record) {
+    pos_ = skipWhitespace(data_, pos_);
+    if (pos_ >= data_.size()) {
+        return false;
+    }
+
+    std::size_t end = findGameEnd(data_, pos_);
+    parseRecord(data_.substr(pos_, end - pos_), record);
+    pos_ = end;
+    return true;
+}
+
+std::vector<std::string_view> GameRecordReader::splitChunks(std::string_view data, std::size_t chunkCount) {
+    std::vector<std::string_view> chunks;
+    if (chunkCount == 0) {
+        chunkCount = 1;
+    }
+    chunks.reserve(chunkCount);
+
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i <= chunkCount && begin < data.size(); ++i) {
+        std::size_t end = data.size();
+        if (i < chunkCount) {
+            // Move the nominal cut forward to the start of the next game
+            std::size_t pos = data.size() / chunkCount * i;
+            pos = (pos <= begin) ? begin : pos;
+            while (pos > begin && data[pos - 1] != '\n') {
+                --pos;
+            }
+            while (isHeaderLine(data, pos)) {
+                pos = skipWhitespace(data, lineEnd(data, pos));
+            }
+            end = findGameEnd(data, pos);
+        }
+        if (end > begin) {
+            chunks.push_back(data.substr(begin, end - begin));
+        }
+        begin = end;
+    }
+    return chunks;
+}
+
+GameRecordStream::GameRecordStream(std::istream& in, std::size_t blockSize)
+    : in_(in), buffer_(blockSize == 0 ? 4096 : blockSize) {}
+
+void GameRecordStream::fill() {
+    // Keep the unconsumed tail, grow only when one game exceeds the buffer
+    if (begin_ > 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    if (end_ == buffer_.size()) {
+        buffer_.resize(buffer_.size() * 2);
+    }
+
+    in_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+    end_ += static_cast<std::size_t>(in_.gcount());
+    if (in_.gcount() == 0 || !in_) {
+        eof_ = true;
+    }
+}
+
+bool GameRecordStream::next(GameRecord& record) {
+    while (true) {
+        std::string_view pending(buffer_.data() + begin_, end_ - begin_);
+        std::size_t start = skipWhitespace(pending, 0);
+        if (start < pending.size()) {
+            std::size_t end = GameRecordReader::findGameEnd(pending, start);
+            // A game running to the end of the buffer may continue in the next block
+            if (end < pending.size() || eof_) {
+                GameRecordReader::parseRecord(pending.substr(start, end - start), record);
+                begin_ += end;
+                return true;
+            }
+        } else if (eof_) {
+            return false;
+        }
+        fill();
+    }
+}
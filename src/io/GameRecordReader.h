@@ -0,0 +1,77 @@
+#pragma once
+#include "GameRecord.h"
+#include "diagnostics/Trace.h"
+#include <cstddef>
+#include <istream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Splits a buffer of PGN-style game records into games. A game is a block of
+// "[Tag "Value"]" header lines followed by move text, and ends where the next
+// header block starts (header lines must begin at column 0). The buffer is
+// typically a MappedFile; records point into it and nothing is copied.
+class GameRecordReader {
+private:
+    std::string_view data_;
+    std::size_t pos_ = 0;
+
+public:
+    explicit GameRecordReader(std::string_view data) : data_(data) {}
+
+    bool next(GameRecord& record);
+    std::size_t offset() const { return pos_; }
+
+    // Offset where the game starting at 'start' ends (the next header block or the end)
+    static std::size_t findGameEnd(std::string_view data, std::size_t start);
+    static void parseRecord(std::string_view text, GameRecord& record);
+
+    // Cuts data into at most chunkCount pieces, each starting on a game boundary
+    static std::vector<std::string_view> splitChunks(std::string_view data, std::size_t chunkCount);
+
+    // Parses chunks on threadCount threads. Each worker owns a Game and calls
+    // onGame(record, game, workerIndex) for every game in its chunk.
+    template <typename OnGame>
+    static void forEachGameParallel(std::string_view data, unsigned threadCount, OnGame onGame);
+};
+
+// Buffered reader for sources that cannot be mapped (pipes, compressed streams).
+// Reads large blocks, hands out complete games and carries partial ones over to
+// the next block; records stay valid until the next call to next().
+class GameRecordStream {
+private:
+    std::istream& in_;
+    std::vector<char> buffer_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    bool eof_ = false;
+
+    void fill();
+
+public:
+    explicit GameRecordStream(std::istream& in, std::size_t blockSize = 1 << 20);
+
+    bool next(GameRecord& record);
+};
+
+template <typename OnGame>
+void GameRecordReader::forEachGameParallel(std::string_view data, unsigned threadCount, OnGame onGame) {
+    std::vector<std::string_view> chunks = splitChunks(data, threadCount == 0 ? 1 : threadCount);
+    std::vector<std::thread> workers;
+    workers.reserve(chunks.size());
+
+    for (unsigned worker = 0; worker < chunks.size(); ++worker) {
+        workers.emplace_back([&onGame, &chunks, worker]() {
+            TRACE_SPAN_ARG("game batch", "worker", worker);
+            Game game;
+            GameRecord record;
+            GameRecordReader reader(chunks[worker]);
+            while (reader.next(record)) {
+                onGame(record, game, worker);
+            }
+        });
+    }
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+}
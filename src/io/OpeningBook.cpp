@@ -0,0 +1,241 @@
+#include "OpeningBook.h"
+#include "diagnostics/Trace.h"
+#include "game/Zobrist.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+constexpr char BOOK_MAGIC[8] = {'X', 'Q', 'B', 'O', 'O', 'K', '0', '1'};
+
+struct BookHeader {
+    char magic[8];
+    std::uint64_t entryCount;
+};
+
+// Below this many entries interpolation gains nothing over bisection
+constexpr std::uint64_t INTERPOLATION_MIN_SPAN = 64;
+
+} // namespace
+
+bool OpeningBook::open(const std::string& path) {
+    close();
+    if (!file_.open(path) || file_.size() < sizeof(BookHeader)) {
+        close();
+        return false;
+    }
+
+    BookHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+    if (std::memcmp(header.magic, BOOK_MAGIC, 8) != 0 ||
+        file_.size() != sizeof(header) + header.entryCount * sizeof(BookEntry)) {
+        close();
+        return false;
+    }
+
+    entries_ = reinterpret_cast<const BookEntry*>(file_.data() + sizeof(header));
+    entryCount_ = header.entryCount;
+    return true;
+}
+
+void OpeningBook::close() {
+    file_.close();
+    entries_ = nullptr;
+    entryCount_ = 0;
+}
+
+const BookEntry* OpeningBook::lowerBound(std::uint64_t key) const {
+    // Keys are Zobrist hashes, i.e. uniform, so interpolation lands close to the
+    // target in a couple of steps; finish with a plain binary search
+    std::uint64_t low = 0;
+    std::uint64_t high = entryCount_;
+    while (high - low > INTERPOLATION_MIN_SPAN) {
+        std::uint64_t lowKey = entries_[low].key;
+        std::uint64_t highKey = entries_[high - 1].key;
+        if (key <= lowKey) {
+            high = low;
+            break;
+        }
+        if (key > highKey) {
+            low = high;
+            break;
+        }
+
+        double fraction = static_cast<double>(key - lowKey) / static_cast<double>(highKey - lowKey);
+        std::uint64_t probe = low + static_cast<std::uint64_t>(fraction * static_cast<double>(high - 1 - low));
+        probe = std::min(std::max(probe, low), high - 1);
+        if (entries_[probe].key < key) {
+            low = probe + 1;
+        } else {
+            if (probe == low || entries_[probe - 1].key < key) {
+                return entries_ + probe;
+            }
+            high = probe;
+        }
+    }
+
+    return std::lower_bound(entries_ + low, entries_ + high, key, [](const BookEntry& entry, std::uint64_t value) {
+        return entry.key < value;
+    });
+}
+
+BookMoves OpeningBook::probe(std::uint64_t key) const {
+    TRACE_SPAN("book probe");
+    BookMoves moves;
+    if (entryCount_ == 0) {
+        return moves;
+    }
+    const BookEntry* end = entries_ + entryCount_;
+    moves.first = lowerBound(key);
+    moves.last = moves.first;
+    while (moves.last != end && moves.last->key == key) {
+        ++moves.last;
+    }
+    return moves;
+}
+
+BookMoves OpeningBook::probe(const Game& game) const {
+    return probe(Zobrist::hash(game.getBoard(), game.getCurrentPlayer()));
+}
+
+Move OpeningBook::pick(std::uint64_t key, std::uint64_t random) const {
+    BookMoves moves = probe(key);
+    std::uint64_t total = 0;
+    for (const BookEntry& entry : moves) {
+        total += entry.weight;
+    }
+    if (total == 0) {
+        return Move();
+    }
+
+    std::uint64_t target = random % total;
+    for (const BookEntry& entry : moves) {
+        if (target < entry.weight) {
+            return Move(entry.move);
+        }
+        target -= entry.weight;
+    }
+    return Move();
+}
+
+Move OpeningBook::pick(const Game& game, std::uint64_t random) const {
+    BookMoves moves = probe(game);
+    std::uint64_t total = 0;
+    for (const BookEntry& entry : moves) {
+        Move move(entry.move);
+        if (game.isMoveLegal(move.fromPosition(), move.toPosition())) {
+            total += entry.weight;
+        }
+    }
+    if (total == 0) {
+        return Move();
+    }
+
+    std::uint64_t target = random % total;
+    for (const BookEntry& entry : moves) {
+        Move move(entry.move);
+        if (!game.isMoveLegal(move.fromPosition(), move.toPosition())) {
+            continue;
+        }
+        if (target < entry.weight) {
+            return move;
+        }
+        target -= entry.weight;
+    }
+    return Move();
+}
+
+Move OpeningBook::best(std::uint64_t key) const {
+    // Entries of a position are stored by descending weight
+    BookMoves moves = probe(key);
+    return moves.empty() ? Move() : Move(moves.first->move);
+}
+
+void OpeningBookBuilder::add(std::uint64_t key, Move move, Color mover, GameResult result) {
+    Stats& stats = stats_[KeyMove{key, move.bits}];
+    ++stats.games;
+    if (result == GameResult::DRAW) {
+        ++stats.draws;
+    } else if ((result == GameResult::RED_WIN && mover == Color::RED) ||
+               (result == GameResult::BLACK_WIN && mover == Color::BLACK)) {
+        ++stats.wins;
+    }
+}
+
+bool OpeningBookBuilder::addGame(const GameRecord& record, Game& scratch) {
+    GameResult result = record.result();
+    if (!Fen::parse(record.startFen(), scratch)) {
+        return false;
+    }
+
+    int ply = 0;
+    for (std::string_view token : record.moves()) {
+        if (ply++ >= maxPly_) {
+            break;
+        }
+        Position from, to;
+        Color mover = scratch.getCurrentPlayer();
+        if (!Notation::parseMove(token, scratch.getBoard(), mover, from, to)) {
+            return false;
+        }
+        std::uint64_t key = Zobrist::hash(scratch.getBoard(), mover);
+        MoveResult move = scratch.makeMove(from, to);
+        if (!move.isLegal) {
+            return false;
+        }
+        add(key, Move(from, to), mover, result);
+        if (move.gameEnded) {
+            break;
+        }
+    }
+    return true;
+}
+
+void OpeningBookBuilder::merge(const OpeningBookBuilder& other) {
+    for (const auto& [keyMove, stats] : other.stats_) {
+        Stats& merged = stats_[keyMove];
+        merged.games += stats.games;
+        merged.wins += stats.wins;
+        merged.draws += stats.draws;
+    }
+}
+
+bool OpeningBookBuilder::write(const std::string& path, std::uint32_t minGames) const {
+    std::vector<BookEntry> entries;
+    entries.reserve(stats_.size());
+    for (const auto& [keyMove, stats] : stats_) {
+        if (stats.games < minGames) {
+            continue;
+        }
+        BookEntry entry = {};
+        entry.key = keyMove.key;
+        entry.move = keyMove.move;
+        entry.games = stats.games;
+        entry.wins = stats.wins;
+        entry.draws = stats.draws;
+        // Weight by points scored (in half points); never-scoring moves stay
+        // visible for statistics but are not picked
+        entry.weight = static_cast<std::uint16_t>(std::min<std::uint64_t>(2ULL * stats.wins + stats.draws, UINT16_MAX));
+        entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const BookEntry& a, const BookEntry& b) {
+        if (a.key != b.key) {
+            return a.key < b.key;
+        }
+        if (a.weight != b.weight) {
+            return a.weight > b.weight;
+        }
+        return a.move < b.move;
+    });
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    BookHeader header = {};
+    std::memcpy(header.magic, BOOK_MAGIC, 8);
+    header.entryCount = entries.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(BookEntry)));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "GameRecord.h"
+#include "MappedFile.h"
+#include "game/Move.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+// Opening book file: a header followed by BookEntry records sorted by position
+// key (then by descending weight). The file is mapped read-only and shared, so
+// every engine process probing the same book shares one copy in memory.
+struct BookEntry {
+    std::uint64_t key;
+    std::uint16_t move;   // Move::bits
+    std::uint16_t weight; // relative pick probability within the position
+    std::uint32_t games;
+    std::uint32_t wins;   // for the side to move
+    std::uint32_t draws;
+};
+static_assert(sizeof(BookEntry) == 24, "BookEntry layout is part of the file format");
+
+struct BookMoves {
+    const BookEntry* first = nullptr;
+    const BookEntry* last = nullptr;
+
+    const BookEntry* begin() const { return first; }
+    const BookEntry* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+    bool empty() const { return first == last; }
+};
+
+class OpeningBook {
+private:
+    MappedFile file_;
+    const BookEntry* entries_ = nullptr;
+    std::uint64_t entryCount_ = 0;
+
+    const BookEntry* lowerBound(std::uint64_t key) const;
+
+public:
+    bool open(const std::string& path);
+    void close();
+
+    std::uint64_t entryCount() const { return entryCount_; }
+
+    BookMoves probe(std::uint64_t key) const;
+    BookMoves probe(const Game& game) const;
+
+    // Weighted-random choice; 'random' is any uniformly distributed 64-bit value
+    // so callers control determinism. Returns a null Move when out of book.
+    Move pick(std::uint64_t key, std::uint64_t random) const;
+    // Same, but skips entries that are not legal in 'game' (guards hash collisions)
+    Move pick(const Game& game, std::uint64_t random) const;
+    Move best(std::uint64_t key) const;
+};
+
+class OpeningBookBuilder {
+private:
+    struct Stats {
+        std::uint32_t games = 0;
+        std::uint32_t wins = 0;
+        std::uint32_t draws = 0;
+    };
+    struct KeyMove {
+        std::uint64_t key;
+        std::uint16_t move;
+        bool operator==(const KeyMove& other) const { return key == other.key && move == other.move; }
+    };
+    struct KeyMoveHash {
+        std::size_t operator()(const KeyMove& value) const {
+            return static_cast<std::size_t>(value.key ^ (value.move * 0x9E3779B97F4A7C15ULL));
+        }
+    };
+
+    std::unordered_map<KeyMove, Stats, KeyMoveHash> stats_;
+    int maxPly_;
+
+public:
+    explicit OpeningBookBuilder(int maxPly = 20) : maxPly_(maxPly) {}
+
+    void add(std::uint64_t key, Move move, Color mover, GameResult result);
+    // Replays the first maxPly moves of the record; returns false if it is illegal
+    bool addGame(const GameRecord& record, Game& scratch);
+    void merge(const OpeningBookBuilder& other);
+
+    std::size_t size() const { return stats_.size(); }
+
+    // Keeps moves played at least minGames times
+    bool write(const std::string& path, std::uint32_t minGames = 1) const;
+};
@@ -0,0 +1,163 @@
+#include "TrainingData.h"
+#include <cstring>
+#ifdef CHINESE_CHESS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+constexpr char TRAINING_MAGIC[8] = {'X', 'Q', 'T', 'R', 'A', 'I', 'N', '1'};
+
+struct FileHeader {
+    char magic[8];
+    std::uint64_t reserved;
+};
+
+} // namespace
+
+TrainingDataWriter::Buffer::Buffer(TrainingDataWriter& writer) : writer_(&writer) {
+    records_.reserve(CHUNK_RECORDS);
+}
+
+void TrainingDataWriter::Buffer::add(const TrainingRecord& record) {
+    records_.push_back(record);
+    if (records_.size() == CHUNK_RECORDS) {
+        flush();
+    }
+}
+
+bool TrainingDataWriter::Buffer::flush() {
+    if (records_.empty()) {
+        return true;
+    }
+    bool ok = writer_->writeChunk(records_.data(), records_.size(), scratch_);
+    records_.clear();
+    return ok;
+}
+
+bool TrainingDataWriter::open(const std::string& path, Compression compression) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+    compression_ = compression == ZLIB && ZLIB_AVAILABLE ? ZLIB : NONE;
+    records_ = 0;
+    failed_ = false;
+
+    FileHeader header = {};
+    std::memcpy(header.magic, TRAINING_MAGIC, 8);
+    failed_ = std::fwrite(&header, sizeof(header), 1, file_) != 1;
+    bytes_ = sizeof(header);
+    return !failed_;
+}
+
+bool TrainingDataWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        failed_ |= std::fclose(file_) != 0;
+        file_ = nullptr;
+    }
+    return !failed_;
+}
+
+bool TrainingDataWriter::writeChunk(const TrainingRecord* records, std::size_t count, std::vector<unsigned char>& scratch) {
+    TrainingChunkHeader header = {};
+    header.recordCount = static_cast<std::uint32_t>(count);
+    header.compression = compression_;
+    const std::size_t rawBytes = count * sizeof(TrainingRecord);
+
+    // Compression runs on the calling thread, outside the lock
+    scratch.resize(sizeof(header) + rawBytes);
+    std::size_t stored = rawBytes;
+#ifdef CHINESE_CHESS_ZLIB
+    if (compression_ == ZLIB) {
+        uLongf capacity = compressBound(static_cast<uLong>(rawBytes));
+        scratch.resize(sizeof(header) + capacity);
+        if (compress2(scratch.data() + sizeof(header), &capacity, reinterpret_cast<const Bytef*>(records),
+                      static_cast<uLong>(rawBytes), Z_BEST_SPEED) != Z_OK) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = true;
+            return false;
+        }
+        stored = capacity;
+    }
+#endif
+    if (header.compression == NONE) {
+        std::memcpy(scratch.data() + sizeof(header), records, rawBytes);
+    }
+    header.storedBytes = static_cast<std::uint32_t>(stored);
+    std::memcpy(scratch.data(), &header, sizeof(header));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_ || std::fwrite(scratch.data(), sizeof(header) + stored, 1, file_) != 1) {
+        failed_ = true;
+        return false;
+    }
+    records_ += count;
+    bytes_ += sizeof(header) + stored;
+    return true;
+}
+
+bool TrainingDataReader::open(const std::string& path) {
+    chunk_.clear();
+    next_ = 0;
+    corrupt_ = false;
+    if (!file_.open(path) || file_.size() < sizeof(FileHeader) ||
+        std::memcmp(file_.data(), TRAINING_MAGIC, 8) != 0) {
+        file_.close();
+        return false;
+    }
+    offset_ = sizeof(FileHeader);
+    return true;
+}
+
+bool TrainingDataReader::loadChunk() {
+    TrainingChunkHeader header;
+    if (offset_ + sizeof(header) > file_.size()) {
+        // Clean end, or a torn chunk header
+        corrupt_ = offset_ != file_.size();
+        return false;
+    }
+    std::memcpy(&header, file_.data() + offset_, sizeof(header));
+    const char* stored = file_.data() + offset_ + sizeof(header);
+    const std::size_t rawBytes = static_cast<std::size_t>(header.recordCount) * sizeof(TrainingRecord);
+    // The header is untrusted: check it before sizing anything from it
+    bool known = header.compression == TrainingDataWriter::NONE ? header.storedBytes == rawBytes
+                                                                : header.compression == TrainingDataWriter::ZLIB &&
+                                                                      TrainingDataWriter::ZLIB_AVAILABLE;
+    if (header.recordCount > TrainingDataWriter::CHUNK_RECORDS || !known ||
+        offset_ + sizeof(header) + header.storedBytes > file_.size()) {
+        corrupt_ = true;
+        return false;
+    }
+
+    chunk_.resize(header.recordCount);
+    next_ = 0;
+    if (header.compression == TrainingDataWriter::NONE) {
+        std::memcpy(chunk_.data(), stored, rawBytes);
+    }
+#ifdef CHINESE_CHESS_ZLIB
+    if (header.compression == TrainingDataWriter::ZLIB) {
+        uLongf length = static_cast<uLongf>(rawBytes);
+        if (uncompress(reinterpret_cast<Bytef*>(chunk_.data()), &length, reinterpret_cast<const Bytef*>(stored),
+                       header.storedBytes) != Z_OK || length != rawBytes) {
+            chunk_.clear();
+            corrupt_ = true;
+            return false;
+        }
+    }
+#endif
+    offset_ += sizeof(header) + header.storedBytes;
+    return true;
+}
+
+bool TrainingDataReader::next(TrainingRecord& record) {
+    while (next_ == chunk_.size()) {
+        if (corrupt_ || !file_.isOpen() || !loadChunk()) {
+            return false;
+        }
+    }
+    record = chunk_[next_++];
+    return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+#include "MappedFile.h"
+#include "game/PackedPosition.h"
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Training-data stream for evaluation tuning: one fixed-size record per
+// position, grouped into chunks that are optionally zlib-compressed.
+//   file:  header, then chunks until the end
+//   chunk: ChunkHeader, then recordCount records (storedBytes on disk)
+// Writers fill a Buffer per thread and hand over whole chunks, so the file
+// sees only large sequential appends and threads only meet on the append.
+// Integers are stored in host (little-endian) order.
+
+struct TrainingRecord {
+    PackedPosition position;
+    std::int16_t score;  // search score for the side to move
+    std::uint16_t move;  // best move found, Move::bits
+    std::int8_t result;  // game result for the side to move: 1 win, 0 draw, -1 loss
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(TrainingRecord) == 40, "TrainingRecord layout is part of the file format");
+
+struct TrainingChunkHeader {
+    std::uint32_t recordCount;
+    std::uint32_t storedBytes;
+    std::uint32_t compression; // TrainingDataWriter::Compression
+    std::uint32_t reserved;
+};
+static_assert(sizeof(TrainingChunkHeader) == 16, "TrainingChunkHeader layout is part of the file format");
+
+class TrainingDataWriter {
+public:
+    enum Compression : std::uint32_t { NONE = 0, ZLIB = 1 };
+    static constexpr std::size_t CHUNK_RECORDS = 8192;
+#ifdef CHINESE_CHESS_ZLIB
+    static constexpr bool ZLIB_AVAILABLE = true;
+#else
+    static constexpr bool ZLIB_AVAILABLE = false;
+#endif
+
+    // Per-thread staging area; flushes itself when full and when destroyed
+    class Buffer {
+    private:
+        TrainingDataWriter* writer_;
+        std::vector<TrainingRecord> records_;
+        std::vector<unsigned char> scratch_;
+
+    public:
+        explicit Buffer(TrainingDataWriter& writer);
+        ~Buffer() { flush(); }
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        void add(const TrainingRecord& record);
+        bool flush();
+    };
+
+private:
+    std::FILE* file_ = nullptr;
+    Compression compression_ = NONE;
+    std::mutex mutex_;
+    std::uint64_t records_ = 0;
+    std::uint64_t bytes_ = 0;
+    bool failed_ = false;
+
+    bool writeChunk(const TrainingRecord* records, std::size_t count, std::vector<unsigned char>& scratch);
+
+public:
+    TrainingDataWriter() = default;
+    ~TrainingDataWriter() { close(); }
+
+    TrainingDataWriter(const TrainingDataWriter&) = delete;
+    TrainingDataWriter& operator=(const TrainingDataWriter&) = delete;
+
+    // Truncates 'path'. ZLIB falls back to NONE when built without zlib.
+    bool open(const std::string& path, Compression compression);
+    // Buffers must be flushed or destroyed first; false if any write failed
+    bool close();
+
+    Compression compression() const { return compression_; }
+    std::uint64_t recordsWritten() const { return records_; }
+    std::uint64_t bytesWritten() const { return bytes_; }
+};
+
+// Reads a stream written by TrainingDataWriter, one chunk in memory at a time
+class TrainingDataReader {
+private:
+    MappedFile file_;
+    std::size_t offset_ = 0;
+    std::vector<TrainingRecord> chunk_;
+    std::size_t next_ = 0;
+    bool corrupt_ = false;
+
+    bool loadChunk();
+
+public:
+    bool open(const std::string& path);
+
+    // False at the end of the stream or at a corrupt chunk (see corrupt())
+    bool next(TrainingRecord& record);
+    bool corrupt() const { return corrupt_; }
+};
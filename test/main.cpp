@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 #include <iostream>
+#include "diagnostics/AllocTracker.h"
 
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     
+    // Hot-path allocations fail the current test instead of aborting the run
+    AllocTracker::setViolationHandler([](const char* scope, std::uint64_t allocations) {
+        ADD_FAILURE() << allocations << " heap allocation(s) inside NoAllocGuard \"" << scope << "\"";
+    });
+    
     std::cout << "Running Chinese Chess BDD Tests..." << std::endl;
     
     int result = RUN_ALL_TESTS();
@@ -0,0 +1,124 @@
+#include "engine/Analyzer.h"
+#include "game/Notation.h"
+#include "io/MappedFile.h"
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage: chinese_chess_analyze games|positions <input>... [options]\n"
+              << "  games              inputs are PGN-style game records\n"
+              << "  positions          inputs hold one FEN per line\n"
+              << "  --depth N          search depth (default 8)\n"
+              << "  --threads N        workers (default: all cores)\n"
+              << "  --hash MB          hash per worker (default 16)\n"
+              << "  --cache FILE       persistent analysis cache, created if missing\n"
+              << "  --output FILE      results file (default: stdout)\n";
+    return 2;
+}
+
+std::string moveText(Move move) {
+    if (move.isNull()) {
+        return "none";
+    }
+    char iccs[Notation::ICCS_LENGTH];
+    Notation::writeIccs(move.fromPosition(), move.toPosition(), iccs);
+    return std::string(iccs, Notation::ICCS_LENGTH);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return usage();
+    }
+    std::string mode = argv[1];
+    if (mode != "games" && mode != "positions") {
+        return usage();
+    }
+
+    AnalysisSettings settings;
+    settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string cachePath;
+    std::string outputPath;
+    std::vector<std::string> inputs;
+    for (int i = 2; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option.rfind("--", 0) != 0) {
+            inputs.push_back(option);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        const char* value = argv[++i];
+        if (option == "--depth") {
+            settings.depth = std::stoi(value);
+        } else if (option == "--threads") {
+            settings.threads = static_cast<unsigned>(std::stoul(value));
+        } else if (option == "--hash") {
+            settings.hashMegabytes = std::stoul(value);
+        } else if (option == "--cache") {
+            cachePath = value;
+        } else if (option == "--output") {
+            outputPath = value;
+        } else {
+            return usage();
+        }
+    }
+    if (inputs.empty()) {
+        return usage();
+    }
+
+    AnalysisCache cache;
+    if (!cachePath.empty() && !cache.open(cachePath)) {
+        std::cerr << "Cannot open cache " << cachePath << "\n";
+        return 1;
+    }
+    std::FILE* out = outputPath.empty() ? stdout : std::fopen(outputPath.c_str(), "w");
+    if (!out) {
+        std::cerr << "Cannot write " << outputPath << "\n";
+        return 1;
+    }
+
+    BatchAnalyzer analyzer(settings, cachePath.empty() ? nullptr : &cache);
+    AnalysisSummary total;
+    for (const std::string& input : inputs) {
+        MappedFile file(input);
+        if (!file.isOpen()) {
+            std::cerr << "Cannot read " << input << "\n";
+            return 1;
+        }
+        // One line per position: input item ply key played best score depth source
+        auto onItem = [&](const AnalyzedItem& item) {
+            if (!item.ok) {
+                std::fprintf(out, "%s %zu error\n", input.c_str(), item.index + 1);
+            }
+            for (const PositionAnalysis& position : item.positions) {
+                std::fprintf(out, "%s %zu %d %016llx %s %s %d %d %s\n", input.c_str(), item.index + 1, position.ply,
+                             static_cast<unsigned long long>(position.key), moveText(position.played).c_str(),
+                             moveText(position.best).c_str(), position.score, position.depth,
+                             position.cached ? "cache" : "search");
+            }
+            // Results land on disk as each game finishes, not at the end of the run
+            std::fflush(out);
+        };
+        AnalysisSummary summary = mode == "games" ? analyzer.analyzeGames(file.view(), onItem)
+                                                  : analyzer.analyzePositions(file.view(), onItem);
+        total.items += summary.items;
+        total.failed += summary.failed;
+        total.positions += summary.positions;
+        total.cacheHits += summary.cacheHits;
+        cache.flush();
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    std::cerr << total.items << " " << mode << ", " << total.failed << " failed, " << total.positions << " positions, "
+              << total.cacheHits << " from cache\n";
+    return 0;
+}
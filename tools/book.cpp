@@ -0,0 +1,90 @@
+#include "game/Fen.h"
+#include "game/Notation.h"
+#include "io/GameRecordReader.h"
+#include "io/OpeningBook.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage:\n"
+              << "  chinese_chess_book build <book> <max-ply> <min-games> <games.pgn>...\n"
+              << "  chinese_chess_book probe <book> <fen>\n";
+    return 2;
+}
+
+int build(const std::string& bookPath, int maxPly, int minGames, int fileCount, char** files) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    OpeningBookBuilder merged(maxPly);
+    long rejected = 0;
+
+    for (int i = 0; i < fileCount; ++i) {
+        MappedFile file(files[i]);
+        if (!file.isOpen()) {
+            std::cerr << "Cannot read " << files[i] << "\n";
+            return 1;
+        }
+
+        // One builder per worker, merged afterwards, so workers never share state
+        std::vector<OpeningBookBuilder> builders(threads, OpeningBookBuilder(maxPly));
+        std::vector<long> failures(threads, 0);
+        GameRecordReader::forEachGameParallel(file.view(), threads, [&](const GameRecord& record, Game& game, unsigned worker) {
+            if (!builders[worker].addGame(record, game)) {
+                ++failures[worker];
+            }
+        });
+        for (unsigned worker = 0; worker < threads; ++worker) {
+            merged.merge(builders[worker]);
+            rejected += failures[worker];
+        }
+    }
+
+    if (!merged.write(bookPath, static_cast<std::uint32_t>(minGames))) {
+        std::cerr << "Cannot write " << bookPath << "\n";
+        return 1;
+    }
+    std::cout << merged.size() << " position/move pairs, " << rejected << " games rejected\n";
+    return 0;
+}
+
+int probe(const std::string& bookPath, const std::string& fen) {
+    OpeningBook book;
+    Game game;
+    if (!book.open(bookPath)) {
+        std::cerr << "Cannot open book " << bookPath << "\n";
+        return 1;
+    }
+    if (!Fen::parse(fen, game)) {
+        std::cerr << "Bad FEN\n";
+        return 1;
+    }
+
+    for (const BookEntry& entry : book.probe(game)) {
+        Move move(entry.move);
+        char iccs[Notation::ICCS_LENGTH + 1] = {};
+        Notation::writeIccs(move.fromPosition(), move.toPosition(), iccs);
+        std::cout << iccs << " weight " << entry.weight << " games " << entry.games
+                  << " wins " << entry.wins << " draws " << entry.draws << "\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "build" && argc >= 6) {
+        return build(argv[2], std::stoi(argv[3]), std::stoi(argv[4]), argc - 5, argv + 5);
+    }
+    if (command == "probe") {
+        return probe(argv[2], argv[3]);
+    }
+    return usage();
+}
@@ -0,0 +1,90 @@
+#include "game/Fen.h"
+#include "game/Zobrist.h"
+#include "io/GameDatabase.h"
+#include "io/GameRecordReader.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage:\n"
+              << "  chinese_chess_gamedb import <db> <games.pgn>...   append games and rebuild the index\n"
+              << "  chinese_chess_gamedb index <db>                   rebuild the position index\n"
+              << "  chinese_chess_gamedb query <db> <fen>             list games that reached a position\n";
+    return 2;
+}
+
+int importGames(const std::string& base, int argc, char** argv) {
+    GameDatabaseWriter writer;
+    if (!writer.open(base)) {
+        std::cerr << "Cannot open " << GameDatabase::gamesPath(base) << "\n";
+        return 1;
+    }
+
+    Game scratch;
+    long imported = 0, rejected = 0;
+    for (int i = 0; i < argc; ++i) {
+        MappedFile file(argv[i]);
+        if (!file.isOpen()) {
+            std::cerr << "Cannot read " << argv[i] << "\n";
+            return 1;
+        }
+        GameRecordReader reader(file.view());
+        GameRecord record;
+        while (reader.next(record)) {
+            if (writer.appendRecord(record, scratch)) {
+                ++imported;
+            } else {
+                ++rejected;
+            }
+        }
+    }
+    writer.close();
+
+    std::cout << "imported " << imported << " games, rejected " << rejected << "\n";
+    return GameDatabase::buildIndex(base) ? 0 : 1;
+}
+
+int query(const std::string& base, const std::string& fen) {
+    GameDatabase database;
+    Game game;
+    if (!database.open(base)) {
+        std::cerr << "Cannot open database " << base << "\n";
+        return 1;
+    }
+    if (!Fen::parse(fen, game)) {
+        std::cerr << "Bad FEN\n";
+        return 1;
+    }
+
+    std::uint64_t key = Zobrist::hash(game.getBoard(), game.getCurrentPlayer());
+    for (const PositionIndexEntry& entry : database.find(key)) {
+        std::cout << "game " << entry.game << " ply " << entry.ply << " result " << int(entry.result) << "\n";
+    }
+    PositionStats stats = database.stats(key);
+    std::cout << stats.games << " games: " << stats.redWins << " red wins, " << stats.blackWins
+              << " black wins, " << stats.draws << " draws\n";
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        return usage();
+    }
+    std::string command = argv[1];
+    std::string base = argv[2];
+
+    if (command == "import" && argc >= 4) {
+        return importGames(base, argc - 3, argv + 3);
+    }
+    if (command == "index") {
+        return GameDatabase::buildIndex(base) ? 0 : 1;
+    }
+    if (command == "query" && argc >= 4) {
+        return query(base, argv[3]);
+    }
+    return usage();
+}
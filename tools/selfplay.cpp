@@ -0,0 +1,210 @@
+#include "diagnostics/Trace.h"
+#include "engine/SelfPlay.h"
+#include "engine/TrainingGenerator.h"
+#include "io/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage: chinese_chess_selfplay [options]\n"
+              << "  --games N          games to play (default 1000)\n"
+              << "  --threads N        concurrent games (default: all cores)\n"
+              << "  --openings FILE    one FEN per line (default: start position)\n"
+              << "  --depth N | --nodes N | --movetime MS | --tc SECONDS+INC   limits for both players\n"
+              << "  --base-depth N | --base-nodes N | --base-movetime MS | --base-tc S+I   override for the base player\n"
+              << "  --hash MB          hash per player per worker (default 8)\n"
+              << "  --max-plies N      draw adjudication (default 300)\n"
+              << "  --elo0 E --elo1 E --alpha A --beta B   SPRT bounds (default 0 5 0.05 0.05)\n"
+              << "  --no-sprt          play all games\n"
+              << "  --trace FILE       write Chrome trace JSON (needs -DCHINESE_CHESS_TRACE=ON)\n"
+              << "  --training FILE    instead of a match, write training records from fixed-node self-play\n"
+              << "                     (uses --games, --threads, --openings, --nodes, --hash, --max-plies)\n"
+              << "  --random-plies N   unrecorded random moves after each opening (default 8)\n"
+              << "  --no-compress      store training chunks uncompressed\n";
+    return 2;
+}
+
+const char* resultText(GameResult result) {
+    switch (result) {
+        case GameResult::RED_WIN: return "1-0";
+        case GameResult::BLACK_WIN: return "0-1";
+        case GameResult::DRAW: return "1/2-1/2";
+        default: return "*";
+    }
+}
+
+bool applyLimit(const std::string& name, const char* value, SearchLimits& limits) {
+    if (name == "depth") {
+        limits.depth = std::stoi(value);
+    } else if (name == "nodes") {
+        limits.nodes = std::stoull(value);
+    } else if (name == "movetime") {
+        limits.moveTimeMs = std::stoi(value);
+    } else if (name == "tc") {
+        // Sudden death with optional increment, e.g. "10+0.1"
+        std::string text = value;
+        std::size_t plus = text.find('+');
+        limits.clock.remainingMs = static_cast<std::int64_t>(std::stod(text.substr(0, plus)) * 1000);
+        limits.clock.incrementMs = plus == std::string::npos ? 0 : static_cast<std::int64_t>(std::stod(text.substr(plus + 1)) * 1000);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Writes the trace (if any) on the way out, like the match mode
+int generateTraining(const std::string& path, const SelfPlaySettings& match, const SelfPlayPlayer& player, int randomPlies,
+                     bool compress, const std::vector<std::string>& openings, const std::string& tracePath) {
+    TrainingSettings settings;
+    settings.games = match.games;
+    settings.threads = match.threads;
+    settings.maxPlies = match.maxPlies;
+    settings.randomPlies = randomPlies;
+    settings.hashMegabytes = player.hashMegabytes;
+    if (player.limits.nodes > 0) {
+        settings.nodes = player.limits.nodes;
+    }
+
+    TrainingDataWriter writer;
+    if (!writer.open(path, compress ? TrainingDataWriter::ZLIB : TrainingDataWriter::NONE)) {
+        std::cerr << "Cannot write " << path << "\n";
+        return 1;
+    }
+    if (compress && writer.compression() == TrainingDataWriter::NONE) {
+        std::cerr << "Built without zlib: writing uncompressed chunks\n";
+    }
+    TrainingGenerator generator(settings, openings);
+    std::uint64_t positions = generator.run(writer, [](const TrainingGame& game) {
+        if (game.index % 100 == 99) {
+            std::printf("game %d %s (%d plies, %d positions)\n", game.index + 1, resultText(game.result), game.plies,
+                        game.positions);
+            std::fflush(stdout);
+        }
+    });
+    bool ok = writer.close();
+
+    if (!tracePath.empty()) {
+        Trace::stop();
+        Trace::writeFile(tracePath);
+    }
+    if (!ok) {
+        std::cerr << "Write error on " << path << "\n";
+        return 1;
+    }
+    std::printf("%d games, %llu positions, %llu bytes\n", settings.games, static_cast<unsigned long long>(positions),
+                static_cast<unsigned long long>(writer.bytesWritten()));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SelfPlayPlayer test{"test", SearchLimits(), 8};
+    SelfPlayPlayer base{"base", SearchLimits(), 8};
+    SearchLimits baseOverride;
+    bool hasBaseOverride = false;
+    SelfPlaySettings settings;
+    settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string openingsPath;
+    std::string tracePath;
+    std::string trainingPath;
+    int randomPlies = TrainingSettings().randomPlies;
+    bool compress = true;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--no-sprt") {
+            settings.stopOnSprt = false;
+            continue;
+        }
+        if (option == "--no-compress") {
+            compress = false;
+            continue;
+        }
+        if (option.rfind("--", 0) != 0 || i + 1 >= argc) {
+            return usage();
+        }
+        std::string name = option.substr(2);
+        const char* value = argv[++i];
+        if (applyLimit(name, value, test.limits)) {
+            continue;
+        }
+        if (name.rfind("base-", 0) == 0 && applyLimit(name.substr(5), value, baseOverride)) {
+            hasBaseOverride = true;
+        } else if (name == "games") {
+            settings.games = std::stoi(value);
+        } else if (name == "threads") {
+            settings.threads = static_cast<unsigned>(std::stoul(value));
+        } else if (name == "trace") {
+            tracePath = value;
+        } else if (name == "training") {
+            trainingPath = value;
+        } else if (name == "random-plies") {
+            randomPlies = std::stoi(value);
+        } else if (name == "openings") {
+            openingsPath = value;
+        } else if (name == "hash") {
+            test.hashMegabytes = base.hashMegabytes = std::stoul(value);
+        } else if (name == "max-plies") {
+            settings.maxPlies = std::stoi(value);
+        } else if (name == "elo0") {
+            settings.elo0 = std::stod(value);
+        } else if (name == "elo1") {
+            settings.elo1 = std::stod(value);
+        } else if (name == "alpha") {
+            settings.alpha = std::stod(value);
+        } else if (name == "beta") {
+            settings.beta = std::stod(value);
+        } else {
+            return usage();
+        }
+    }
+    if (test.limits.depth == 0 && test.limits.nodes == 0 && test.limits.moveTimeMs == 0 && !test.limits.clock.isSet()) {
+        test.limits.moveTimeMs = 100;
+    }
+    base.limits = hasBaseOverride ? baseOverride : test.limits;
+
+    std::vector<std::string> openings;
+    if (!openingsPath.empty()) {
+        MappedFile file(openingsPath);
+        if (!file.isOpen()) {
+            std::cerr << "Cannot read " << openingsPath << "\n";
+            return 1;
+        }
+        openings = SelfPlayRunner::loadOpenings(file.view());
+    }
+
+    if (!tracePath.empty()) {
+        Trace::start();
+    }
+    if (!trainingPath.empty()) {
+        return generateTraining(trainingPath, settings, test, randomPlies, compress, openings, tracePath);
+    }
+    SelfPlayRunner runner(test, base, settings, openings);
+    Sprt sprt = runner.run([](const SelfPlayGame& game, const Sprt& stats) {
+        std::printf("game %d opening %d %s %s (%s, %d plies)  W %d D %d L %d  elo %+.1f  LLR %.2f [%.2f, %.2f]\n",
+                    game.index + 1, game.opening + 1, game.testIsRed ? "test-base" : "base-test",
+                    resultText(game.result), game.reason, game.plies, stats.wins(), stats.draws(), stats.losses(),
+                    stats.eloEstimate(), stats.llr(), stats.lowerBound(), stats.upperBound());
+        std::fflush(stdout);
+    });
+
+    if (!tracePath.empty()) {
+        Trace::stop();
+        if (!Trace::writeFile(tracePath)) {
+            std::cerr << "Cannot write " << tracePath << "\n";
+        }
+    }
+
+    switch (sprt.decision()) {
+        case Sprt::Decision::ACCEPT_H1: std::printf("H1 accepted: test is stronger\n"); break;
+        case Sprt::Decision::ACCEPT_H0: std::printf("H0 accepted: no improvement\n"); break;
+        default: std::printf("SPRT inconclusive after %d games\n", sprt.games()); break;
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "engine/Tablebase.h"
+#include "game/Fen.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage:\n"
+              << "  chinese_chess_tablebase generate <dir> <material>...\n"
+              << "  chinese_chess_tablebase probe <dir> <fen>\n";
+    return 2;
+}
+
+int generate(const std::string& directory, int materialCount, char** materials) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    Tablebase tablebase;
+    for (int i = 0; i < materialCount; ++i) {
+        TablebaseMaterial material;
+        if (!TablebaseMaterial::parse(materials[i], material)) {
+            std::cerr << "Bad material " << materials[i] << "\n";
+            return 1;
+        }
+        if (!tablebase.generate(material, threads)) {
+            std::cerr << "Cannot generate " << materials[i] << "\n";
+            return 1;
+        }
+    }
+    if (!tablebase.write(directory)) {
+        std::cerr << "Cannot write to " << directory << "\n";
+        return 1;
+    }
+    std::cout << tablebase.tableCount() << " tables written\n";
+    return 0;
+}
+
+int probe(const std::string& directory, const std::string& fen) {
+    Tablebase tablebase;
+    if (tablebase.loadDirectory(directory) == 0) {
+        std::cerr << "No tables in " << directory << "\n";
+        return 1;
+    }
+    Game game;
+    if (!Fen::parse(fen, game)) {
+        std::cerr << "Bad FEN\n";
+        return 1;
+    }
+
+    TablebaseResult result = tablebase.probe(BoardState::fromGame(game));
+    if (!result.found) {
+        std::cout << "not found\n";
+    } else if (result.wdl == Wdl::DRAW) {
+        std::cout << "draw\n";
+    } else {
+        std::cout << (result.wdl == Wdl::WIN ? "win" : "loss") << " in " << result.pliesToMate << " plies\n";
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        return usage();
+    }
+    std::string command = argv[1];
+    if (command == "generate") {
+        return generate(argv[2], argc - 3, argv + 3);
+    }
+    if (command == "probe") {
+        return probe(argv[2], argv[3]);
+    }
+    return usage();
+}
@@ -0,0 +1,102 @@
+#include "engine/Tuner.h"
+#include "io/MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage: chinese_chess_tune <training file>... [options]\n"
+              << "  --iterations N     gradient steps (default 500)\n"
+              << "  --threads N        workers (default: all cores)\n"
+              << "  --rate R           step size in centipawns (default 1)\n"
+              << "  --scale K          sigmoid scale (default: fitted to the starting weights)\n"
+              << "  --start FILE       starting weights (default: the built-in ones)\n"
+              << "  --output FILE      tuned weights (default: stdout)\n";
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    TunerSettings settings;
+    settings.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string startPath;
+    std::string outputPath;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option.rfind("--", 0) != 0) {
+            inputs.push_back(option);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return usage();
+        }
+        const char* value = argv[++i];
+        if (option == "--iterations") {
+            settings.iterations = std::stoi(value);
+        } else if (option == "--threads") {
+            settings.threads = static_cast<unsigned>(std::stoul(value));
+        } else if (option == "--rate") {
+            settings.learningRate = std::stod(value);
+        } else if (option == "--scale") {
+            settings.scale = std::stod(value);
+        } else if (option == "--start") {
+            startPath = value;
+        } else if (option == "--output") {
+            outputPath = value;
+        } else {
+            return usage();
+        }
+    }
+    if (inputs.empty()) {
+        return usage();
+    }
+
+    EvalWeights start = EvalWeights::defaults();
+    if (!startPath.empty()) {
+        MappedFile file(startPath);
+        if (!file.isOpen() || !EvalWeights::parse(file.view(), start)) {
+            std::cerr << "Cannot read weights from " << startPath << "\n";
+            return 1;
+        }
+    }
+
+    TuningSet set;
+    for (const std::string& input : inputs) {
+        if (!set.addFile(input)) {
+            std::cerr << "Cannot read " << input << " (or it is damaged; kept the records before it)\n";
+        }
+    }
+    if (set.size() == 0) {
+        std::cerr << "No positions to tune on\n";
+        return 1;
+    }
+    std::fprintf(stderr, "%zu positions, %zu features\n", set.size(), set.featureCount());
+
+    Tuner tuner(settings, set);
+    TunerResult result = tuner.run(start, [](const TunerProgress& progress) {
+        if (progress.iteration % 50 == 0) {
+            std::fprintf(stderr, "iteration %d loss %.6f\n", progress.iteration, progress.loss);
+        }
+    });
+    std::fprintf(stderr, "scale %.4f, loss %.6f -> %.6f after %d iterations\n", result.scale, result.initialLoss,
+                 result.finalLoss, result.iterations);
+
+    if (outputPath.empty()) {
+        result.weights.write(std::cout);
+        return 0;
+    }
+    std::ofstream out(outputPath);
+    result.weights.write(out);
+    if (!out) {
+        std::cerr << "Cannot write " << outputPath << "\n";
+        return 1;
+    }
+    return 0;
+}
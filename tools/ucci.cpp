@@ -0,0 +1,37 @@
+#include "diagnostics/Trace.h"
+#include "engine/UcciEngine.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    // --trace FILE records spans for the whole session (needs -DCHINESE_CHESS_TRACE=ON)
+    std::string tracePath;
+    if (argc == 3 && std::strcmp(argv[1], "--trace") == 0) {
+        tracePath = argv[2];
+    } else if (argc != 1) {
+        std::cerr << "Usage: chinese_chess_ucci [--trace FILE]\n";
+        return 2;
+    }
+    if (!tracePath.empty()) {
+        if (!Trace::ENABLED) {
+            std::cerr << "Tracing is not compiled in; rebuild with -DCHINESE_CHESS_TRACE=ON\n";
+        }
+        Trace::start();
+    }
+
+    std::ios::sync_with_stdio(false);
+    UcciEngine engine([](std::string_view line) {
+        std::cout << line << std::endl;
+    });
+    engine.run(std::cin);
+
+    if (!tracePath.empty()) {
+        Trace::stop();
+        if (!Trace::writeFile(tracePath)) {
+            std::cerr << "Cannot write " << tracePath << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}